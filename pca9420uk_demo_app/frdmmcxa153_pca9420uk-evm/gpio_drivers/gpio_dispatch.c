@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file gpio_dispatch.c
+ * @brief The gpio_dispatch.c file implements the bitmask driven GPIO interrupt dispatch core.
+ */
+
+#include <stddef.h>
+#include "gpio_dispatch.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+    defined(__ARM_ARCH_8_1M_MAIN__)
+#include "cmsis_compiler.h"
+/* RBIT + CLZ, two single cycle instructions. */
+#define GPIO_DISPATCH_CTZ(x) __CLZ(__RBIT(x))
+#else
+/* Host builds and cores without CLZ. */
+#define GPIO_DISPATCH_CTZ(x) ((uint32_t)__builtin_ctz(x))
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static inline void GPIO_DispatchCall(gpio_dispatch_t *pDispatch, gpio_dispatch_entry_t *pEntry, uint32_t entryStamp)
+{
+    uint32_t latency;
+
+    if (pDispatch->getCycles != NULL)
+    {
+        latency = pDispatch->getCycles() - entryStamp;
+        pEntry->lastLatency = latency;
+        if (latency > pEntry->maxLatency)
+        {
+            pEntry->maxLatency = latency;
+        }
+    }
+    pEntry->calls++;
+    pEntry->handler(pEntry->pUserData);
+}
+
+void GPIO_DispatchInit(gpio_dispatch_t *pDispatch, gpio_dispatch_cycles_t getCycles)
+{
+    uint32_t i;
+
+    for (i = 0U; i < GPIO_DISPATCH_MAX_PORTS; i++)
+    {
+        pDispatch->ports[i].handledMask = 0U;
+    }
+    pDispatch->entryCount = 0U;
+    pDispatch->unhandled = 0U;
+    pDispatch->getCycles = getCycles;
+}
+
+bool GPIO_DispatchRegister(
+    gpio_dispatch_t *pDispatch, uint32_t port, uint32_t pin, gpio_dispatch_handler_t handler, void *pUserData)
+{
+    gpio_dispatch_port_t *pPort;
+    gpio_dispatch_entry_t *pEntry;
+
+    if ((port >= GPIO_DISPATCH_MAX_PORTS) || (pin >= GPIO_DISPATCH_PINS_PER_PORT) || (handler == NULL))
+    {
+        return false;
+    }
+
+    pPort = &pDispatch->ports[port];
+    if ((pPort->handledMask & (1UL << pin)) == 0U)
+    {
+        if (pDispatch->entryCount >= GPIO_DISPATCH_MAX_HANDLERS)
+        {
+            return false;
+        }
+        pPort->slot[pin] = pDispatch->entryCount++;
+    }
+
+    pEntry = &pDispatch->entries[pPort->slot[pin]];
+    pEntry->handler = handler;
+    pEntry->pUserData = pUserData;
+    pEntry->calls = 0U;
+    pEntry->lastLatency = 0U;
+    pEntry->maxLatency = 0U;
+    pPort->handledMask |= (1UL << pin);
+
+    return true;
+}
+
+uint32_t GPIO_DispatchFlags(gpio_dispatch_t *pDispatch, uint32_t port, uint32_t flags, uint32_t entryStamp)
+{
+    const gpio_dispatch_port_t *pPort = &pDispatch->ports[port];
+    uint32_t pending = flags & pPort->handledMask;
+    uint32_t calls = 0U;
+
+    if (pending != flags)
+    {
+        pDispatch->unhandled++;
+    }
+
+    while (pending != 0U)
+    {
+        uint32_t pin = GPIO_DISPATCH_CTZ(pending);
+
+        /* Drop the lowest set bit. */
+        pending &= pending - 1U;
+        GPIO_DispatchCall(pDispatch, &pDispatch->entries[pPort->slot[pin]], entryStamp);
+        calls++;
+    }
+
+    return calls;
+}
+
+uint32_t GPIO_DispatchFlagsLinear(gpio_dispatch_t *pDispatch, uint32_t port, uint32_t flags, uint32_t entryStamp)
+{
+    const gpio_dispatch_port_t *pPort = &pDispatch->ports[port];
+    uint32_t calls = 0U;
+    uint32_t pin;
+
+    if ((flags & ~pPort->handledMask) != 0U)
+    {
+        pDispatch->unhandled++;
+    }
+
+    for (pin = 0U; pin < GPIO_DISPATCH_PINS_PER_PORT; pin++)
+    {
+        if ((flags & pPort->handledMask & (1UL << pin)) != 0U)
+        {
+            GPIO_DispatchCall(pDispatch, &pDispatch->entries[pPort->slot[pin]], entryStamp);
+            calls++;
+        }
+    }
+
+    return calls;
+}
+
+const gpio_dispatch_entry_t *GPIO_DispatchGetEntry(const gpio_dispatch_t *pDispatch, uint32_t port, uint32_t pin)
+{
+    if ((port >= GPIO_DISPATCH_MAX_PORTS) || (pin >= GPIO_DISPATCH_PINS_PER_PORT) ||
+        ((pDispatch->ports[port].handledMask & (1UL << pin)) == 0U))
+    {
+        return NULL;
+    }
+
+    return &pDispatch->entries[pDispatch->ports[port].slot[pin]];
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file gpio_dispatch.h
+ * @brief The gpio_dispatch.h file describes the bitmask driven GPIO interrupt dispatch core.
+
+    The core maps the pending flag word of a port to the registered pin handlers. It only
+    visits set bits, finding each one with a count-trailing-zeros, and looks the handler up
+    through a per-port byte index into a small shared handler pool. It does not touch any
+    GPIO register, so it builds unchanged on a host with synthetic flag words.
+*/
+
+#ifndef __GPIO_DISPATCH_H__
+#define __GPIO_DISPATCH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Pins per port, one per bit of the flag word. */
+#define GPIO_DISPATCH_PINS_PER_PORT (32U)
+
+/*! @brief Number of ports the dispatcher serves. */
+#ifndef GPIO_DISPATCH_MAX_PORTS
+#define GPIO_DISPATCH_MAX_PORTS (5U)
+#endif
+
+/*! @brief Number of pin handlers that can be registered across all ports. */
+#ifndef GPIO_DISPATCH_MAX_HANDLERS
+#define GPIO_DISPATCH_MAX_HANDLERS (8U)
+#endif
+
+/*! @brief Pin handler, same signature as gpio_isr_handler_t. */
+typedef void (*gpio_dispatch_handler_t)(void *pUserData);
+
+/*! @brief Free running cycle counter used for the latency statistics. */
+typedef uint32_t (*gpio_dispatch_cycles_t)(void);
+
+/*!
+ * @brief Registered pin handler and its latency statistics, in counter cycles.
+ */
+typedef struct
+{
+    gpio_dispatch_handler_t handler; /*!< Pin handler. */
+    void *pUserData;                 /*!< Argument of the handler. */
+    uint32_t calls;                  /*!< Number of dispatches. */
+    uint32_t lastLatency;            /*!< ISR entry to handler call of the last dispatch. */
+    uint32_t maxLatency;             /*!< Worst ISR entry to handler call seen. */
+} gpio_dispatch_entry_t;
+
+/*!
+ * @brief Per port lookup, a byte index into the handler pool for every pin.
+ */
+typedef struct
+{
+    uint32_t handledMask;                     /*!< Pins with a registered handler. */
+    uint8_t slot[GPIO_DISPATCH_PINS_PER_PORT]; /*!< Pool index, valid where handledMask is set. */
+} gpio_dispatch_port_t;
+
+/*!
+ * @brief Dispatcher context.
+ */
+typedef struct
+{
+    gpio_dispatch_port_t ports[GPIO_DISPATCH_MAX_PORTS];          /*!< Per port lookup. */
+    gpio_dispatch_entry_t entries[GPIO_DISPATCH_MAX_HANDLERS];    /*!< Handler pool. */
+    uint8_t entryCount;                                           /*!< Used pool entries. */
+    uint32_t unhandled;                                           /*!< Flags seen without a handler. */
+    gpio_dispatch_cycles_t getCycles;                             /*!< Cycle counter, NULL to skip statistics. */
+} gpio_dispatch_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to empty a dispatcher.
+ *  @param[out]  pDispatch Dispatcher context.
+ *  @param[in]   getCycles Cycle counter for the latency statistics, may be NULL.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+void GPIO_DispatchInit(gpio_dispatch_t *pDispatch, gpio_dispatch_cycles_t getCycles);
+
+/*! @brief       Function to attach a handler to a pin.
+ *  @details     A pin that already has a handler keeps its pool entry, the handler is replaced.
+ *  @param[in]   pDispatch Dispatcher context.
+ *  @param[in]   port      Port number.
+ *  @param[in]   pin       Pin number, 0 to 31.
+ *  @param[in]   handler   Pin handler.
+ *  @param[in]   pUserData Argument of the handler.
+ *  @return      bool false when the port or pin is out of range or the pool is full.
+ *  @constraints Do not call while the port interrupt is enabled.
+ *  @reeentrant  No
+ */
+bool GPIO_DispatchRegister(
+    gpio_dispatch_t *pDispatch, uint32_t port, uint32_t pin, gpio_dispatch_handler_t handler, void *pUserData);
+
+/*! @brief       Function to run the handlers of all set flags.
+ *  @details     This function visits the set bits of flags from bit 0 upwards in one iteration per set bit.
+ *  @param[in]   pDispatch  Dispatcher context.
+ *  @param[in]   port       Port number the flags belong to.
+ *  @param[in]   flags      Pending interrupt flags, already cleared in hardware.
+ *  @param[in]   entryStamp Cycle counter value taken at ISR entry.
+ *  @return      uint32_t Number of handlers called.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+uint32_t GPIO_DispatchFlags(gpio_dispatch_t *pDispatch, uint32_t port, uint32_t flags, uint32_t entryStamp);
+
+/*! @brief       Function to run the handlers of all set flags by scanning all 32 pins.
+ *  @details     Reference implementation with the behavior of the former driver loop, kept for
+ *               comparing the dispatch latency.
+ *  @param[in]   pDispatch  Dispatcher context.
+ *  @param[in]   port       Port number the flags belong to.
+ *  @param[in]   flags      Pending interrupt flags, already cleared in hardware.
+ *  @param[in]   entryStamp Cycle counter value taken at ISR entry.
+ *  @return      uint32_t Number of handlers called.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+uint32_t GPIO_DispatchFlagsLinear(gpio_dispatch_t *pDispatch, uint32_t port, uint32_t flags, uint32_t entryStamp);
+
+/*! @brief       Function to look up the handler entry of a pin.
+ *  @param[in]   pDispatch Dispatcher context.
+ *  @param[in]   port      Port number.
+ *  @param[in]   pin       Pin number.
+ *  @return      const gpio_dispatch_entry_t* The entry, NULL when the pin has no handler.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+const gpio_dispatch_entry_t *GPIO_DispatchGetEntry(const gpio_dispatch_t *pDispatch, uint32_t port, uint32_t pin);
+
+#endif // __GPIO_DISPATCH_H__
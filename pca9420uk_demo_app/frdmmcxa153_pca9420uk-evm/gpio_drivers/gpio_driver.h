@@ -17,6 +17,7 @@
 #include "fsl_common.h"
 #include "fsl_gpio.h"
 #include "fsl_port.h"
+#include "gpio_dispatch.h"
 
 /**
 \brief GPIO PORT NAMES.
@@ -79,4 +80,10 @@ typedef struct gpioIsrObj
 #define GPIO_PIN_ID(PortName, PinNumber) &(PortName##PinNumber)
 extern GENERIC_DRIVER_GPIO Driver_GPIO_KSDK;
 
+/*! @brief Dispatches the pending pin interrupts of a port, called from the port IRQ handlers. */
+void ksdk_gpio_handle_interrupt(GPIO_Type *apBase, port_number_t aPortNumber);
+
+/*! @brief Returns the dispatch count and ISR entry to handler latency of a pin, NULL without a handler. */
+const gpio_dispatch_entry_t *ksdk_gpio_get_dispatch_stats(pinID_t aPinId);
+
 #endif // __DRIVER_GPIO_H__
@@ -13,12 +13,29 @@
 #include "fsl_gpio.h"
 #include "gpio_driver.h"
 
-extern void ksdk_gpio_handle_interrupt(GPIO_Type *base, port_number_t portNumber);
-
 /*******************************************************************************
  * Functions - GPIOIRQ implementation
  ******************************************************************/
-void PORT0_IRQHandler(void)
+void GPIO0_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO0, PORTA_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO1_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO1, PORTB_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO2_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO2, PORTC_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO3_IRQHandler(void)
 {
-    ksdk_gpio_handle_interrupt(GPIO0, 0);
+    ksdk_gpio_handle_interrupt(GPIO3, PORTD_NUM);
+    SDK_ISR_EXIT_BARRIER;
 }
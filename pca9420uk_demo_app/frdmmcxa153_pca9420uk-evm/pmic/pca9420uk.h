@@ -143,6 +143,14 @@ enum
 #define PCA9420_TOP_CNTL3_ON_GLT_LONG_SHIFT  (0X00)
 #define PCA9420_TOP_CNTL3_ON_GLT_LONG_MASK   (0X03)
 
+//Reset monitor, latched causes of the last PMIC reset, write 1 to clear
+#define PCA9420_RESET_MONITOR_POR_MASK        (0x01) /* VIN or VBAT power-on reset. */
+#define PCA9420_RESET_MONITOR_VSYS_UVLO_MASK  (0x02) /* VSYS fell below the UVLO threshold. */
+#define PCA9420_RESET_MONITOR_THM_STDN_MASK   (0x04) /* Die temperature reached THM_STDN. */
+#define PCA9420_RESET_MONITOR_WD_TIMER_MASK   (0x08) /* Watchdog timer expired. */
+#define PCA9420_RESET_MONITOR_ON_LONG_MASK    (0x10) /* ON pin held for the long glitch time. */
+#define PCA9420_RESET_MONITOR_ALL_MASK        (0x1F)
+
 //Charging status
 #define PCA9420_IN_PWR_STATUS_SHIFT       (0X06)
 #define PCA9420_IN_PWR_STATUS_MASK        (0xC0)
@@ -150,7 +158,7 @@ enum
 #define PCA9420_BAT_DETAIL_STATUS_MASK    (0X70)
 #define PCA9420_BAT_CHG_STATUS_SHIFT      (0X00)
 #define PCA9420_BAT_CHG_STATUS_MASK       (0X07)
-#define PCA9420_TEMP_STATUS_SHIFT         (0X03)
+#define PCA9420_TEMP_STATUS_SHIFT         (0X04)
 #define PCA9420_TEMP_STATUS_MASK          (0X70)
 #define PCA9420_SFTY_TIMER_SHIFT          (0x00)
 #define PCA9420_SFTY_TIMER_MASK           (0x03)
@@ -285,7 +293,7 @@ enum
 #define PCA9420_T_TOPOFF_TIMER_MASK 	   (0X03)
 #define PCA9420_T_TOPOFF_TIMER_SHIFT       (0X00)
 
-#define PCA9420_NTC_BETA_MASK  		   (0XE0)
+#define PCA9420_NTC_BETA_MASK  		   (0X70)
 #define PCA9420_NTC_BETA_SHIFT 		   (0X04)
 
 #define PCA9420_THM_REG_MASK  		   (0X07)
@@ -1044,6 +1052,37 @@ enum _pca9420_thrml_reg_thshld
 	kPCA9420_THM_REG_115 = 0x07,
 };
 
+/*! @brief PCA9420 Battery Temperature Status definition. */
+enum _pca9420_ts_status
+{
+	kPCA9420_TsNominal = 0x00,
+	kPCA9420_TsCold = 0x01,
+	kPCA9420_TsCool = 0x02,
+	kPCA9420_TsWarm = 0x03,
+	kPCA9420_TsHot = 0x04,
+};
+
+/*! @brief PCA9420 Battery Charger Status definition. */
+enum _pca9420_chg_phase
+{
+	kPCA9420_ChgIdle = 0x00,
+	kPCA9420_ChgDeadBattery = 0x01,
+	kPCA9420_ChgLowBattery = 0x02,
+	kPCA9420_ChgFastCc = 0x03,
+	kPCA9420_ChgFastCv = 0x04,
+	kPCA9420_ChgTopOff = 0x05,
+	kPCA9420_ChgDone = 0x06,
+};
+
+/*! @brief PCA9420 Safety Timer Status definition. */
+enum _pca9420_safety_status
+{
+	kPCA9420_SafetyOk = 0x00,
+	kPCA9420_SafetyPreQualExpired = 0x01,
+	kPCA9420_SafetyFastExpired = 0x02,
+	kPCA9420_SafetyShortFailed = 0x03,
+};
+
 enum _pca9420_vol_reg_source
 {
 	kPCA9420_SW1 = 0x01,
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_charger.c
+ * @brief The pca9420uk_charger.c file implements the PCA9420UK charger configuration API.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include "fsl_common.h"
+#include "pca9420uk_charger.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Field value and its place in the register. */
+#define PCA9420_CHARGER_FIELD(value, name) ((uint8_t)(((uint32_t)(value) << name##_SHIFT) & name##_MASK))
+#define PCA9420_CHARGER_VALUE(reg, name)   ((uint8_t)(((reg) & name##_MASK) >> name##_SHIFT))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* Bits of CHG_CNTL0..7 that hold fields, the key and reserved bits are not compared. */
+static const uint8_t s_fieldBits[PCA9420_CHARGER_REG_COUNT] = {
+	PCA9420_NTC_EN_MASK | PCA9420_CHG_TIMER_EN_MASK | PCA9420_CHG_EN_MASK,
+	PCA9420_MODE_ICHG_CC_MASK,
+	PCA9420_MODE_ICHG_TOPOFF_MASK,
+	PCA9420_MODE_ICHG_LOW_MASK,
+	PCA9420_MODE_ICHG_DAED_TIMER_MASK | PCA9420_MODE_ICHG_DAED_MASK,
+	PCA9420_VBAT_RESTART_MASK | PCA9420_VBAT_REG_MASK,
+	PCA9420_NTC_RES_SEL_MASK | PCA9420_ICHG_FAST_TIMER_MASK | PCA9420_ICHG_PREQ_TIMER_MASK | PCA9420_T_TOPOFF_TIMER_MASK,
+	PCA9420_NTC_BETA_MASK | PCA9420_THM_REG_MASK,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* A field fits when nothing of it falls outside its mask. */
+static bool PCA9420_CHARGER_Fits(uint8_t value, uint8_t mask, uint8_t shift)
+{
+	return ((uint32_t)value << shift) == (((uint32_t)value << shift) & mask);
+}
+
+static bool PCA9420_CHARGER_Valid(const pca9420_charger_config_t *pConfig)
+{
+	return PCA9420_CHARGER_Fits(pConfig->enable, PCA9420_CHG_EN_MASK, PCA9420_CHG_EN_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->safetyTimers, PCA9420_CHG_TIMER_EN_MASK, PCA9420_CHG_TIMER_EN_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->ntc, PCA9420_NTC_EN_MASK, PCA9420_NTC_EN_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->ccCurrent, PCA9420_MODE_ICHG_CC_MASK, PCA9420_MODE_ICHG_CC_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->topoffCurrent, PCA9420_MODE_ICHG_TOPOFF_MASK, PCA9420_MODE_ICHG_TOPOFF_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->lowCurrent, PCA9420_MODE_ICHG_LOW_MASK, PCA9420_MODE_ICHG_LOW_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->deadTimer, PCA9420_MODE_ICHG_DAED_TIMER_MASK, PCA9420_MODE_ICHG_DEAD_TIMER_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->deadCurrent, PCA9420_MODE_ICHG_DAED_MASK, PCA9420_MODE_ICHG_DEAD_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->recharge, PCA9420_VBAT_RESTART_MASK, PCA9420_VBAT_RESTART_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->vbatReg, PCA9420_VBAT_REG_MASK, PCA9420_VBAT_REG_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->ntcResistor, PCA9420_NTC_RES_SEL_MASK, PCA9420_NTC_RES_SEL_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->fastTimer, PCA9420_ICHG_FAST_TIMER_MASK, PCA9420_ICHG_FAST_TIMER_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->preqTimer, PCA9420_ICHG_PREQ_TIMER_MASK, PCA9420_ICHG_PREQ_TIMER_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->topoffTimer, PCA9420_T_TOPOFF_TIMER_MASK, PCA9420_T_TOPOFF_TIMER_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->ntcBeta, PCA9420_NTC_BETA_MASK, PCA9420_NTC_BETA_SHIFT) &&
+	       PCA9420_CHARGER_Fits(pConfig->thermalReg, PCA9420_THM_REG_MASK, PCA9420_THM_REG_SHIFT);
+}
+
+static void PCA9420_CHARGER_Encode(const pca9420_charger_config_t *pConfig, uint8_t *pRegs)
+{
+	pRegs[0] = (uint8_t)(PCA9420UK_CHG_LOCK_MASK | PCA9420_CHARGER_FIELD(pConfig->ntc, PCA9420_NTC_EN) |
+	                     PCA9420_CHARGER_FIELD(pConfig->safetyTimers, PCA9420_CHG_TIMER_EN) |
+	                     PCA9420_CHARGER_FIELD(pConfig->enable, PCA9420_CHG_EN));
+	pRegs[1] = PCA9420_CHARGER_FIELD(pConfig->ccCurrent, PCA9420_MODE_ICHG_CC);
+	pRegs[2] = PCA9420_CHARGER_FIELD(pConfig->topoffCurrent, PCA9420_MODE_ICHG_TOPOFF);
+	pRegs[3] = PCA9420_CHARGER_FIELD(pConfig->lowCurrent, PCA9420_MODE_ICHG_LOW);
+	pRegs[4] = (uint8_t)(((uint32_t)pConfig->deadTimer << PCA9420_MODE_ICHG_DEAD_TIMER_SHIFT) |
+	                     ((uint32_t)pConfig->deadCurrent << PCA9420_MODE_ICHG_DEAD_SHIFT));
+	pRegs[5] = (uint8_t)(PCA9420_CHARGER_FIELD(pConfig->recharge, PCA9420_VBAT_RESTART) |
+	                     PCA9420_CHARGER_FIELD(pConfig->vbatReg, PCA9420_VBAT_REG));
+	pRegs[6] = (uint8_t)(PCA9420_CHARGER_FIELD(pConfig->ntcResistor, PCA9420_NTC_RES_SEL) |
+	                     PCA9420_CHARGER_FIELD(pConfig->fastTimer, PCA9420_ICHG_FAST_TIMER) |
+	                     PCA9420_CHARGER_FIELD(pConfig->preqTimer, PCA9420_ICHG_PREQ_TIMER) |
+	                     PCA9420_CHARGER_FIELD(pConfig->topoffTimer, PCA9420_T_TOPOFF_TIMER));
+	pRegs[7] = (uint8_t)(PCA9420_CHARGER_FIELD(pConfig->ntcBeta, PCA9420_NTC_BETA) |
+	                     PCA9420_CHARGER_FIELD(pConfig->thermalReg, PCA9420_THM_REG));
+}
+
+static void PCA9420_CHARGER_Decode(const uint8_t *pRegs, pca9420_charger_config_t *pConfig)
+{
+	pConfig->enable = PCA9420_CHARGER_VALUE(pRegs[0], PCA9420_CHG_EN);
+	pConfig->safetyTimers = PCA9420_CHARGER_VALUE(pRegs[0], PCA9420_CHG_TIMER_EN);
+	pConfig->ntc = PCA9420_CHARGER_VALUE(pRegs[0], PCA9420_NTC_EN);
+	pConfig->ccCurrent = PCA9420_CHARGER_VALUE(pRegs[1], PCA9420_MODE_ICHG_CC);
+	pConfig->topoffCurrent = PCA9420_CHARGER_VALUE(pRegs[2], PCA9420_MODE_ICHG_TOPOFF);
+	pConfig->lowCurrent = PCA9420_CHARGER_VALUE(pRegs[3], PCA9420_MODE_ICHG_LOW);
+	pConfig->deadTimer = (uint8_t)((pRegs[4] & PCA9420_MODE_ICHG_DAED_TIMER_MASK) >> PCA9420_MODE_ICHG_DEAD_TIMER_SHIFT);
+	pConfig->deadCurrent = (uint8_t)((pRegs[4] & PCA9420_MODE_ICHG_DAED_MASK) >> PCA9420_MODE_ICHG_DEAD_SHIFT);
+	pConfig->recharge = PCA9420_CHARGER_VALUE(pRegs[5], PCA9420_VBAT_RESTART);
+	pConfig->vbatReg = PCA9420_CHARGER_VALUE(pRegs[5], PCA9420_VBAT_REG);
+	pConfig->ntcResistor = PCA9420_CHARGER_VALUE(pRegs[6], PCA9420_NTC_RES_SEL);
+	pConfig->fastTimer = PCA9420_CHARGER_VALUE(pRegs[6], PCA9420_ICHG_FAST_TIMER);
+	pConfig->preqTimer = PCA9420_CHARGER_VALUE(pRegs[6], PCA9420_ICHG_PREQ_TIMER);
+	pConfig->topoffTimer = PCA9420_CHARGER_VALUE(pRegs[6], PCA9420_T_TOPOFF_TIMER);
+	pConfig->ntcBeta = PCA9420_CHARGER_VALUE(pRegs[7], PCA9420_NTC_BETA);
+	pConfig->thermalReg = PCA9420_CHARGER_VALUE(pRegs[7], PCA9420_THM_REG);
+}
+
+int32_t PCA9420_CHARGER_Get(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_charger_config_t *pConfig)
+{
+	uint8_t regs[PCA9420_CHARGER_REG_COUNT];
+	int32_t status;
+
+	if ((pSensorHandle == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCA9420_DRV_BlockRead(pSensorHandle, PCA9420UK_CHG_CNTL0, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	PCA9420_CHARGER_Decode(regs, pConfig);
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_CHARGER_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_charger_config_t *pConfig)
+{
+	uint8_t regs[PCA9420_CHARGER_REG_COUNT];
+	uint8_t live[PCA9420_CHARGER_REG_COUNT];
+	uint8_t expected, actual;
+	int32_t status;
+	uint32_t i;
+
+	if ((pSensorHandle == NULL) || (pConfig == NULL) || !PCA9420_CHARGER_Valid(pConfig))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/* CHG_CNTL0 leads the burst, its key opens the registers after it. */
+	PCA9420_CHARGER_Encode(pConfig, regs);
+	status = PCA9420_DRV_BlockWrite(pSensorHandle, PCA9420UK_CHG_CNTL0, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	status = PCA9420_DRV_BlockRead(pSensorHandle, PCA9420UK_CHG_CNTL0, live, sizeof(live));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	for (i = 0u; i < PCA9420_CHARGER_REG_COUNT; i++)
+	{
+		expected = (uint8_t)(regs[i] & s_fieldBits[i]);
+		actual = (uint8_t)(live[i] & s_fieldBits[i]);
+		if (expected != actual)
+		{
+			PCA9420_EVLOG_Record(kPCA9420_EvlogConfigDrift, (uint8_t)(PCA9420UK_CHG_CNTL0 + i),
+			                     (uint16_t)((expected << 8) | actual));
+			status = SENSOR_ERROR_WRITE;
+		}
+	}
+	return status;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_chgprof.c
+ * @brief The pca9420uk_chgprof.c file implements the PCA9420UK charge session profiler.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_chgprof.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Charge current per ICHG_CC code. */
+#define PCA9420_CHGPROF_MA_PER_CODE (5u)
+
+/* A learnt session weighs 1 / 2^PCA9420_CHGPROF_LEARN_SHIFT in the averages. */
+#define PCA9420_CHGPROF_LEARN_SHIFT (2u)
+
+/* Phase before the first read. */
+#define PCA9420_CHGPROF_PHASE_UNKNOWN (0xFFu)
+
+/* CHG_CNTL1 up to CHG_STATUS3 in one burst. */
+#define PCA9420_CHGPROF_READ_LEN (PCA9420UK_CHG_STATUS3 - PCA9420UK_CHG_CNTL1 + 1)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static bool PCA9420_CHGPROF_Charging(uint8_t phase)
+{
+	return (phase >= kPCA9420_ChgDeadBattery) && (phase <= kPCA9420_ChgTopOff);
+}
+
+static uint32_t PCA9420_CHGPROF_TicksToMs(uint32_t ticks)
+{
+	return (uint32_t)((uint64_t)ticks * 1000u / SW_TIMER_TICK_HZ);
+}
+
+static uint32_t PCA9420_CHGPROF_Average(uint32_t average, uint32_t sample, bool first)
+{
+	return first ? sample :
+	               (average - (average >> PCA9420_CHGPROF_LEARN_SHIFT) + (sample >> PCA9420_CHGPROF_LEARN_SHIFT));
+}
+
+static void PCA9420_CHGPROF_Start(pca9420_chgprof_t *pProf, uint32_t now, uint8_t phase)
+{
+	pca9420_chgprof_session_t *pSession = &pProf->session;
+
+	memset(pSession, 0, sizeof(*pSession));
+	memset(pSession->enteredMs, 0xFF, sizeof(pSession->enteredMs));
+	pSession->start = now;
+	pSession->enteredMs[phase] = 0u;
+	pSession->safetyMs = PCA9420_CHGPROF_NONE;
+	pSession->startPhase = phase;
+	pSession->partial = (pProf->phase == PCA9420_CHGPROF_PHASE_UNKNOWN);
+	pSession->end = kPCA9420_ChgprofRunning;
+	pProf->active = true;
+	pProf->sessions++;
+}
+
+/* Folds the phases of a session that reached done into the averages. */
+static void PCA9420_CHGPROF_Learn(pca9420_chgprof_t *pProf)
+{
+	const pca9420_chgprof_session_t *pSession = &pProf->session;
+	bool first;
+	uint8_t phase;
+
+	for (phase = kPCA9420_ChgDeadBattery; phase <= kPCA9420_ChgTopOff; phase++)
+	{
+		if ((pSession->enteredMs[phase] == PCA9420_CHGPROF_NONE) ||
+		    (pSession->partial && (phase == pSession->startPhase)))
+		{
+			continue;
+		}
+		first = ((pProf->learnt & (1u << phase)) == 0u);
+		if (phase == kPCA9420_ChgFastCc)
+		{
+			pProf->learntCharge = PCA9420_CHGPROF_Average(pProf->learntCharge, pSession->ccCharge, first);
+		}
+		else
+		{
+			pProf->learntMs[phase] = PCA9420_CHGPROF_Average(pProf->learntMs[phase], pSession->phaseMs[phase], first);
+		}
+		pProf->learnt |= (uint8_t)(1u << phase);
+	}
+}
+
+static void PCA9420_CHGPROF_End(pca9420_chgprof_t *pProf, uint8_t end)
+{
+	uint32_t minutes = pProf->session.durationMs / 60000u;
+
+	pProf->session.end = end;
+	switch (end)
+	{
+	case kPCA9420_ChgprofDone:
+		pProf->completed++;
+		PCA9420_CHGPROF_Learn(pProf);
+		break;
+	case kPCA9420_ChgprofSafety:
+		pProf->safetyStops++;
+		break;
+	default:
+		pProf->stopped++;
+		break;
+	}
+	pProf->last = pProf->session;
+	pProf->active = false;
+	PCA9420_EVLOG_Record(kPCA9420_EvlogChargeSession, end, (uint16_t)((minutes < 0xFFFFu) ? minutes : 0xFFFFu));
+}
+
+static void PCA9420_CHGPROF_Interrupt(uint32_t sources, void *pUserData)
+{
+	(void)PCA9420_CHGPROF_Update((pca9420_chgprof_t *)pUserData);
+}
+
+static void PCA9420_CHGPROF_Sample(void *pUserData)
+{
+	(void)PCA9420_CHGPROF_Update((pca9420_chgprof_t *)pUserData);
+}
+
+int32_t PCA9420_CHGPROF_Init(pca9420_chgprof_t *pProf, pca9420_irq_t *pIrq, uint16_t capacityMah)
+{
+	int32_t status;
+
+	if ((pProf == NULL) || (pIrq == NULL) || (capacityMah == 0u))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pProf, 0, sizeof(*pProf));
+	pProf->pSensorHandle = pIrq->pSensorHandle;
+	pProf->capacityMah = capacityMah;
+	pProf->phase = PCA9420_CHGPROF_PHASE_UNKNOWN;
+	pProf->last.end = kPCA9420_ChgprofRunning;
+	pProf->mark = SW_TIMER_GetTicks();
+	SW_TIMER_Setup(&pProf->timer, PCA9420_CHGPROF_Sample, pProf);
+
+	status = PCA9420_CHGPROF_Update(pProf);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	return PCA9420_IRQ_Register(pIrq, kPCA9420_IntSrcChgAll, PCA9420_CHGPROF_Interrupt, pProf);
+}
+
+int32_t PCA9420_CHGPROF_Update(pca9420_chgprof_t *pProf)
+{
+	pca9420_chgprof_session_t *pSession = &pProf->session;
+	uint8_t regs[PCA9420_CHGPROF_READ_LEN];
+	uint32_t now = SW_TIMER_GetTicks();
+	uint32_t elapsedMs = PCA9420_CHGPROF_TicksToMs(now - pProf->mark);
+	uint8_t phase, safety;
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pProf->pSensorHandle, PCA9420UK_CHG_CNTL1, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pProf->busErrors++;
+		return status;
+	}
+	phase = (uint8_t)((regs[PCA9420UK_CHG_STATUS2 - PCA9420UK_CHG_CNTL1] & PCA9420_BAT_CHG_STATUS_MASK) >>
+	                  PCA9420_BAT_CHG_STATUS_SHIFT);
+	safety = (uint8_t)((regs[PCA9420UK_CHG_STATUS3 - PCA9420UK_CHG_CNTL1] & PCA9420_SFTY_TIMER_MASK) >>
+	                   PCA9420_SFTY_TIMER_SHIFT);
+
+	/* The time since the last sample belongs to the phase and the current read then. */
+	if (pProf->active)
+	{
+		pSession->phaseMs[pProf->phase] += elapsedMs;
+		if (pProf->phase == kPCA9420_ChgFastCc)
+		{
+			pSession->ccCharge += (uint32_t)((uint64_t)pProf->ma * elapsedMs / 1000u);
+		}
+		pSession->durationMs = PCA9420_CHGPROF_TicksToMs(now - pSession->start);
+		if ((safety != kPCA9420_SafetyOk) && (pSession->safety == kPCA9420_SafetyOk))
+		{
+			pSession->safety = safety;
+			pSession->safetyMs = pSession->durationMs;
+		}
+	}
+
+	if (phase != pProf->phase)
+	{
+		PCA9420_EVLOG_Record(kPCA9420_EvlogChargerPhase, phase, pProf->phase);
+		if (pProf->active && PCA9420_CHGPROF_Charging(phase) && (pSession->enteredMs[phase] == PCA9420_CHGPROF_NONE))
+		{
+			pSession->enteredMs[phase] = pSession->durationMs;
+		}
+	}
+
+	if (pProf->active)
+	{
+		if (safety != kPCA9420_SafetyOk)
+		{
+			PCA9420_CHGPROF_End(pProf, kPCA9420_ChgprofSafety);
+		}
+		else if (phase == kPCA9420_ChgDone)
+		{
+			PCA9420_CHGPROF_End(pProf, kPCA9420_ChgprofDone);
+		}
+		else if (!PCA9420_CHGPROF_Charging(phase))
+		{
+			PCA9420_CHGPROF_End(pProf, kPCA9420_ChgprofStopped);
+		}
+	}
+	else if (PCA9420_CHGPROF_Charging(phase) && (safety == kPCA9420_SafetyOk) &&
+	         ((phase != pProf->phase) || (pProf->safety != kPCA9420_SafetyOk)))
+	{
+		PCA9420_CHGPROF_Start(pProf, now, phase);
+	}
+
+	pProf->phase = phase;
+	pProf->safety = safety;
+	pProf->ma = (uint16_t)((regs[0] & PCA9420_MODE_ICHG_CC_MASK) * PCA9420_CHGPROF_MA_PER_CODE);
+	pProf->mark = now;
+
+	/* No interrupt marks a phase change, sample while a session runs. */
+	if (pProf->active)
+	{
+		if (!SW_TIMER_IsActive(&pProf->timer))
+		{
+			SW_TIMER_Start(&pProf->timer, SW_TIMER_MS_TO_TICKS(PCA9420_CHGPROF_SAMPLE_MS),
+			               SW_TIMER_MS_TO_TICKS(PCA9420_CHGPROF_SAMPLE_MS));
+		}
+	}
+	else
+	{
+		SW_TIMER_Stop(&pProf->timer);
+	}
+	return SENSOR_ERROR_NONE;
+}
+
+uint32_t PCA9420_CHGPROF_GetTimeToFullMs(const pca9420_chgprof_t *pProf)
+{
+	const pca9420_chgprof_session_t *pSession = &pProf->session;
+	uint64_t total = 0u;
+	uint64_t expected, charge, spent;
+	uint8_t phase;
+
+	if (!pProf->active || (pProf->ma == 0u))
+	{
+		return PCA9420_CHGPROF_NONE;
+	}
+
+	/* What is left of the phase in progress, then the phases after it. */
+	for (phase = pProf->phase; phase <= kPCA9420_ChgTopOff; phase++)
+	{
+		if (phase == kPCA9420_ChgFastCc)
+		{
+			charge = ((pProf->learnt & (1u << phase)) != 0u) ? pProf->learntCharge
+			                                                  : ((uint64_t)pProf->capacityMah * 3600u * 7u / 10u);
+			spent = (phase == pProf->phase) ? pSession->ccCharge : 0u;
+			expected = (charge > spent) ? ((charge - spent) * 1000u / pProf->ma) : 0u;
+		}
+		else
+		{
+			if ((pProf->learnt & (1u << phase)) != 0u)
+			{
+				expected = pProf->learntMs[phase];
+			}
+			else if (phase == kPCA9420_ChgFastCv)
+			{
+				expected = (uint64_t)pProf->capacityMah * 3600u * 3u / 10u * 2000u / pProf->ma;
+			}
+			else
+			{
+				expected = 0u;
+			}
+			spent = (phase == pProf->phase) ? pSession->phaseMs[phase] : 0u;
+			expected = (expected > spent) ? (expected - spent) : 0u;
+		}
+		total += expected;
+	}
+	return (total < PCA9420_CHGPROF_NONE) ? (uint32_t)total : (PCA9420_CHGPROF_NONE - 1u);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_chgprof.h
+ * @brief The pca9420uk_chgprof.h file describes the PCA9420UK charge session profiler.
+
+    The profiler follows the charger phase of CHG_STATUS2 and the safety timer status of
+    CHG_STATUS3. A session starts when the charger leaves idle or done for a charging phase
+    and ends in done, back in idle, or with a safety timer expiry. For each session it keeps
+    when every phase was first entered, the time spent in each phase, the charge of the
+    constant current phase worked out from the programmed ICHG_CC, and how the session ended.
+    Every phase change and every session end is recorded in the event log.
+
+    Sessions that reach done teach the profiler: the constant current charge and the time of
+    each other phase are averaged over past sessions. The time to full is the remainder of the
+    phase in progress plus the learnt time of the phases after it, the constant current part
+    is charge over the current programmed now, so a lower current stretches the estimate. A
+    phase the session started in is not learnt, its beginning was not seen. Until a session
+    has been learnt the constant current phase is taken as 70% of capacityMah and the constant
+    voltage phase as the remaining 30% at half the current.
+
+    The profiler runs from the interrupt dispatcher, see pca9420uk_irq.h, on every charger
+    interrupt, one burst read each. The PMIC has no interrupt for phase changes, so while a
+    session runs a software timer also samples every PCA9420_CHGPROF_SAMPLE_MS and a phase
+    change is timed at the sample that sees it, within that interval.
+*/
+
+#ifndef PCA9420UK_CHGPROF_H_
+#define PCA9420UK_CHGPROF_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_irq.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Charger phases, indexed by enum _pca9420_chg_phase. */
+#define PCA9420_CHGPROF_PHASES (8u)
+
+/*! @brief Phase not entered, or no estimate. */
+#define PCA9420_CHGPROF_NONE (0xFFFFFFFFu)
+
+/*! @brief Sample interval while a session runs. */
+#ifndef PCA9420_CHGPROF_SAMPLE_MS
+#define PCA9420_CHGPROF_SAMPLE_MS (1000u)
+#endif
+
+/*! @brief How a session ended, also the arg of the kPCA9420_EvlogChargeSession records. */
+enum _pca9420_chgprof_end
+{
+	kPCA9420_ChgprofRunning = 0u, /*!< Not ended. */
+	kPCA9420_ChgprofDone    = 1u, /*!< Charge done. */
+	kPCA9420_ChgprofStopped = 2u, /*!< Back in idle, input removed or charger disabled. */
+	kPCA9420_ChgprofSafety  = 3u, /*!< Safety timer expired or battery short test failed. */
+};
+
+/*!
+ * @brief One charge session.
+ */
+typedef struct
+{
+	uint32_t start;                             /*!< Tick the session started. */
+	uint32_t durationMs;                        /*!< Length, up to the last update while running. */
+	uint32_t enteredMs[PCA9420_CHGPROF_PHASES]; /*!< Time from the start each phase was first entered, PCA9420_CHGPROF_NONE if not. */
+	uint32_t phaseMs[PCA9420_CHGPROF_PHASES];   /*!< Time in each phase. */
+	uint32_t ccCharge;                          /*!< Charge of the constant current phase in mAs. */
+	uint32_t safetyMs;                          /*!< Time from the start the safety timer status was set, PCA9420_CHGPROF_NONE if not. */
+	uint8_t startPhase;                         /*!< Phase the session started in. */
+	bool partial;                               /*!< Started before the profiler, the start phase was not seen whole. */
+	uint8_t safety;                             /*!< enum _pca9420_safety_status, first one set. */
+	uint8_t end;                                /*!< enum _pca9420_chgprof_end. */
+} pca9420_chgprof_session_t;
+
+/*!
+ * @brief Profiler context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;     /*!< PMIC handle. */
+	uint16_t capacityMah;                          /*!< Battery capacity for the estimate before the first learnt session. */
+	uint8_t phase;                                 /*!< enum _pca9420_chg_phase last read. */
+	uint8_t safety;                                /*!< enum _pca9420_safety_status last read. */
+	uint16_t ma;                                   /*!< Constant current programmed, last read. */
+	bool active;                                   /*!< A session is running. */
+	sw_timer_t timer;                              /*!< Sample timer while a session runs. */
+	uint32_t mark;                                 /*!< Tick of the last update. */
+	pca9420_chgprof_session_t session;             /*!< Running session. */
+	pca9420_chgprof_session_t last;                /*!< Last ended session. */
+	uint32_t learntCharge;                         /*!< Average constant current charge in mAs. */
+	uint32_t learntMs[PCA9420_CHGPROF_PHASES];     /*!< Average time of the other phases. */
+	uint8_t learnt;                                /*!< Phases averaged, bit per enum _pca9420_chg_phase. */
+	uint32_t sessions;                             /*!< Sessions started. */
+	uint32_t completed;                            /*!< Sessions ended in done. */
+	uint32_t stopped;                              /*!< Sessions ended back in idle. */
+	uint32_t safetyStops;                          /*!< Sessions ended by the safety timers. */
+	uint32_t busErrors;                            /*!< Reads that failed. */
+} pca9420_chgprof_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start the profiler.
+ *  @details     This function reads the charger state, starts a partial session when already charging and
+ *               registers with the dispatcher for the charger interrupts.
+ *  @param[out]  pProf          profiler context.
+ *  @param[in]   pIrq           interrupt dispatcher.
+ *  @param[in]   capacityMah    battery capacity.
+ *  @constraints SW_TIMER_Init() and PCA9420_IRQ_Init() must have been called. Not on PCA9421.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CHGPROF_Init() returns the status, SENSOR_ERROR_INVALID_PARAM for a zero capacity.
+ */
+int32_t PCA9420_CHGPROF_Init(pca9420_chgprof_t *pProf, pca9420_irq_t *pIrq, uint16_t capacityMah);
+
+/*! @brief       The interface function to sample the charger.
+ *  @details     This function reads CHG_CNTL1..CHG_STATUS3 in one burst, accounts the time since the last
+ *               sample and follows phase changes and session ends, the dispatcher calls it on every
+ *               charger interrupt and the sample timer while a session runs.
+ *  @param[in]   pProf          profiler context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CHGPROF_Update() returns the status.
+ */
+int32_t PCA9420_CHGPROF_Update(pca9420_chgprof_t *pProf);
+
+/*! @brief       The interface function to estimate the time to full.
+ *  @param[in]   pProf          profiler context.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_CHGPROF_GetTimeToFullMs() returns the time in milliseconds from the last sample,
+ *               PCA9420_CHGPROF_NONE when not charging or charging at 0 mA.
+ */
+uint32_t PCA9420_CHGPROF_GetTimeToFullMs(const pca9420_chgprof_t *pProf);
+
+#endif /* PCA9420UK_CHGPROF_H_ */
@@ -0,0 +1,1326 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_cli.c
+ * @brief The pca9420uk_cli.c file implements the PCA9420UK line-oriented command interpreter.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pca9420uk_cli.h"
+#include "pca9420uk.h"
+#include "pca9420uk_profile.h"
+#include "fixed_point.h"
+#include "sw_timer.h"
+#include "fsl_debug_console.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Registers covered by "dump regs", DEV_INFO up to the last mode configuration register. */
+#define PCA9420_CLI_DUMP_FIRST (PCA9420UK_DEV_INFO)
+#define PCA9420_CLI_DUMP_COUNT (PCA9420UK_MODECFG_3_3 - PCA9420UK_DEV_INFO + 1)
+
+/* Registers per mode configuration group. */
+#define PCA9420_CLI_MODECFG_LEN (4u)
+
+typedef int32_t (*pca9420_cli_handler_t)(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+
+/*!
+ * @brief Command table entry, a NULL object matches any second word.
+ */
+typedef struct
+{
+	const char *pVerb;
+	const char *pObject;
+	pca9420_cli_handler_t handler;
+} pca9420_cli_command_t;
+
+/*!
+ * @brief Named byte field of a configuration structure.
+ */
+typedef struct
+{
+	const char *pName;
+	uint8_t offset;
+} pca9420_cli_field_t;
+
+/*!
+ * @brief Regulator description, the voltage field is in MODECFG_m_cfgIndex.
+ */
+typedef struct
+{
+	const char *pName;
+	pca9420_regulator_t regulator;
+	enum _pca9420_vol_reg_source source;
+	uint8_t cfgIndex;
+	uint8_t voltMask;
+	uint8_t voltShift;
+	uint8_t enMask;
+} pca9420_cli_rail_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static int32_t PCA9420_CLI_Help(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_Exit(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetMode(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetMode(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetWdog(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetWdog(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetReg(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetReg(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetChg(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_DumpRegs(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetStream(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetStream(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_ProfileList(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetDvfs(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetDvfs(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetLp(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_Lp(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetEnergy(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetLoad(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetSeq(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_Seq(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetThermal(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetJeita(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetIlim(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetSession(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetCharger(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetCharger(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetBrownout(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetBrownout(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetVerify(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetVerify(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_Profile(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_GetRail(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+static int32_t PCA9420_CLI_SetRail(pca9420_cli_t *pCli, uint32_t argc, char *argv[]);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const pca9420_cli_command_t s_commands[] = {
+	{"help", NULL, PCA9420_CLI_Help},
+	{"exit", NULL, PCA9420_CLI_Exit},
+	{"get", "mode", PCA9420_CLI_GetMode},
+	{"set", "mode", PCA9420_CLI_SetMode},
+	{"get", "wdog", PCA9420_CLI_GetWdog},
+	{"set", "wdog", PCA9420_CLI_SetWdog},
+	{"get", "reg", PCA9420_CLI_GetReg},
+	{"set", "reg", PCA9420_CLI_SetReg},
+	{"get", "chg", PCA9420_CLI_GetChg},
+	{"get", "charger", PCA9420_CLI_GetCharger},
+	{"set", "charger", PCA9420_CLI_SetCharger},
+	{"dump", "regs", PCA9420_CLI_DumpRegs},
+	{"get", "stream", PCA9420_CLI_GetStream},
+	{"set", "stream", PCA9420_CLI_SetStream},
+	{"profile", "list", PCA9420_CLI_ProfileList},
+	{"get", "dvfs", PCA9420_CLI_GetDvfs},
+	{"set", "dvfs", PCA9420_CLI_SetDvfs},
+	{"get", "lp", PCA9420_CLI_GetLp},
+	{"lp", NULL, PCA9420_CLI_Lp},
+	{"get", "energy", PCA9420_CLI_GetEnergy},
+	{"set", "load", PCA9420_CLI_SetLoad},
+	{"get", "seq", PCA9420_CLI_GetSeq},
+	{"seq", NULL, PCA9420_CLI_Seq},
+	{"get", "thermal", PCA9420_CLI_GetThermal},
+	{"get", "jeita", PCA9420_CLI_GetJeita},
+	{"get", "ilim", PCA9420_CLI_GetIlim},
+	{"get", "session", PCA9420_CLI_GetSession},
+	{"get", "brownout", PCA9420_CLI_GetBrownout},
+	{"set", "brownout", PCA9420_CLI_SetBrownout},
+	{"get", "verify", PCA9420_CLI_GetVerify},
+	{"set", "verify", PCA9420_CLI_SetVerify},
+	{"profile", NULL, PCA9420_CLI_Profile},
+	/* Regulator names, keep last. */
+	{"get", NULL, PCA9420_CLI_GetRail},
+	{"set", NULL, PCA9420_CLI_SetRail},
+};
+
+static const pca9420_cli_rail_t s_rails[] = {
+	{"sw1", kPCA9420_RegulatorSwitch1, kPCA9420_SW1, 0u, PCA9420_MODECFG_0_SW1_OUT_MASK, 0u, PCA9420_SW1_EN_MASK},
+	{"sw2", kPCA9420_RegulatorSwitch2, kPCA9420_SW2, 1u, PCA9420_MODECFG_1_SW2_OUT_MASK, 0u, PCA9420_SW2_EN_MASK},
+	{"ldo1", kPCA9420_RegulatorLdo1, kPCA9420_LDO1, 2u, PCA9420_MODECFG_2_LDO1_OUT_MASK, PCA9420_MODECFG_2_LDO1_OUT_SHIFT,
+	 PCA9420_LDO1_EN_MASK},
+	{"ldo2", kPCA9420_RegulatorLdo2, kPCA9420_LDO2, 3u, PCA9420_MODECFG_3_LDO2_OUT_MASK, 0u, PCA9420_LDO2_EN_MASK},
+};
+
+#if (!PCA9421UK_EVM_EN)
+/* Charger configuration fields by name. */
+static const pca9420_cli_field_t s_chargerFields[] = {
+	{"en", offsetof(pca9420_charger_config_t, enable)},
+	{"timers", offsetof(pca9420_charger_config_t, safetyTimers)},
+	{"ntc", offsetof(pca9420_charger_config_t, ntc)},
+	{"icc", offsetof(pca9420_charger_config_t, ccCurrent)},
+	{"itopoff", offsetof(pca9420_charger_config_t, topoffCurrent)},
+	{"ilow", offsetof(pca9420_charger_config_t, lowCurrent)},
+	{"dead_timer", offsetof(pca9420_charger_config_t, deadTimer)},
+	{"idead", offsetof(pca9420_charger_config_t, deadCurrent)},
+	{"recharge", offsetof(pca9420_charger_config_t, recharge)},
+	{"vbat", offsetof(pca9420_charger_config_t, vbatReg)},
+	{"ntc_res", offsetof(pca9420_charger_config_t, ntcResistor)},
+	{"fast_timer", offsetof(pca9420_charger_config_t, fastTimer)},
+	{"preq_timer", offsetof(pca9420_charger_config_t, preqTimer)},
+	{"topoff_timer", offsetof(pca9420_charger_config_t, topoffTimer)},
+	{"beta", offsetof(pca9420_charger_config_t, ntcBeta)},
+	{"thm_reg", offsetof(pca9420_charger_config_t, thermalReg)},
+};
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static int32_t PCA9420_CLI_Error(int32_t status, const char *pReason)
+{
+	PRINTF("ERR %d %s\r\n", (int)status, pReason);
+	return status;
+}
+
+static int32_t PCA9420_CLI_DriverError(int32_t status)
+{
+	return PCA9420_CLI_Error(status, (status == SENSOR_ERROR_WRITE) ? "write failed" : "read failed");
+}
+
+static bool PCA9420_CLI_ParseNumber(const char *pText, uint32_t max, uint32_t *pValue)
+{
+	char *pEnd;
+	unsigned long value;
+
+	if ((pText == NULL) || (*pText == '\0') || (*pText == '-'))
+	{
+		return false;
+	}
+
+	value = strtoul(pText, &pEnd, 0);
+	if ((*pEnd != '\0') || (value > max))
+	{
+		return false;
+	}
+
+	*pValue = (uint32_t)value;
+	return true;
+}
+
+static bool PCA9420_CLI_ParseMode(const char *pText, enum _pca9420_mode *pMode)
+{
+	uint32_t mode;
+
+	if (strncmp(pText, "mode", 4) == 0)
+	{
+		pText += 4;
+	}
+	if (!PCA9420_CLI_ParseNumber(pText, kPCA9420_Mode3, &mode))
+	{
+		return false;
+	}
+
+	*pMode = (enum _pca9420_mode)mode;
+	return true;
+}
+
+/* Takes the mode from argv[index] when present, else the active one. */
+static int32_t PCA9420_CLI_ModeArg(pca9420_cli_t *pCli, uint32_t argc, char *argv[], uint32_t index, enum _pca9420_mode *pMode)
+{
+	int32_t status;
+
+	if (argc > index)
+	{
+		return PCA9420_CLI_ParseMode(argv[index], pMode) ? SENSOR_ERROR_NONE
+		                                                : PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "bad mode");
+	}
+
+	status = PCA9420_Get_mode_control(pCli->pSensorHandle, pMode);
+	return (SENSOR_ERROR_NONE == status) ? status : PCA9420_CLI_DriverError(status);
+}
+
+static void PCA9420_CLI_RefreshWdog(pca9420_cli_t *pCli)
+{
+	if (pCli->pWdog != NULL)
+	{
+		(void)PCA9420_WDOG_Refresh(pCli->pWdog);
+	}
+}
+
+static int32_t PCA9420_CLI_Help(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	PRINTF("OK cmds=help,exit,get/set:mode|sw1|sw2|ldo1|ldo2|wdog|reg,get/set:stream|dvfs|charger|brownout|verify,get:chg|lp|energy|seq|thermal|jeita|ilim|session,set:load,dump:regs,profile:list|save|apply|diff|delete,lp:enter|exit,seq\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_Exit(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pCli->exitRequested = true;
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetMode(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	enum _pca9420_mode mode;
+	int32_t status;
+
+	status = PCA9420_Get_mode_control(pCli->pSensorHandle, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK mode=%d\r\n", (int)mode);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetMode(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	enum _pca9420_mode mode;
+	int32_t status;
+
+	if (argc != 3u)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set mode <0..3>");
+	}
+	status = PCA9420_CLI_ModeArg(pCli, argc, argv, 2u, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	status = PCA9420_Set_mode_control(pCli->pSensorHandle, mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PCA9420_CLI_RefreshWdog(pCli);
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetWdog(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	static const uint8_t seconds[] = {0u, 16u, 32u, 64u};
+	enum _pca9420_mode mode;
+	enum _pca9420_wd_timer timer;
+	int32_t status;
+
+	status = PCA9420_CLI_ModeArg(pCli, argc, argv, 2u, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	status = PCA9420_Get_wtchdg_timer(pCli->pSensorHandle, mode, &timer);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK mode=%d wdog=%d\r\n", (int)mode, (int)seconds[timer & 0x03u]);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetWdog(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	enum _pca9420_mode mode;
+	enum _pca9420_wd_timer timer;
+	uint32_t seconds;
+	int32_t status;
+
+	if ((argc != 4u) || !PCA9420_CLI_ParseNumber(argv[3], 64u, &seconds))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set wdog <mode> <0|16|32|64>");
+	}
+	switch (seconds)
+	{
+	case 0u:
+		timer = kPCA9420_WdTimerDisabled;
+		break;
+	case 16u:
+		timer = kPCA9420_WdTimer16s;
+		break;
+	case 32u:
+		timer = kPCA9420_WdTimer32s;
+		break;
+	case 64u:
+		timer = kPCA9420_WdTimer64s;
+		break;
+	default:
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "bad timeout");
+	}
+	status = PCA9420_CLI_ModeArg(pCli, argc, argv, 2u, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	status = PCA9420_Set_wtchdg_timer(pCli->pSensorHandle, mode, timer);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PCA9420_CLI_RefreshWdog(pCli);
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetReg(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	uint32_t address;
+	uint16_t value = 0;
+	int32_t status;
+
+	if ((argc != 3u) || !PCA9420_CLI_ParseNumber(argv[2], 0xFFu, &address))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: get reg <addr>");
+	}
+
+	status = PCA9420_DRV_Read(pCli->pSensorHandle, (uint8_t)address, &value);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK 0x%02X=0x%02X\r\n", (unsigned)address, (unsigned)(value & 0xFFu));
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetReg(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	uint32_t address, value;
+	int32_t status;
+
+	if ((argc != 4u) || !PCA9420_CLI_ParseNumber(argv[2], 0xFFu, &address) ||
+	    !PCA9420_CLI_ParseNumber(argv[3], 0xFFu, &value))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set reg <addr> <value>");
+	}
+
+	status = PCA9420_DRV_Write(pCli->pSensorHandle, (uint8_t)address, (uint16_t)value);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetChg(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+#if (!PCA9421UK_EVM_EN)
+	uint8_t regs[PCA9420UK_CHG_STATUS3 - PCA9420UK_CHG_STATUS0 + 1];
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pCli->pSensorHandle, PCA9420UK_CHG_STATUS0, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK in=%d bat=%d chg=%d temp=%d timer=%d status=0x%02X,0x%02X,0x%02X,0x%02X\r\n",
+	       (regs[1] & PCA9420_IN_PWR_STATUS_MASK) >> PCA9420_IN_PWR_STATUS_SHIFT,
+	       (regs[2] & PCA9420_BAT_DETAIL_STATUS_MASK) >> PCA9420_BAT_DETAIL_STATUS_SHIFT,
+	       (regs[2] & PCA9420_BAT_CHG_STATUS_MASK) >> PCA9420_BAT_CHG_STATUS_SHIFT,
+	       (regs[3] & PCA9420_TEMP_STATUS_MASK) >> PCA9420_TEMP_STATUS_SHIFT,
+	       (regs[3] & PCA9420_SFTY_TIMER_MASK) >> PCA9420_SFTY_TIMER_SHIFT, regs[0], regs[1], regs[2], regs[3]);
+	return SENSOR_ERROR_NONE;
+#else
+	return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no charger on PCA9421");
+#endif
+}
+
+static int32_t PCA9420_CLI_DumpRegs(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	uint8_t regs[PCA9420_CLI_DUMP_COUNT];
+	int32_t status;
+	uint32_t i;
+
+	status = PCA9420_DRV_BlockRead(pCli->pSensorHandle, PCA9420_CLI_DUMP_FIRST, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK");
+	for (i = 0; i < sizeof(regs); i++)
+	{
+		PRINTF(" %02X=%02X", (unsigned)(PCA9420_CLI_DUMP_FIRST + i), regs[i]);
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetStream(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_telemetry_t *pTelemetry = pCli->pTelemetry;
+
+	if (pTelemetry == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no telemetry");
+	}
+	PRINTF("OK hz=%u fields=0x%02X keyframe_ms=%u samples=%u keyframes=%u deltas=%u unchanged=%u dropped=%u errors=%u "
+	       "bytes=%u\r\n",
+	       (unsigned)((pTelemetry->period != 0u) ? pTelemetry->rateHz : 0u), (unsigned)pTelemetry->fields,
+	       (unsigned)(pTelemetry->keyframePeriod * 1000u / SW_TIMER_TICK_HZ), (unsigned)pTelemetry->stats.samples,
+	       (unsigned)pTelemetry->stats.keyframes, (unsigned)pTelemetry->stats.deltas,
+	       (unsigned)pTelemetry->stats.unchanged, (unsigned)pTelemetry->stats.dropped,
+	       (unsigned)pTelemetry->stats.readErrors, (unsigned)pTelemetry->stats.bytesSent);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetStream(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	uint32_t rate, fields = PCA9420_TLM_FIELD_ALL, keyframeMs = PCA9420_TLM_DEFAULT_KEYFRAME_MS;
+	int32_t status;
+
+	if (pCli->pTelemetry == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no telemetry");
+	}
+	if ((argc < 3u) || (argc > 5u) || !PCA9420_CLI_ParseNumber(argv[2], PCA9420_TLM_MAX_RATE_HZ, &rate) ||
+	    ((argc >= 4u) && !PCA9420_CLI_ParseNumber(argv[3], PCA9420_TLM_FIELD_ALL, &fields)) ||
+	    ((argc == 5u) && !PCA9420_CLI_ParseNumber(argv[4], SW_TIMER_MAX_TICKS / SW_TIMER_TICK_HZ * 1000u, &keyframeMs)))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set stream <0..200> [fields] [keyframe_ms]");
+	}
+
+	if (rate == 0u)
+	{
+		PCA9420_TLM_Stop(pCli->pTelemetry);
+	}
+	else
+	{
+		PCA9420_TLM_SetKeyframeInterval(pCli->pTelemetry, keyframeMs);
+		status = PCA9420_TLM_Start(pCli->pTelemetry, (uint16_t)rate, (uint8_t)fields);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return PCA9420_CLI_Error(status, "bad fields");
+		}
+	}
+	/* The first frame goes out from the timer, after this line. */
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetDvfs(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_dvfs_t *pDvfs = pCli->pDvfs;
+	uint32_t i;
+
+	if (pDvfs == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no dvfs");
+	}
+	PRINTF("OK point=%s hz=%u points=", pDvfs->pTable[pDvfs->current].name, (unsigned)pDvfs->pTable[pDvfs->current].coreHz);
+	for (i = 0u; i < pDvfs->count; i++)
+	{
+		PRINTF("%s%s", (i == 0u) ? "" : ",", pDvfs->pTable[i].name);
+	}
+	PRINTF(" transitions=%u failures=%u voltage_us=%u ramp_us=%u clock_us=%u max_us=%u\r\n",
+	       (unsigned)pDvfs->stats.transitions, (unsigned)pDvfs->stats.failures, (unsigned)pDvfs->stats.lastVoltageUs,
+	       (unsigned)pDvfs->stats.lastRampUs, (unsigned)pDvfs->stats.lastClockUs, (unsigned)pDvfs->stats.maxUs);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetDvfs(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_dvfs_t *pDvfs = pCli->pDvfs;
+	uint32_t index;
+	int32_t status;
+
+	if (pDvfs == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no dvfs");
+	}
+	if (argc != 3u)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set dvfs <point>");
+	}
+	if ((pCli->pLowPower != NULL) && PCA9420_LP_IsEntered(pCli->pLowPower))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "low-power entered");
+	}
+	for (index = 0u; (index < pDvfs->count) && (strcmp(argv[2], pDvfs->pTable[index].name) != 0); index++)
+	{
+	}
+	if ((index == pDvfs->count) && !PCA9420_CLI_ParseNumber(argv[2], pDvfs->count - 1u, &index))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no such point");
+	}
+
+	status = PCA9420_DVFS_SetPoint(pDvfs, (uint8_t)index);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_Error(status, (status == SENSOR_ERROR_READ) ? "sw1 power-good timeout" : "transition failed");
+	}
+	PRINTF("OK point=%s voltage_us=%u ramp_us=%u clock_us=%u\r\n", pDvfs->pTable[index].name,
+	       (unsigned)pDvfs->stats.lastVoltageUs, (unsigned)pDvfs->stats.lastRampUs, (unsigned)pDvfs->stats.lastClockUs);
+	return SENSOR_ERROR_NONE;
+}
+
+static void PCA9420_CLI_PrintTimes(const char *pKey, const uint32_t *pTimes, uint32_t count)
+{
+	uint32_t i;
+
+	PRINTF(" %s=", pKey);
+	for (i = 0u; i < count; i++)
+	{
+		PRINTF("%s%u", (i == 0u) ? "" : ",", (unsigned)pTimes[i]);
+	}
+}
+
+static int32_t PCA9420_CLI_GetLp(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_lp_t *pLp = pCli->pLowPower;
+
+	if (pLp == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no low-power sequence");
+	}
+	PRINTF("OK entered=%d entries=%u exits=%u rollbacks=%u entry_us=%u exit_us=%u entry_io=%u/%u exit_io=%u/%u",
+	       PCA9420_LP_IsEntered(pLp) ? 1 : 0, (unsigned)pLp->stats.entries, (unsigned)pLp->stats.exits,
+	       (unsigned)pLp->stats.rollbacks, (unsigned)pLp->stats.entryUs, (unsigned)pLp->stats.exitUs,
+	       (unsigned)pLp->stats.entryReads, (unsigned)pLp->stats.entryWrites, (unsigned)pLp->stats.exitReads,
+	       (unsigned)pLp->stats.exitWrites);
+	PCA9420_CLI_PrintTimes("entry_steps_us", pLp->stats.entryStepUs, pLp->count);
+	PCA9420_CLI_PrintTimes("exit_steps_us", pLp->stats.exitStepUs, pLp->count);
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_Lp(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_lp_t *pLp = pCli->pLowPower;
+	bool entering;
+	int32_t status;
+
+	if (pLp == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no low-power sequence");
+	}
+	if ((argc != 2u) || ((strcmp(argv[1], "enter") != 0) && (strcmp(argv[1], "exit") != 0)))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: lp <enter|exit>");
+	}
+
+	entering = (argv[1][1] == 'n');
+	status = entering ? PCA9420_LP_Enter(pLp) : PCA9420_LP_Exit(pLp);
+	/* Both directions switch the PMIC mode. */
+	PCA9420_CLI_RefreshWdog(pCli);
+	if (SENSOR_ERROR_INIT == status)
+	{
+		return PCA9420_CLI_Error(status, entering ? "already entered" : "not entered");
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_Error(status, entering ? "entry rolled back" : "exit incomplete");
+	}
+	PRINTF("OK us=%u reads=%u writes=%u\r\n", (unsigned)(entering ? pLp->stats.entryUs : pLp->stats.exitUs),
+	       (unsigned)(entering ? pLp->stats.entryReads : pLp->stats.exitReads),
+	       (unsigned)(entering ? pLp->stats.entryWrites : pLp->stats.exitWrites));
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_ProfileList(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const char *pName;
+	const char *pSeparator = "";
+	uint32_t slot;
+
+	PRINTF("OK persistent=%d profiles=", PCA9420_PROFILE_IsPersistent() ? 1 : 0);
+	for (slot = 0u; slot < PCA9420_PROFILE_SLOTS; slot++)
+	{
+		pName = PCA9420_PROFILE_GetName(slot);
+		if (pName != NULL)
+		{
+			PRINTF("%s%s", pSeparator, pName);
+			pSeparator = ",";
+		}
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+/* Prints the OK in front of the first difference, so an error can still take the line. */
+static void PCA9420_CLI_PrintDiff(uint8_t address, uint8_t expected, uint8_t actual, void *pUserData)
+{
+	bool *pStarted = (bool *)pUserData;
+
+	if (!*pStarted)
+	{
+		PRINTF("OK");
+		*pStarted = true;
+	}
+	PRINTF(" %02X=%02X/%02X", (unsigned)address, (unsigned)expected, (unsigned)actual);
+}
+
+static int32_t PCA9420_CLI_Profile(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_cfg_result_t result;
+	bool started = false;
+	uint32_t count;
+	int32_t status;
+
+	if (argc != 3u)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: profile <save|apply|diff|delete> <name>");
+	}
+	if (strlen(argv[2]) > PCA9420_PROFILE_NAME_LEN)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "name too long");
+	}
+
+	if (strcmp(argv[1], "save") == 0)
+	{
+		status = PCA9420_PROFILE_Save(pCli->pSensorHandle, argv[2]);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return PCA9420_CLI_Error(status, (status == SENSOR_ERROR_WRITE) ? "store full or not writable" : "read failed");
+		}
+		PRINTF("OK persistent=%d\r\n", PCA9420_PROFILE_IsPersistent() ? 1 : 0);
+		return SENSOR_ERROR_NONE;
+	}
+	else if (strcmp(argv[1], "apply") == 0)
+	{
+		status = PCA9420_PROFILE_Apply(pCli->pSensorHandle, argv[2], &result);
+		if (SENSOR_ERROR_INVALID_PARAM == status)
+		{
+			return PCA9420_CLI_Error(status, "no such profile");
+		}
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return PCA9420_CLI_DriverError(status);
+		}
+		PCA9420_CLI_RefreshWdog(pCli);
+			PRINTF("OK reads=%u writes=%u changed=%u\r\n", (unsigned)result.reads, (unsigned)result.writes,
+		       (unsigned)result.changed);
+		return SENSOR_ERROR_NONE;
+	}
+	else if (strcmp(argv[1], "delete") == 0)
+	{
+		status = PCA9420_PROFILE_Delete(argv[2]);
+		if (SENSOR_ERROR_INVALID_PARAM == status)
+		{
+			return PCA9420_CLI_Error(status, "no such profile");
+		}
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return PCA9420_CLI_DriverError(status);
+		}
+	}
+	else if (strcmp(argv[1], "diff") == 0)
+	{
+		status = PCA9420_PROFILE_Diff(pCli->pSensorHandle, argv[2], PCA9420_CLI_PrintDiff, &started, &count);
+		if (SENSOR_ERROR_INVALID_PARAM == status)
+		{
+			return PCA9420_CLI_Error(status, "no such profile");
+		}
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return PCA9420_CLI_DriverError(status);
+		}
+		PRINTF("%s diffs=%u\r\n", started ? "" : "OK", (unsigned)count);
+		return SENSOR_ERROR_NONE;
+	}
+	else
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "unknown command");
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static const pca9420_cli_rail_t *PCA9420_CLI_FindRail(const char *pName)
+{
+	uint32_t i;
+
+	for (i = 0; i < sizeof(s_rails) / sizeof(s_rails[0]); i++)
+	{
+		if (strcmp(pName, s_rails[i].pName) == 0)
+		{
+			return &s_rails[i];
+		}
+	}
+	return NULL;
+}
+
+static int32_t PCA9420_CLI_GetEnergy(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_energy_t *pEnergy = pCli->pEnergy;
+	uint32_t mode, i, totalUj = 0u;
+
+	if (pEnergy == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no energy model");
+	}
+	PCA9420_ENERGY_Update(pEnergy);
+	PRINTF("OK mode=%u mcu=%u transitions=%u", (unsigned)pEnergy->mode, (unsigned)pEnergy->mcuState,
+	       (unsigned)pEnergy->transitions);
+	/* Per mode: ms per MCU state, then uJ per rail in s_rails order. */
+	for (mode = 0u; mode < PCA9420_ENERGY_MODES; mode++)
+	{
+		PRINTF(" mode%u_ms=", (unsigned)mode);
+		for (i = 0u; i < PCA9420_ENERGY_MCU_STATES; i++)
+		{
+			PRINTF("%s%u", (i == 0u) ? "" : ",", (unsigned)PCA9420_ENERGY_GetResidencyMs(pEnergy, (uint8_t)mode, (uint8_t)i));
+		}
+		PRINTF(" mode%u_uj=", (unsigned)mode);
+		for (i = 0u; i < PCA9420_ENERGY_RAILS; i++)
+		{
+			PRINTF("%s%u", (i == 0u) ? "" : ",", (unsigned)PCA9420_ENERGY_GetUj(pEnergy, (uint8_t)mode, (uint8_t)i));
+			totalUj += PCA9420_ENERGY_GetUj(pEnergy, (uint8_t)mode, (uint8_t)i);
+		}
+	}
+	PRINTF(" total_uj=%u\r\n", (unsigned)totalUj);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetLoad(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_cli_rail_t *pRail = (argc > 2u) ? PCA9420_CLI_FindRail(argv[2]) : NULL;
+	uint32_t mcuState, loadUa;
+
+	if (pCli->pEnergy == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no energy model");
+	}
+	if ((argc != 5u) || (pRail == NULL) || !PCA9420_CLI_ParseNumber(argv[3], PCA9420_ENERGY_MCU_STATES - 1u, &mcuState) ||
+	    !PCA9420_CLI_ParseNumber(argv[4], UINT32_MAX, &loadUa))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set load <rail> <mcu state> <ua>");
+	}
+
+	(void)PCA9420_ENERGY_SetLoad(pCli->pEnergy, pRail->cfgIndex, (uint8_t)mcuState, loadUa);
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetSeq(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_seq_t *pSeq = pCli->pSequence;
+	uint32_t i;
+
+	if (pSeq == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no rail sequences");
+	}
+	PRINTF("OK seq=%s busy=%d status=%d ms=%u reads=%u writes=%u sequences=", pSeq->pTables[pSeq->current].name,
+	       PCA9420_SEQ_IsBusy(pSeq) ? 1 : 0, (int)pSeq->status, (unsigned)pSeq->totalMs, (unsigned)pSeq->reads,
+	       (unsigned)pSeq->writes);
+	for (i = 0u; i < pSeq->tableCount; i++)
+	{
+		PRINTF("%s%s", (i == 0u) ? "" : ",", pSeq->pTables[i].name);
+	}
+	PCA9420_CLI_PrintTimes("steps_ms", pSeq->stepMs, pSeq->next);
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_Seq(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_seq_t *pSeq = pCli->pSequence;
+	uint32_t index;
+	int32_t status;
+
+	if (pSeq == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no rail sequences");
+	}
+	if (argc != 2u)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: seq <name>");
+	}
+	for (index = 0u; (index < pSeq->tableCount) && (strcmp(argv[1], pSeq->pTables[index].name) != 0); index++)
+	{
+	}
+	if ((index == pSeq->tableCount) && !PCA9420_CLI_ParseNumber(argv[1], pSeq->tableCount - 1u, &index))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no such sequence");
+	}
+
+	status = PCA9420_SEQ_Start(pSeq, (uint8_t)index);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_Error(status, "sequence running");
+	}
+	/* Sequences without pending waits are over already. */
+	if (!PCA9420_SEQ_IsBusy(pSeq) && (SENSOR_ERROR_NONE != pSeq->status))
+	{
+		return PCA9420_CLI_Error(pSeq->status, "sequence failed");
+	}
+	PRINTF("OK seq=%s busy=%d ms=%u\r\n", pSeq->pTables[index].name, PCA9420_SEQ_IsBusy(pSeq) ? 1 : 0,
+	       (unsigned)pSeq->totalMs);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetThermal(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_thermal_t *pThermal = pCli->pThermal;
+
+	if (pThermal == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no thermal governor");
+	}
+	PRINTF("OK ma=%u code=%u level=%u ceiling=%u zone=%u lowest=%u warnings=%u down=%u up=%u errors=%u\r\n",
+	       (unsigned)PCA9420_THERMAL_GetMa(pThermal), (unsigned)pThermal->code, (unsigned)pThermal->level,
+	       (unsigned)pThermal->ceiling, (unsigned)pThermal->zone, (unsigned)pThermal->lowestCode,
+	       (unsigned)pThermal->warnings, (unsigned)pThermal->stepsDown, (unsigned)pThermal->stepsUp,
+	       (unsigned)pThermal->busErrors);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetJeita(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_jeita_t *pJeita = pCli->pJeita;
+	uint32_t zone;
+
+	if (pJeita == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no charging profile");
+	}
+	PRINTF("OK zone=%u changes=%u errors=%u writes=%u changed=%u zones_ms=", (unsigned)pJeita->zone,
+	       (unsigned)pJeita->changes, (unsigned)pJeita->busErrors, (unsigned)pJeita->last.writes,
+	       (unsigned)pJeita->last.changed);
+	for (zone = 0u; zone < PCA9420_JEITA_ZONES; zone++)
+	{
+		PRINTF("%s%u", (zone == 0u) ? "" : ",", (unsigned)PCA9420_JEITA_GetZoneMs(pJeita, (uint8_t)zone));
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetIlim(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_ilim_t *pIlim = pCli->pIlim;
+
+	if (pIlim == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no input current limit manager");
+	}
+	PRINTF("OK ma=%u vin=%u in_limit=%u limit_ms=%u,%u events=%u fallbacks=%u retries=%u wait_ms=%u errors=%u\r\n",
+	       (unsigned)PCA9420_ILIM_GetMa(pIlim), (unsigned)pIlim->vinStatus, pIlim->inLimit ? 1u : 0u,
+	       (unsigned)PCA9420_ILIM_GetLimitMs(pIlim, kPCA9420_VinIlim_74_85_98),
+	       (unsigned)PCA9420_ILIM_GetLimitMs(pIlim, kPCA9420_VinIlim_370_425_489), (unsigned)pIlim->limitEvents,
+	       (unsigned)pIlim->fallbacks, (unsigned)pIlim->retries, (unsigned)pIlim->waitMs, (unsigned)pIlim->busErrors);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetCharger(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+#if (!PCA9421UK_EVM_EN)
+	pca9420_charger_config_t config;
+	uint32_t i;
+	int32_t status;
+
+	status = PCA9420_CHARGER_Get(pCli->pSensorHandle, &config);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK");
+	for (i = 0u; i < ARRAY_SIZE(s_chargerFields); i++)
+	{
+		PRINTF(" %s=%u", s_chargerFields[i].pName, (unsigned)((const uint8_t *)&config)[s_chargerFields[i].offset]);
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+#else
+	return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no charger on PCA9421");
+#endif
+}
+
+/* set charger <field> <value> [<field> <value>], read once and written back in one burst. */
+static int32_t PCA9420_CLI_SetCharger(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+#if (!PCA9421UK_EVM_EN)
+	pca9420_charger_config_t config;
+	uint32_t arg, i, value;
+	int32_t status;
+
+	if ((argc != 4u) && (argc != 6u))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set charger <field> <value> [<field> <value>]");
+	}
+	status = PCA9420_CHARGER_Get(pCli->pSensorHandle, &config);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	for (arg = 2u; arg < argc; arg += 2u)
+	{
+		for (i = 0u; (i < ARRAY_SIZE(s_chargerFields)) && (strcmp(argv[arg], s_chargerFields[i].pName) != 0); i++)
+		{
+		}
+		if (i == ARRAY_SIZE(s_chargerFields))
+		{
+			return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "unknown field");
+		}
+		if (!PCA9420_CLI_ParseNumber(argv[arg + 1u], 0xFFu, &value))
+		{
+			return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "bad value");
+		}
+		((uint8_t *)&config)[s_chargerFields[i].offset] = (uint8_t)value;
+	}
+	status = PCA9420_CHARGER_Apply(pCli->pSensorHandle, &config);
+	if (SENSOR_ERROR_INVALID_PARAM == status)
+	{
+		return PCA9420_CLI_Error(status, "value out of range");
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_Error(status, (status == SENSOR_ERROR_WRITE) ? "verify failed" : "read failed");
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+#else
+	return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no charger on PCA9421");
+#endif
+}
+
+static int32_t PCA9420_CLI_GetBrownout(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_brownout_t *pBrownout = pCli->pBrownout;
+
+	if (pBrownout == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no brown-out response");
+	}
+	PRINTF("OK armed=%u shed=0x%02X:0x%02X edges=%u sheds=%u late=%u reshed=%u last_us=%u max_us=%u budget_us=%u "
+	       "over=%u errors=%u\r\n",
+	       pBrownout->armed ? 1u : 0u, (unsigned)pBrownout->shedAddress, (unsigned)pBrownout->shedValue,
+	       (unsigned)pBrownout->edges, (unsigned)pBrownout->sheds, (unsigned)pBrownout->lateSheds,
+	       (unsigned)pBrownout->reSheds, (unsigned)pBrownout->lastUs, (unsigned)pBrownout->maxUs,
+	       (unsigned)pBrownout->config.budgetUs, (unsigned)pBrownout->overBudget, (unsigned)pBrownout->busErrors);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetBrownout(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	int32_t status;
+
+	if (pCli->pBrownout == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no brown-out response");
+	}
+	if ((argc != 3u) || (strcmp(argv[2], "restore") != 0))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set brownout restore");
+	}
+
+	status = PCA9420_BROWNOUT_Restore(pCli->pBrownout);
+	if (SENSOR_ERROR_INVALID_PARAM == status)
+	{
+		return PCA9420_CLI_Error(status, "not shed");
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetVerify(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	uint32_t address, count = 0u;
+
+	if (pCli->pVerify == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no read-back reference");
+	}
+	for (address = 0u; address < PCA9420_CFG_REG_COUNT; address++)
+	{
+		if (PCA9420_CFG_VERIFY_DRIFTING(pCli->pVerify, address))
+		{
+			count++;
+		}
+	}
+	PRINTF("OK drifting=%u", (unsigned)count);
+	for (address = 0u; address < PCA9420_CFG_REG_COUNT; address++)
+	{
+		if (PCA9420_CFG_VERIFY_DRIFTING(pCli->pVerify, address))
+		{
+			PRINTF(" 0x%02X=0x%02X", (unsigned)address, (unsigned)pCli->pVerify->expected.regs[address]);
+		}
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetVerify(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	int32_t status;
+
+	if (pCli->pVerify == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no read-back reference");
+	}
+	if ((argc != 3u) || (strcmp(argv[2], "ack") != 0))
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set verify ack");
+	}
+
+	status = PCA9420_CFG_VerifyAcknowledge(pCli->pSensorHandle, pCli->pVerify);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetSession(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	pca9420_chgprof_t *pProf = pCli->pChgProf;
+	const pca9420_chgprof_session_t *pSession;
+	uint32_t timeToFull;
+	uint32_t phase;
+	int32_t status;
+
+	if (pProf == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "no charge session profiler");
+	}
+	status = PCA9420_CHGPROF_Update(pProf);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	pSession = pProf->active ? &pProf->session : &pProf->last;
+	timeToFull = PCA9420_CHGPROF_GetTimeToFullMs(pProf);
+	PRINTF("OK active=%u phase=%u ma=%u ttf_s=", pProf->active ? 1u : 0u, (unsigned)pProf->phase, (unsigned)pProf->ma);
+	if (timeToFull == PCA9420_CHGPROF_NONE)
+	{
+		PRINTF("none");
+	}
+	else
+	{
+		PRINTF("%u", (unsigned)(timeToFull / 1000u));
+	}
+	PRINTF(" sessions=%u done=%u stopped=%u safety_stops=%u errors=%u session_s=%u end=%u safety=%u cc_mah=%u phase_s=",
+	       (unsigned)pProf->sessions, (unsigned)pProf->completed, (unsigned)pProf->stopped,
+	       (unsigned)pProf->safetyStops, (unsigned)pProf->busErrors, (unsigned)(pSession->durationMs / 1000u),
+	       (unsigned)pSession->end, (unsigned)pSession->safety, (unsigned)(pSession->ccCharge / 3600u));
+	for (phase = 0u; phase < PCA9420_CHGPROF_PHASES; phase++)
+	{
+		PRINTF("%s%u", (phase == 0u) ? "" : ",", (unsigned)(pSession->phaseMs[phase] / 1000u));
+	}
+	PRINTF("\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_GetRail(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_cli_rail_t *pRail = (argc > 1u) ? PCA9420_CLI_FindRail(argv[1]) : NULL;
+	uint8_t cfg[PCA9420_CLI_MODECFG_LEN];
+	enum _pca9420_mode mode;
+	uint8_t code;
+	int32_t status;
+
+	if (pRail == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "unknown command");
+	}
+	status = PCA9420_CLI_ModeArg(pCli, argc, argv, 2u, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	/* The four configuration registers of the mode in one transfer. */
+	status = PCA9420_DRV_BlockRead(pCli->pSensorHandle, PCA9420UK_MODECFG_0_0 + mode * PCA9420_CLI_MODECFG_LEN, cfg, sizeof(cfg));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	code = (cfg[pRail->cfgIndex] & pRail->voltMask) >> pRail->voltShift;
+	PRINTF("OK mode=%d mv=%u en=%d\r\n", (int)mode, (unsigned)PCA9420_Decode_regulator_mv(pRail->regulator, code),
+	       (cfg[2] & pRail->enMask) ? 1 : 0);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_SetRail(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_cli_rail_t *pRail = (argc > 1u) ? PCA9420_CLI_FindRail(argv[1]) : NULL;
+	enum _pca9420_mode mode;
+	int32_t milliVolt;
+	uint8_t code;
+	int32_t status;
+
+	if (pRail == NULL)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "unknown command");
+	}
+	if (argc != 4u)
+	{
+		return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "usage: set <rail> <mode> <voltage|on|off>");
+	}
+	status = PCA9420_CLI_ModeArg(pCli, argc, argv, 2u, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	if ((strcmp(argv[3], "on") == 0) || (strcmp(argv[3], "off") == 0))
+	{
+		status = PCA9420_vol_reg_enable_disable(pCli->pSensorHandle, mode, pRail->source, (argv[3][1] == 'n') ? 1 : 0);
+	}
+	else
+	{
+		if (!FIXPT_ParseMilli(argv[3], &milliVolt) || (milliVolt <= 0) ||
+		    (SENSOR_ERROR_NONE != PCA9420_Encode_regulator_mv(pRail->regulator, (uint32_t)milliVolt, &code)))
+		{
+			return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "bad voltage");
+		}
+
+		switch (pRail->regulator)
+		{
+		case kPCA9420_RegulatorSwitch1:
+			status = PCA9420_Set_sw1_out_vol(pCli->pSensorHandle, mode, (enum _pca9420_sw1_out)code);
+			break;
+		case kPCA9420_RegulatorSwitch2:
+			status = PCA9420_Set_sw2_out_vol(pCli->pSensorHandle, mode, (enum _pca9420_sw2_out)code);
+			break;
+		case kPCA9420_RegulatorLdo1:
+			status = PCA9420_Set_ldo1_out_vol(pCli->pSensorHandle, mode, (enum _pca9420_ldo1_out)code);
+			break;
+		default:
+			status = PCA9420_Set_ldo2_out_vol(pCli->pSensorHandle, mode, (enum _pca9420_ldo2_out)code);
+			break;
+		}
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return PCA9420_CLI_DriverError(status);
+	}
+	PRINTF("OK\r\n");
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t PCA9420_CLI_Dispatch(pca9420_cli_t *pCli, uint32_t argc, char *argv[])
+{
+	const pca9420_cli_command_t *pCommand;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(s_commands) / sizeof(s_commands[0]); i++)
+	{
+		pCommand = &s_commands[i];
+		if (strcmp(argv[0], pCommand->pVerb) != 0)
+		{
+			continue;
+		}
+		if ((pCommand->pObject == NULL) || ((argc > 1u) && (strcmp(argv[1], pCommand->pObject) == 0)))
+		{
+			return pCommand->handler(pCli, argc, argv);
+		}
+	}
+
+	return PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "unknown command");
+}
+
+void PCA9420_CLI_Init(pca9420_cli_t *pCli, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_wdog_keeper_t *pWdog,
+                      pca9420_telemetry_t *pTelemetry, pca9420_dvfs_t *pDvfs, pca9420_lp_t *pLowPower,
+                      pca9420_energy_t *pEnergy, pca9420_seq_t *pSequence, pca9420_thermal_t *pThermal,
+                      pca9420_jeita_t *pJeita, pca9420_ilim_t *pIlim, pca9420_chgprof_t *pChgProf,
+                      pca9420_brownout_t *pBrownout, pca9420_cfg_verify_t *pVerify)
+{
+	pCli->pSensorHandle = pSensorHandle;
+	pCli->pWdog = pWdog;
+	pCli->pTelemetry = pTelemetry;
+	pCli->pDvfs = pDvfs;
+	pCli->pLowPower = pLowPower;
+	pCli->pEnergy = pEnergy;
+	pCli->pSequence = pSequence;
+	pCli->pThermal = pThermal;
+	pCli->pJeita = pJeita;
+	pCli->pIlim = pIlim;
+	pCli->pChgProf = pChgProf;
+	pCli->pBrownout = pBrownout;
+	pCli->pVerify = pVerify;
+	pCli->exitRequested = false;
+}
+
+int32_t PCA9420_CLI_Execute(pca9420_cli_t *pCli, char *pLine)
+{
+	char *argv[PCA9420_CLI_MAX_ARGS];
+	uint32_t argc = 0;
+	int32_t status, result = SENSOR_ERROR_NONE;
+	char *p;
+
+	if ((pCli == NULL) || (pLine == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	for (p = pLine;; p++)
+	{
+		if ((*p >= 'A') && (*p <= 'Z'))
+		{
+			*p = (char)(*p - 'A' + 'a');
+		}
+
+		if ((*p == ' ') || (*p == '\t') || (*p == ';') || (*p == '\r') || (*p == '\n') || (*p == '\0'))
+		{
+			bool endOfCommand = (*p != ' ') && (*p != '\t');
+			bool endOfLine = (*p == '\0');
+
+			/* Terminate the word in place, a word starts right after the previous separator. */
+			*p = '\0';
+			if (endOfCommand && (argc > 0u))
+			{
+				status = PCA9420_CLI_Dispatch(pCli, argc, argv);
+				if (SENSOR_ERROR_NONE != status)
+				{
+					result = status;
+				}
+				argc = 0;
+			}
+			if (endOfLine)
+			{
+				break;
+			}
+		}
+		else if ((p == pLine) || (p[-1] == '\0'))
+		{
+			if (argc == PCA9420_CLI_MAX_ARGS)
+			{
+				/* Swallow the rest of the command, it answers with one error. */
+				result = PCA9420_CLI_Error(SENSOR_ERROR_INVALID_PARAM, "too many words");
+				while ((p[1] != ';') && (p[1] != '\0'))
+				{
+					p++;
+				}
+				argc = 0;
+				continue;
+			}
+			argv[argc++] = p;
+		}
+	}
+
+	/* The commands just talked to the PMIC, let a due watchdog kick ride along. */
+	if (pCli->pWdog != NULL)
+	{
+		(void)PCA9420_WDOG_Coalesce(pCli->pWdog);
+	}
+
+	return result;
+}
+
+void PCA9420_CLI_Run(pca9420_cli_t *pCli)
+{
+	char line[PCA9420_CLI_LINE_LEN + 1];
+
+	pCli->exitRequested = false;
+	PRINTF("\r\nType help for the command list, exit to return.\r\n");
+	while (!pCli->exitRequested)
+	{
+		SW_TIMER_Process();
+		PRINTF("> ");
+		if (DbgConsole_ReadLine((uint8_t *)line, PCA9420_CLI_LINE_LEN) < 0)
+		{
+			break;
+		}
+		(void)PCA9420_CLI_Execute(pCli, line);
+	}
+}
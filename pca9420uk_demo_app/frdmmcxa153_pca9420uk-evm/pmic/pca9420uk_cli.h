@@ -0,0 +1,174 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_cli.h
+ * @brief The pca9420uk_cli.h file describes the PCA9420UK line-oriented command interpreter.
+
+    A line holds one or more commands separated by ';'. Every command answers with exactly
+    one line, "OK" followed by its results as key=value pairs, or "ERR <status> <reason>"
+    where status is the sensor_drv.h error code. Commands of a line run in order, a failing
+    command does not stop the ones after it.
+
+        help
+        get mode                          set mode <0..3>
+        get <sw1|sw2|ldo1|ldo2> [mode]    set <sw1|sw2|ldo1|ldo2> <mode> <voltage|on|off>
+        get wdog [mode]                   set wdog <mode> <0|16|32|64>
+        get reg <addr>                    set reg <addr> <value>
+        get chg                           dump regs
+        get charger                       set charger <field> <value> [<field> <value>]
+        get stream                        set stream <hz> [fields] [keyframe_ms]
+        get dvfs                          set dvfs <point>
+        get lp                            lp <enter|exit>
+        get energy                        set load <sw1|sw2|ldo1|ldo2> <mcu state> <ua>
+        get seq                           seq <name>
+        get thermal                       get jeita
+        get ilim                          get session
+        get brownout                      set brownout restore
+        get verify                        set verify ack
+        profile list                      profile <save|apply|diff|delete> <name>
+        exit
+
+    A mode is given as "2" or "mode2" and defaults to the active mode. Voltages take the
+    forms "0.925", "0.925V" and "925mV". Numbers are decimal or 0x prefixed hexadecimal.
+    "get charger" lists the fields of CHG_CNTL0..7 by name as raw codes, "set charger"
+    changes one or two of them and writes the whole block back in one burst, see
+    pca9420uk_charger.h.
+    "set stream" starts telemetry frames at the given rate, 0 stops them; fields is a
+    mask of PCA9420_TLM_FIELD_ bits and defaults to all. Between keyframes only changes
+    are sent, keyframe_ms 0 sends every sample in full.
+    "profile save" stores the live PMIC configuration under a name, persistent=1 only when
+    it survives a power cycle, see pca9420uk_profile.h. "profile apply" writes
+    back only the registers that differ and reports the I2C reads, writes and registers
+    changed, "profile diff" lists the registers that differ as addr=stored/live.
+    "set dvfs" takes an operating point by name or index and reports how long the voltage
+    and the clock part of the transition took, ramp_us is the SW1 ramp wait in the voltage part.
+    "lp enter" and "lp exit" run the low-power sequence and report its latency and I2C
+    transfers, "get lp" adds the time at which each step completed. A failed entry is
+    rolled back before the error is reported. The core stays at the lowest DVFS point
+    while entered, "set dvfs" is refused until "lp exit".
+    "get energy" reports per PMIC mode the milliseconds spent in each MCU power state and
+    the microjoules delivered by each rail, "set load" changes the load model behind them.
+    "seq" starts a rail sequence by name or index and answers at once, the sequence goes
+    on in the background. "get seq" reports the last one with the time each step completed.
+    "get thermal" reports the charge current the thermal governor allows, its TS zone
+    ceiling and how often it stepped down and up. "get jeita" reports the temperature zone
+    whose charging profile is in force and the milliseconds spent in each zone. "get ilim"
+    reports the VIN current limit in force, the milliseconds spent in current limit at each
+    setting and how often the limit fell back and was tried again. "get session" reports the
+    charger phase, the estimated seconds to full, the session counts and the running session,
+    or the last one when not charging, with the seconds spent in each phase. "get brownout"
+    reports the prepared shed command as register:value, how often the loads were shed and
+    the microseconds from the INT pin edge to the shed, "set brownout restore" switches the
+    shed rails back on, see pca9420uk_brownout.h. "get verify" lists as addr=expected the registers that
+    differed from the read-back reference at the last check, "set verify ack" takes their
+    live values as the reference, see pca9420uk_config.h.
+*/
+
+#ifndef PCA9420UK_CLI_H_
+#define PCA9420UK_CLI_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+#include "pca9420uk_wdog.h"
+#include "pca9420uk_telemetry.h"
+#include "pca9420uk_dvfs.h"
+#include "pca9420uk_lowpower.h"
+#include "pca9420uk_energy.h"
+#include "pca9420uk_sequence.h"
+#include "pca9420uk_thermal.h"
+#include "pca9420uk_jeita.h"
+#include "pca9420uk_ilim.h"
+#include "pca9420uk_chgprof.h"
+#include "pca9420uk_charger.h"
+#include "pca9420uk_brownout.h"
+#include "pca9420uk_config.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Longest accepted command line. */
+#define PCA9420_CLI_LINE_LEN (128u)
+
+/*! @brief Most words in one command. */
+#define PCA9420_CLI_MAX_ARGS (6u)
+
+/*!
+ * @brief Command interpreter context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+	pca9420_wdog_keeper_t *pWdog;              /*!< Watchdog keeper refreshed after mode and watchdog changes, may be NULL. */
+	pca9420_telemetry_t *pTelemetry;           /*!< Telemetry service of the stream commands, may be NULL. */
+	pca9420_dvfs_t *pDvfs;                     /*!< DVFS engine of the dvfs commands, may be NULL. */
+	pca9420_lp_t *pLowPower;                   /*!< Low-power sequence of the lp commands, may be NULL. */
+	pca9420_energy_t *pEnergy;                 /*!< Energy model of the energy and load commands, may be NULL. */
+	pca9420_seq_t *pSequence;                  /*!< Rail sequences of the seq commands, may be NULL. */
+	pca9420_thermal_t *pThermal;               /*!< Thermal governor of the thermal command, may be NULL. */
+	pca9420_jeita_t *pJeita;                   /*!< Charging profile engine of the jeita command, may be NULL. */
+	pca9420_ilim_t *pIlim;                     /*!< Input current limit manager of the ilim command, may be NULL. */
+	pca9420_chgprof_t *pChgProf;               /*!< Charge session profiler of the session command, may be NULL. */
+	pca9420_brownout_t *pBrownout;             /*!< Brown-out response of the brownout commands, may be NULL. */
+	pca9420_cfg_verify_t *pVerify;             /*!< Read-back reference of the verify commands, may be NULL. */
+	bool exitRequested;                        /*!< Set by the exit command. */
+} pca9420_cli_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to initialize the command interpreter.
+ *  @param[in]   pCli           handle to the interpreter context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pWdog          watchdog keeper of the PMIC, may be NULL.
+ *  @param[in]   pTelemetry     telemetry service, may be NULL.
+ *  @param[in]   pDvfs          DVFS engine, may be NULL.
+ *  @param[in]   pLowPower      low-power sequence, may be NULL.
+ *  @param[in]   pEnergy        energy model, may be NULL.
+ *  @param[in]   pSequence      rail sequence executor, may be NULL.
+ *  @param[in]   pThermal       charge current thermal governor, may be NULL.
+ *  @param[in]   pJeita         temperature zoned charging profile engine, may be NULL.
+ *  @param[in]   pIlim          VIN input current limit manager, may be NULL.
+ *  @param[in]   pChgProf       charge session profiler, may be NULL.
+ *  @param[in]   pBrownout      brown-out response, may be NULL. Its shed command follows the writes of the
+ *                              commands through PCA9420_BROWNOUT_NoteWrite() in the driver write listener.
+ *  @param[in]   pVerify        read-back reference, may be NULL.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize().
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_CLI_Init(pca9420_cli_t *pCli, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_wdog_keeper_t *pWdog,
+                      pca9420_telemetry_t *pTelemetry, pca9420_dvfs_t *pDvfs, pca9420_lp_t *pLowPower,
+                      pca9420_energy_t *pEnergy, pca9420_seq_t *pSequence, pca9420_thermal_t *pThermal,
+                      pca9420_jeita_t *pJeita, pca9420_ilim_t *pIlim, pca9420_chgprof_t *pChgProf,
+                      pca9420_brownout_t *pBrownout, pca9420_cfg_verify_t *pVerify);
+
+/*! @brief       The interface function to execute a command line.
+ *  @details     This function runs every command of the line and prints one response line per command.
+ *  @param[in]   pCli           handle to the interpreter context.
+ *  @param[in]   pLine          command line, modified in place.
+ *  @constraints Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CLI_Execute() returns the status of the last failing command, SENSOR_ERROR_NONE if all passed.
+ */
+int32_t PCA9420_CLI_Execute(pca9420_cli_t *pCli, char *pLine);
+
+/*! @brief       The interface function to run the interactive command loop.
+ *  @details     This function reads lines with DbgConsole_ReadLine() and executes them until the exit command.
+ *               Expired software timers run between lines.
+ *  @param[in]   pCli           handle to the interpreter context.
+ *  @constraints The debug console must be initialized.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_CLI_Run(pca9420_cli_t *pCli);
+
+#endif /* PCA9420UK_CLI_H_ */
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_config.h
+ * @brief The pca9420uk_config.h file describes the PCA9420UK register image configuration.
+
+    A configuration is a raw image of the PMIC control registers, indexed by register
+    address, together with the set of regions it holds. Applying it takes one burst write
+    per region instead of one read-modify-write per field, which is what lets the boot path
+    bring the rails to their final setting before the console and the menus are up.
+
+    Regions are written interrupt masks first and TOP_CNTL last, so the mode bank selected
+    by TOP_CNTL3 is already programmed when the PMIC switches to it. A mode switch is
+    recorded in the event log, as PCA9420_Set_mode_control() does.
+
+    PCA9420_CFG_Reconcile() is the incremental form of apply: it reads the live registers
+    once, or takes them from a cache, and writes only the runs of registers whose cared-for
+    bits differ. Applying a configuration the PMIC already holds costs a single burst read.
+
+    PCA9420_CFG_Verify() checks that the PMIC still holds a configuration: one burst read per
+    region and a CRC16 over the controlled bits, compared with the CRC taken when the
+    reference was set up. Only a mismatch costs a register by register comparison. The
+    application's own writes are not drift: PCA9420_CFG_VerifyNoteWrite(), called from the
+    driver write listener, marks them and the next check takes their live value into the
+    reference. Anything else that differs is reported on every check until the register
+    reads as expected again or PCA9420_CFG_VerifyAcknowledge() adopts the live state.
+*/
+
+#ifndef PCA9420UK_CONFIG_H_
+#define PCA9420UK_CONFIG_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Register regions of a configuration. */
+#define PCA9420_CFG_REGION_INT_MASK (0x01u) /*!< SUB_INT0_MASK..SUB_INT2_MASK. */
+#define PCA9420_CFG_REGION_TOP      (0x02u) /*!< TOP_CNTL0..3. */
+#define PCA9420_CFG_REGION_CHARGER  (0x04u) /*!< CHG_CNTL0..7, not on PCA9421. */
+#define PCA9420_CFG_REGION_MODECFG  (0x08u) /*!< MODECFG_0_0..MODECFG_3_3. */
+#define PCA9420_CFG_REGION_DISCHARGE (0x10u) /*!< ACT_DIS_CNTL_1. */
+#define PCA9420_CFG_REGION_ALL      (0x1Fu)
+
+/*! @brief Size of the register image, up to the last mode configuration register. */
+#define PCA9420_CFG_REG_COUNT (PCA9420UK_MODECFG_3_3 + 1)
+
+/*!
+ * @brief PMIC configuration.
+ */
+typedef struct
+{
+	uint8_t regions;                     /*!< PCA9420_CFG_REGION_ bits held by regs. */
+	uint8_t regs[PCA9420_CFG_REG_COUNT]; /*!< Register values by address, bytes outside the regions are ignored. */
+} pca9420_config_t;
+
+/*! @brief Largest run of unchanged registers PCA9420_CFG_Reconcile() writes over to join two
+ *         bursts, about the cost of the device address, register address and restart of a new one. */
+#ifndef PCA9420_CFG_MERGE_GAP
+#define PCA9420_CFG_MERGE_GAP (2u)
+#endif
+
+/*!
+ * @brief Outcome of PCA9420_CFG_Reconcile().
+ */
+typedef struct
+{
+	uint8_t reads;                                          /*!< Burst reads issued, 0 or 1. */
+	uint8_t writes;                                         /*!< Burst writes issued. */
+	uint8_t changed;                                        /*!< Registers whose value changed. */
+	uint8_t changedMap[(PCA9420_CFG_REG_COUNT + 7) / 8];    /*!< Bit per register address, set when it changed. */
+} pca9420_cfg_result_t;
+
+/*! @brief Tells whether PCA9420_CFG_Reconcile() changed a register. */
+#define PCA9420_CFG_CHANGED(pResult, address) \
+	(((pResult)->changedMap[(address) >> 3] & (1u << ((address) & 7u))) != 0u)
+
+/*! @brief Called by PCA9420_CFG_Diff() per register that differs. */
+typedef void (*pca9420_cfg_diff_visit_t)(uint8_t address, uint8_t expected, uint8_t actual, void *pUserData);
+
+/*!
+ * @brief Reference of PCA9420_CFG_Verify().
+ */
+typedef struct
+{
+	pca9420_config_t expected;          /*!< Expected image, bits outside the care mask cleared. */
+	uint8_t care[PCA9420_CFG_REG_COUNT]; /*!< Bits checked per register address. */
+	uint16_t crc;                       /*!< CRC16 of the checked bits. */
+	volatile uint8_t writtenMap[(PCA9420_CFG_REG_COUNT + 7) / 8]; /*!< Bit per register the application wrote since the last check. */
+	uint8_t driftMap[(PCA9420_CFG_REG_COUNT + 7) / 8];            /*!< Bit per register that differed at the last check. */
+} pca9420_cfg_verify_t;
+
+/*! @brief True when address differed from the reference at the last PCA9420_CFG_Verify(). */
+#define PCA9420_CFG_VERIFY_DRIFTING(pVerify, address) \
+	(((pVerify)->driftMap[(address) >> 3] & (1u << ((address) & 7u))) != 0u)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to read the live configuration.
+ *  @details     This function reads each selected region in one burst. Interrupt flags that share the
+ *               mask region are stored as 0.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[out]  pConfig        configuration read.
+ *  @param[in]   regions        PCA9420_CFG_REGION_ bits to read.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CFG_Capture() returns the status.
+ */
+int32_t PCA9420_CFG_Capture(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_config_t *pConfig, uint8_t regions);
+
+/*! @brief       The interface function to program a configuration.
+ *  @details     This function writes each region held by the configuration in one burst. The interrupt
+ *               flags inside the mask region are written as 0, which leaves them untouched. The charger
+ *               region is written with the CHG_CNTL0 unlock key, the charger registers ignore writes
+ *               without it.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pConfig        configuration to program.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize(). A TOP_CNTL3 value holding the
+ *               software reset code is refused.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CFG_Apply() returns the status.
+ */
+int32_t PCA9420_CFG_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_config_t *pConfig);
+
+/*! @brief       The interface function to program a configuration with as few writes as possible.
+ *  @details     This function reads every region of pTarget not held by pCache in one burst, merges the
+ *               cared-for bits of pTarget into the live values and writes the registers that differ as
+ *               contiguous bursts, joining runs less than PCA9420_CFG_MERGE_GAP registers apart. The
+ *               interrupt flags and the CHG_CNTL0 unlock key are never compared, a charger burst always
+ *               starts at CHG_CNTL0 to carry the key.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pTarget        configuration to reach.
+ *  @param[in]   pCareMask      bits to take from pTarget per register address, NULL for all bits.
+ *  @param[inout] pCache        live registers, trusted for the regions it holds and updated with what was read
+ *                              and written, NULL to always read.
+ *  @param[out]  pResult        what was read, written and changed, may be NULL.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize(). A cache is only valid as long as
+ *               nothing else writes the PMIC. A TOP_CNTL3 value holding the software reset code is refused.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CFG_Reconcile() returns the status.
+ */
+int32_t PCA9420_CFG_Reconcile(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_config_t *pTarget,
+                              const uint8_t *pCareMask, pca9420_config_t *pCache, pca9420_cfg_result_t *pResult);
+
+/*! @brief       The interface function to compare two configurations.
+ *  @details     This function compares the regions held by both, the interrupt flags and the CHG_CNTL0
+ *               unlock key are left out.
+ *  @param[in]   pExpected      reference configuration.
+ *  @param[in]   pActual        configuration to check, typically from PCA9420_CFG_Capture().
+ *  @param[in]   visit          function called per differing register, may be NULL.
+ *  @param[in]   pUserData      argument of visit.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_CFG_Diff() returns the number of differing registers.
+ */
+uint32_t PCA9420_CFG_Diff(const pca9420_config_t *pExpected, const pca9420_config_t *pActual, pca9420_cfg_diff_visit_t visit,
+                          void *pUserData);
+
+/*! @brief       The interface function to find the region of a register.
+ *  @param[in]   address        register address.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_CFG_RegionOf() returns the PCA9420_CFG_REGION_ bit, 0 when no region holds the register.
+ */
+uint8_t PCA9420_CFG_RegionOf(uint8_t address);
+
+/*! @brief       The interface function to set up a verification reference.
+ *  @details     This function keeps the bits of pExpected selected by pCareMask, less the interrupt flags
+ *               and the CHG_CNTL0 unlock key, and their CRC.
+ *  @param[out]  pVerify        reference to set up.
+ *  @param[in]   pExpected      configuration the PMIC should hold, typically the one just applied.
+ *  @param[in]   pCareMask      bits to check per register address, NULL for all bits.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_CFG_VerifyInit() returns the status.
+ */
+int32_t PCA9420_CFG_VerifyInit(pca9420_cfg_verify_t *pVerify, const pca9420_config_t *pExpected, const uint8_t *pCareMask);
+
+/*! @brief       The interface function to mark registers the application wrote.
+ *  @details     This function only sets bits and does no bus access, it suits a pca9420_write_listener_t.
+ *  @param[in]   pVerify        reference from PCA9420_CFG_VerifyInit().
+ *  @param[in]   address        first register written.
+ *  @param[in]   length         number of registers written.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      No return value.
+ */
+void PCA9420_CFG_VerifyNoteWrite(pca9420_cfg_verify_t *pVerify, uint8_t address, uint8_t length);
+
+/*! @brief       The interface function to check that the PMIC holds the reference configuration.
+ *  @details     This function reads each region of the reference in one burst. The registers marked by
+ *               PCA9420_CFG_VerifyNoteWrite() take their live value into the reference first, then the CRC
+ *               of the checked bits is compared. On a mismatch it calls visit per differing register, with
+ *               the checked bits of the expected and the live value, on every check while it differs. A
+ *               register that differed at the previous check and now matches is visited once with actual
+ *               equal to expected. PCA9420_CFG_VERIFY_DRIFTING() still gives the previous state in visit.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pVerify        reference from PCA9420_CFG_VerifyInit().
+ *  @param[in]   visit          function called per differing or restored register, may be NULL.
+ *  @param[in]   pUserData      argument of visit.
+ *  @param[out]  pMismatches    number of differing registers, 0 when the PMIC holds the reference.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CFG_Verify() returns the status of the reads.
+ */
+int32_t PCA9420_CFG_Verify(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_cfg_verify_t *pVerify,
+                           pca9420_cfg_diff_visit_t visit, void *pUserData, uint32_t *pMismatches);
+
+/*! @brief       The interface function to accept the live state as the reference.
+ *  @details     This function reads the regions of the reference and keeps them with the same checked bits,
+ *               which ends the reports of every differing register.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pVerify        reference from PCA9420_CFG_VerifyInit().
+ *  @constraints This can be called only after PCA9420_I2C_Initialize().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CFG_VerifyAcknowledge() returns the status of the reads.
+ */
+int32_t PCA9420_CFG_VerifyAcknowledge(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_cfg_verify_t *pVerify);
+
+#endif /* PCA9420UK_CONFIG_H_ */
@@ -24,6 +24,11 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief Called after each successful register write with the first address and the count. Runs in the
+ *         context of the write, which is thread context: the watchdog kicks run from SW_TIMER_Process() on
+ *         the event loop, so the listener may itself use the blocking driver functions. */
+typedef void (*pca9420_write_listener_t)(uint8_t address, uint8_t length, void *pUserData);
+
 /*!
  * @brief This defines the sensor specific information for I2C.
  */
@@ -33,6 +38,8 @@ typedef struct
     ARM_DRIVER_I2C *pCommDrv;        /*!< Pointer to the i2c driver. */
     bool isInitialized;              /*!< whether sensor is intialized or not.*/
     uint16_t slaveAddress;           /*!< slave address.*/
+    pca9420_write_listener_t writeListener; /*!< Told of every register write, NULL for none. */
+    void *pWriteListenerData;               /*!< Argument of writeListener. */
 } pca9420_i2c_sensorhandle_t;
 
 /*******************************************************************************
@@ -52,6 +59,19 @@ typedef struct
  */
 int32_t PCA9420_I2C_Initialize(pca9420_i2c_sensorhandle_t *pSensorHandle, ARM_DRIVER_I2C *pBus, uint8_t index, uint16_t sAddress);
 
+/*! @brief       The interface function to follow the register writes of the application.
+ *  @details     This function sets the function called after every successful write through this driver,
+ *               so a reference of the PMIC state can track the changes the application makes itself.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   listener       function called per write, NULL to stop.
+ *  @param[in]   pUserData      argument of listener.
+ *  @constraints This can be called any number of times only after PCA9420_I2C_Initialize(). Registers must not
+ *               be written through this driver from an interrupt while a listener is set.
+ *  @reeentrant  No
+ *  @return      No return value.
+ */
+void PCA9420_DRV_SetWriteListener(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_write_listener_t listener, void *pUserData);
+
 /*! @brief       The interface function to read the PMIC registers.
  *  @details     This function is to read the PMIC register value.
  *  @param[in]   pSensorHandle  handle to the PMIC.
@@ -76,6 +96,32 @@ int32_t PCA9420_DRV_Read(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t RegA
  */
 int32_t PCA9420_DRV_Write(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t RegAddress, uint16_t Data);
 
+/*! @brief       The interface function to read consecutive PMIC registers.
+ *  @details     This function reads length registers starting at StartAddress in one I2C transfer.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   StartAddress   first register address to read.
+ *  @param[out]  pBuffer        memory location where the register values are stored, one byte per register.
+ *  @param[in]   length         number of registers to read.
+ *  @constraints This can be called any number of times only after PCA9420_I2C_Initialize().
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_DRV_BlockRead() returns the status .
+ */
+int32_t PCA9420_DRV_BlockRead(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t StartAddress, uint8_t *pBuffer, uint8_t length);
+
+/*! @brief       The interface function to write consecutive PMIC registers.
+ *  @details     This function writes length registers starting at StartAddress in one I2C transfer.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   StartAddress   first register address to write.
+ *  @param[in]   pBuffer        register values, one byte per register.
+ *  @param[in]   length         number of registers to write.
+ *  @constraints This can be called any number of times only after PCA9420_I2C_Initialize().
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_DRV_BlockWrite() returns the status .
+ */
+int32_t PCA9420_DRV_BlockWrite(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t StartAddress, const uint8_t *pBuffer, uint8_t length);
+
 //System Control APIs
 
 /*! @brief       The interface function to configure VIN input current limit.
@@ -396,6 +442,29 @@ int32_t PCA9420_Set_ldo1_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
  */
 int32_t PCA9420_Set_ldo2_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pca9420_mode epca9420_mode, enum _pca9420_ldo2_out epca9420_ldo2_out);
 
+/*! @brief       The interface function to convert a regulator voltage code into millivolts.
+ *  @details     This function decodes the output voltage field of a MODECFG register, including the
+ *               +1.2 V offset bit of SW2 and LDO2. It does not access the PMIC.
+ *  @param[in]   regulator      		regulator the code belongs to.
+ *  @param[in]   code      				voltage field value, the LDO1 field already shifted down.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_Decode_regulator_mv() returns the voltage in millivolts.
+ */
+uint32_t PCA9420_Decode_regulator_mv(pca9420_regulator_t regulator, uint8_t code);
+
+/*! @brief       The interface function to convert millivolts into a regulator voltage code.
+ *  @details     This function finds the voltage field value of a regulator for an exact voltage on its
+ *               25 mV grid. It does not access the PMIC.
+ *  @param[in]   regulator      		regulator to encode for.
+ *  @param[in]   milliVolt      		requested voltage.
+ *  @param[out]  pCode      			voltage field value, cast to the regulator's _out enumeration.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_Encode_regulator_mv() returns SENSOR_ERROR_INVALID_PARAM when the voltage is not supported.
+ */
+int32_t PCA9420_Encode_regulator_mv(pca9420_regulator_t regulator, uint32_t milliVolt, uint8_t *pCode);
+
 /*! @brief       The interface function to configure on pin mode setting.
  *  @details     This function is to configure on pin mode setting.
  *  @param[in]   pSensorHandle 				handle to the PMIC.
@@ -420,6 +489,18 @@ int32_t PCA9420_on_pin_mode_set(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
  */
 int32_t PCA9420_Set_wtchdg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pca9420_mode epca9420_mode, enum _pca9420_wd_timer epca9420_wd_timer);
 
+/*! @brief       The interface function to get watchdog timer setting.
+ *  @details     This function is to read the watchdog timer setting of a mode.
+ *  @param[in]   pSensorHandle 				handle to the PMIC.
+ *  @param[in]   epca9420_mode      		mode selected.
+ *  @param[out]  pBuffer      	            handle to the output buffer.
+ *  @constraints This can be called any number of times only after PCA9420_I2C_Initialize().
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_Get_wtchdg_timer() returns the status.
+ */
+int32_t PCA9420_Get_wtchdg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pca9420_mode epca9420_mode, enum _pca9420_wd_timer *pBuffer);
+
 /*! @brief       The interface function to configure the mode setting.
  *  @details     This function is to configure the mode setting either via I2C register or mode selection line.
  *  @param[in]   pSensorHandle 		handle to the PMIC.
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_energy.c
+ * @brief The pca9420uk_energy.c file implements the PCA9420UK energy accounting model.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_energy.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Registers per mode bank. */
+#define PCA9420_ENERGY_MODECFG_LEN (4u)
+
+typedef struct
+{
+	pca9420_regulator_t regulator; /* Regulator of the voltage code. */
+	uint8_t voltMask;              /* Voltage field in MODECFG_x_<rail>. */
+	uint8_t voltShift;
+	uint8_t enMask;                /* Enable bit in MODECFG_x_2. */
+} pca9420_energy_rail_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const pca9420_energy_rail_t s_rails[PCA9420_ENERGY_RAILS] = {
+	{kPCA9420_RegulatorSwitch1, PCA9420_MODECFG_0_SW1_OUT_MASK, 0u, PCA9420_SW1_EN_MASK},
+	{kPCA9420_RegulatorSwitch2, PCA9420_MODECFG_1_SW2_OUT_MASK, 0u, PCA9420_SW2_EN_MASK},
+	{kPCA9420_RegulatorLdo1, PCA9420_MODECFG_2_LDO1_OUT_MASK, PCA9420_MODECFG_2_LDO1_OUT_SHIFT, PCA9420_LDO1_EN_MASK},
+	{kPCA9420_RegulatorLdo2, PCA9420_MODECFG_3_LDO2_OUT_MASK, 0u, PCA9420_LDO2_EN_MASK},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Closes the running segment, one multiply per rail. */
+static void PCA9420_ENERGY_Close(pca9420_energy_t *pEnergy)
+{
+	uint32_t now = SW_TIMER_GetTicks();
+	uint32_t ticks = now - pEnergy->since;
+	uint32_t rail;
+
+	pEnergy->since = now;
+	pEnergy->transitions++;
+	pEnergy->residency[pEnergy->mode][pEnergy->mcuState] += ticks;
+	for (rail = 0u; rail < PCA9420_ENERGY_RAILS; rail++)
+	{
+		if ((pEnergy->railOn[pEnergy->mode] & (1u << rail)) != 0u)
+		{
+			pEnergy->energy[pEnergy->mode][rail] +=
+			    (uint64_t)ticks * pEnergy->railMv[pEnergy->mode][rail] * pEnergy->model.loadUa[rail][pEnergy->mcuState];
+		}
+	}
+}
+
+/* Follows the driver writes, the other record types are ignored. */
+static void PCA9420_ENERGY_Listener(uint8_t type, uint8_t arg, uint16_t value, void *pUserData)
+{
+	pca9420_energy_t *pEnergy = (pca9420_energy_t *)pUserData;
+	uint8_t mode = arg & 0x0Fu;
+	uint8_t rail;
+
+	switch (type)
+	{
+	case kPCA9420_EvlogModeSwitch:
+		PCA9420_ENERGY_SetMode(pEnergy, arg);
+		break;
+	case kPCA9420_EvlogVoltage:
+		for (rail = 0u; (rail < PCA9420_ENERGY_RAILS) && (s_rails[rail].regulator != (arg >> 4)); rail++)
+		{
+		}
+		if ((rail < PCA9420_ENERGY_RAILS) && (mode < PCA9420_ENERGY_MODES))
+		{
+			PCA9420_ENERGY_Close(pEnergy);
+			pEnergy->railMv[mode][rail] = value;
+		}
+		break;
+	case kPCA9420_EvlogRailEnable:
+		/* arg holds enum _pca9420_vol_reg_source, kPCA9420_SW1 is 1. */
+		rail = (uint8_t)((arg >> 4) - kPCA9420_SW1);
+		if ((rail < PCA9420_ENERGY_RAILS) && (mode < PCA9420_ENERGY_MODES))
+		{
+			PCA9420_ENERGY_Close(pEnergy);
+			pEnergy->railOn[mode] = (uint8_t)((value != 0u) ? (pEnergy->railOn[mode] | (1u << rail))
+			                                                : (pEnergy->railOn[mode] & ~(1u << rail)));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+int32_t PCA9420_ENERGY_Init(pca9420_energy_t *pEnergy, const pca9420_energy_model_t *pModel, uint8_t mcuState)
+{
+	if ((pEnergy == NULL) || (pModel == NULL) || (mcuState >= PCA9420_ENERGY_MCU_STATES))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pEnergy, 0, sizeof(*pEnergy));
+	pEnergy->model = *pModel;
+	pEnergy->mcuState = mcuState;
+	pEnergy->since = SW_TIMER_GetTicks();
+	PCA9420_EVLOG_SetListener(PCA9420_ENERGY_Listener, pEnergy);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_ENERGY_Refresh(pca9420_energy_t *pEnergy, pca9420_i2c_sensorhandle_t *pSensorHandle)
+{
+	pca9420_config_t live;
+	int32_t status;
+
+	if (pEnergy == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCA9420_CFG_Capture(pSensorHandle, &live, PCA9420_CFG_REGION_MODECFG | PCA9420_CFG_REGION_TOP);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		PCA9420_ENERGY_SetRails(pEnergy, &live);
+	}
+	return status;
+}
+
+void PCA9420_ENERGY_SetRails(pca9420_energy_t *pEnergy, const pca9420_config_t *pConfig)
+{
+	const uint8_t *pBank;
+	uint32_t mode, rail;
+
+	PCA9420_ENERGY_Close(pEnergy);
+	if ((pConfig->regions & PCA9420_CFG_REGION_MODECFG) != 0u)
+	{
+		for (mode = 0u; mode < PCA9420_ENERGY_MODES; mode++)
+		{
+			pBank = &pConfig->regs[PCA9420UK_MODECFG_0_0 + mode * PCA9420_ENERGY_MODECFG_LEN];
+			pEnergy->railOn[mode] = 0u;
+			for (rail = 0u; rail < PCA9420_ENERGY_RAILS; rail++)
+			{
+				pEnergy->railMv[mode][rail] = (uint16_t)PCA9420_Decode_regulator_mv(
+				    s_rails[rail].regulator, (uint8_t)((pBank[rail] & s_rails[rail].voltMask) >> s_rails[rail].voltShift));
+				if ((pBank[2] & s_rails[rail].enMask) != 0u)
+				{
+					pEnergy->railOn[mode] |= (uint8_t)(1u << rail);
+				}
+			}
+		}
+	}
+	if ((pConfig->regions & PCA9420_CFG_REGION_TOP) != 0u)
+	{
+		pEnergy->mode = (uint8_t)((pConfig->regs[PCA9420UK_TOP_CNTL3] & PCA9420_TOP_CNTL3_MODE_I2C_MASK) >>
+		                          PCA9420_TOP_CNTL3_MODE_I2C_SHIFT);
+	}
+}
+
+bool PCA9420_ENERGY_NoteWrite(pca9420_energy_t *pEnergy, uint8_t address, uint8_t length)
+{
+	uint32_t last = (uint32_t)address + length - 1u;
+	bool touched = (address <= PCA9420UK_TOP_CNTL3) && (last >= PCA9420UK_TOP_CNTL3);
+
+	touched = touched || ((address <= PCA9420UK_MODECFG_3_3) && (last >= PCA9420UK_MODECFG_0_0));
+	if ((length == 0u) || !touched)
+	{
+		return false;
+	}
+	PCA9420_ENERGY_Close(pEnergy);
+	return true;
+}
+
+void PCA9420_ENERGY_SetMode(pca9420_energy_t *pEnergy, uint8_t mode)
+{
+	if ((mode < PCA9420_ENERGY_MODES) && (mode != pEnergy->mode))
+	{
+		PCA9420_ENERGY_Close(pEnergy);
+		pEnergy->mode = mode;
+	}
+}
+
+void PCA9420_ENERGY_SetMcuState(pca9420_energy_t *pEnergy, uint8_t mcuState)
+{
+	if ((mcuState < PCA9420_ENERGY_MCU_STATES) && (mcuState != pEnergy->mcuState))
+	{
+		PCA9420_ENERGY_Close(pEnergy);
+		pEnergy->mcuState = mcuState;
+	}
+}
+
+int32_t PCA9420_ENERGY_SetLoad(pca9420_energy_t *pEnergy, uint8_t rail, uint8_t mcuState, uint32_t loadUa)
+{
+	if ((pEnergy == NULL) || (rail >= PCA9420_ENERGY_RAILS) || (mcuState >= PCA9420_ENERGY_MCU_STATES))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	PCA9420_ENERGY_Close(pEnergy);
+	pEnergy->model.loadUa[rail][mcuState] = loadUa;
+	return SENSOR_ERROR_NONE;
+}
+
+void PCA9420_ENERGY_Update(pca9420_energy_t *pEnergy)
+{
+	PCA9420_ENERGY_Close(pEnergy);
+}
+
+uint32_t PCA9420_ENERGY_GetUj(const pca9420_energy_t *pEnergy, uint8_t mode, uint8_t rail)
+{
+	/* mV * uA is nW, one tick 1/SW_TIMER_TICK_HZ s. */
+	return (uint32_t)(pEnergy->energy[mode][rail] / (SW_TIMER_TICK_HZ * 1000ull));
+}
+
+uint32_t PCA9420_ENERGY_GetResidencyMs(const pca9420_energy_t *pEnergy, uint8_t mode, uint8_t mcuState)
+{
+	return (uint32_t)((uint64_t)pEnergy->residency[mode][mcuState] * 1000u / SW_TIMER_TICK_HZ);
+}
+
+void PCA9420_ENERGY_Reset(pca9420_energy_t *pEnergy)
+{
+	pEnergy->since = SW_TIMER_GetTicks();
+	pEnergy->transitions = 0u;
+	memset(pEnergy->residency, 0, sizeof(pEnergy->residency));
+	memset(pEnergy->energy, 0, sizeof(pEnergy->energy));
+}
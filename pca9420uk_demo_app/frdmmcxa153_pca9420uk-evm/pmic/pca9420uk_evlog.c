@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_evlog.c
+ * @brief The pca9420uk_evlog.c file implements the PCA9420UK retained event log.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <stddef.h>
+#include <string.h>
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+#include "pca9420uk_evlog.h"
+#include "pca9420uk.h"
+#include "crc16.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if ((PCA9420_EVLOG_LEN & (PCA9420_EVLOG_LEN - 1u)) != 0u)
+#error "PCA9420_EVLOG_LEN must be a power of two."
+#endif
+
+#define PCA9420_EVLOG_HEADER_CRC_LEN (offsetof(pca9420_evlog_t, crc))
+#define PCA9420_EVLOG_RECORD_CRC_LEN (offsetof(pca9420_evlog_record_t, crc))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* .noinit is neither loaded nor zeroed by the startup code, see the Debug and Release linker scripts. */
+static pca9420_evlog_t s_evlog __attribute__((section(".noinit.pca9420_evlog"), aligned(4)));
+
+static pca9420_evlog_listener_t s_listener;
+static void *s_listenerData;
+
+/* RESET_MONITOR bits, lowest first. */
+static const char *const s_resetCauseNames[] = {
+	"power-on", "VSYS under-voltage", "thermal shutdown", "PMIC watchdog expired", "ON pin long press",
+};
+
+static const char *const s_typeNames[] = {
+	"?", "BOOT", "INT", "MODE", "VOLTAGE", "RAIL", "CHARGER", "I2C ERROR", "WDOG MISS", "CFG DRIFT", "ICHG", "TS ZONE",
+	"VIN ILIM", "CHG SESSION", "BROWNOUT",
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint16_t PCA9420_EVLOG_HeaderCrc(void)
+{
+	return CRC16_Compute((const uint8_t *)&s_evlog, PCA9420_EVLOG_HEADER_CRC_LEN);
+}
+
+bool PCA9420_EVLOG_Init(void)
+{
+	bool recovered;
+
+	recovered = (s_evlog.magic == PCA9420_EVLOG_MAGIC) && (s_evlog.crc == PCA9420_EVLOG_HeaderCrc());
+	if (!recovered)
+	{
+		/* Power-on, or the RAM did not hold: start over. */
+		memset(&s_evlog, 0, sizeof(s_evlog));
+		s_evlog.magic = PCA9420_EVLOG_MAGIC;
+	}
+	else
+	{
+		s_evlog.boot++;
+	}
+	s_evlog.crc = PCA9420_EVLOG_HeaderCrc();
+
+	return recovered;
+}
+
+void PCA9420_EVLOG_Record(uint8_t type, uint8_t arg, uint16_t value)
+{
+	pca9420_evlog_record_t *pRecord;
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	pRecord = &s_evlog.records[s_evlog.head & (PCA9420_EVLOG_LEN - 1u)];
+	pRecord->timestamp = SW_TIMER_GetTicks();
+	pRecord->boot = s_evlog.boot;
+	pRecord->type = type;
+	pRecord->arg = arg;
+	pRecord->value = value;
+	pRecord->crc = CRC16_Compute((const uint8_t *)pRecord, PCA9420_EVLOG_RECORD_CRC_LEN);
+
+	/* A reset between the two leaves a valid record that the header does not count yet, never the reverse. */
+	s_evlog.head++;
+	s_evlog.crc = PCA9420_EVLOG_HeaderCrc();
+	EnableGlobalIRQ(primask);
+
+	if (s_listener != NULL)
+	{
+		s_listener(type, arg, value, s_listenerData);
+	}
+}
+
+uint32_t PCA9420_EVLOG_Dump(pca9420_evlog_visit_t visit, void *pUserData)
+{
+	pca9420_evlog_record_t record;
+	uint32_t head, first, i;
+	uint32_t primask;
+	bool corrupt;
+
+	head = s_evlog.head;
+	first = (head > PCA9420_EVLOG_LEN) ? (head - PCA9420_EVLOG_LEN) : 0u;
+	for (i = first; i < head; i++)
+	{
+		/* Copy under masked interrupts, a record written from an ISR meanwhile is never seen half done. */
+		primask = DisableGlobalIRQ();
+		record = s_evlog.records[i & (PCA9420_EVLOG_LEN - 1u)];
+		EnableGlobalIRQ(primask);
+
+		corrupt = (record.crc != CRC16_Compute((const uint8_t *)&record, PCA9420_EVLOG_RECORD_CRC_LEN));
+		visit(&record, corrupt, pUserData);
+	}
+
+	return head - first;
+}
+
+uint16_t PCA9420_EVLOG_GetBoot(void)
+{
+	return s_evlog.boot;
+}
+
+static void PCA9420_EVLOG_PrintRecord(const pca9420_evlog_record_t *pRecord, bool corrupt, void *pUserData)
+{
+	uint16_t boot = *(const uint16_t *)pUserData;
+
+	if (corrupt)
+	{
+		PRINTF("  <corrupt record>\r\n");
+		return;
+	}
+
+	PRINTF("  boot-%u %6u.%03u %-9s arg=0x%02X value=%u\r\n", (unsigned)(uint16_t)(boot - pRecord->boot),
+	       (unsigned)(pRecord->timestamp / SW_TIMER_TICK_HZ), (unsigned)(pRecord->timestamp % SW_TIMER_TICK_HZ),
+	       s_typeNames[(pRecord->type < ARRAY_SIZE(s_typeNames)) ? pRecord->type : 0u], (unsigned)pRecord->arg,
+	       (unsigned)pRecord->value);
+}
+
+void PCA9420_EVLOG_Print(uint8_t resetMonitor, uint8_t subInt0)
+{
+	uint16_t boot = s_evlog.boot;
+	uint32_t count, bit;
+
+	/* RESET_MONITOR latches why the PMIC itself reset, nothing latched means only the MCU was reset. */
+	PRINTF("\r\nReset cause: RESET_MONITOR=0x%02X SUB_INT0=0x%02X", resetMonitor, subInt0);
+	for (bit = 0u; bit < ARRAY_SIZE(s_resetCauseNames); bit++)
+	{
+		if ((resetMonitor & (1u << bit)) != 0u)
+		{
+			PRINTF(" %s", s_resetCauseNames[bit]);
+		}
+	}
+	if ((resetMonitor & PCA9420_RESET_MONITOR_ALL_MASK) == 0u)
+	{
+		PRINTF(" MCU reset (pin, debugger or software)");
+	}
+	PRINTF("\r\n");
+
+	if (boot == 0u)
+	{
+		return;
+	}
+	PRINTF("Event log of the previous boots, boot-N is N boots back:\r\n");
+	count = PCA9420_EVLOG_Dump(PCA9420_EVLOG_PrintRecord, &boot);
+	PRINTF("%u record(s)\r\n", (unsigned)count);
+}
+
+void PCA9420_EVLOG_SetListener(pca9420_evlog_listener_t listener, void *pUserData)
+{
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	s_listener = listener;
+	s_listenerData = pUserData;
+	EnableGlobalIRQ(primask);
+}
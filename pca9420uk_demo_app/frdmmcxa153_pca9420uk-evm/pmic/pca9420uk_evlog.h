@@ -0,0 +1,157 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_evlog.h
+ * @brief The pca9420uk_evlog.h file describes the PCA9420UK retained event log.
+
+    A fixed-size ring of timestamped PMIC events kept in the .noinit RAM section, which the
+    startup code neither loads nor clears. The log survives MCU resets as long as the RAM
+    stays powered, so after a brown-out or a PMIC watchdog reset the events leading up to it
+    can be dumped at the next boot.
+
+    The header carries a magic word and a CRC of its own fields, every record a CRC of its
+    bytes. A log with a bad header is cleared, a record with a bad CRC is reported as
+    corrupt and skipped. Recording takes constant time with interrupts masked and may be
+    done from interrupt handlers.
+
+    A listener sees every record as it is written, which lets other modules follow mode and
+    rail changes without hooks of their own in the driver.
+*/
+
+#ifndef PCA9420UK_EVLOG_H_
+#define PCA9420UK_EVLOG_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of records, a power of two. */
+#ifndef PCA9420_EVLOG_LEN
+#define PCA9420_EVLOG_LEN (64u)
+#endif
+
+/*! @brief Header magic, also changes when the record layout does. */
+#define PCA9420_EVLOG_MAGIC (0x45564C31u)
+
+/*!
+ * @brief Event types, arg and value meaning per type.
+ */
+enum _pca9420_evlog_type
+{
+	kPCA9420_EvlogBoot = 1,      /*!< Boot, arg RESET_MONITOR, value SUB_INT0 as found at boot. */
+	kPCA9420_EvlogInterrupt,     /*!< PMIC interrupt, arg TOP_INT, value SUB_INT0 | SUB_INT1 << 8. */
+	kPCA9420_EvlogModeSwitch,    /*!< Mode written, arg the new mode. */
+	kPCA9420_EvlogVoltage,       /*!< Regulator voltage written, arg regulator << 4 | mode, value mV. */
+	kPCA9420_EvlogRailEnable,    /*!< Regulator enable written, arg source << 4 | mode, value 1 on, 0 off. */
+	kPCA9420_EvlogChargerPhase,  /*!< Charger phase changed, arg new phase, value previous phase. */
+	kPCA9420_EvlogI2cError,      /*!< I2C transfer failed, value the ARM_I2C_EVENT_ flags. */
+	kPCA9420_EvlogWdogMiss,      /*!< Watchdog kick after its deadline, value ms late. */
+	kPCA9420_EvlogConfigDrift,   /*!< Register read back differs, arg address, value expected << 8 | actual. */
+	kPCA9420_EvlogChargeCurrent, /*!< Charge current changed by a governor, arg reason, value the ICHG_CC code. */
+	kPCA9420_EvlogChargeZone,    /*!< Charging profile of a TS zone applied, arg new zone, value previous zone. */
+	kPCA9420_EvlogInputLimit,    /*!< VIN current limit changed, arg reason, value the limit in mA. */
+	kPCA9420_EvlogChargeSession, /*!< Charge session ended, arg enum _pca9420_chgprof_end, value minutes. */
+	kPCA9420_EvlogBrownout,      /*!< Brown-out response, arg enum _pca9420_brownout_record. */
+};
+
+/*!
+ * @brief One record.
+ */
+typedef struct
+{
+	uint32_t timestamp; /*!< Software timer ticks since the boot it was written in. */
+	uint16_t boot;      /*!< Boot count at the time of writing. */
+	uint8_t type;       /*!< enum _pca9420_evlog_type. */
+	uint8_t arg;        /*!< Type specific. */
+	uint16_t value;     /*!< Type specific. */
+	uint16_t crc;       /*!< CRC16 of the fields above. */
+} pca9420_evlog_record_t;
+
+/*!
+ * @brief Retained log, header followed by the ring.
+ */
+typedef struct
+{
+	uint32_t magic;                                   /*!< PCA9420_EVLOG_MAGIC when valid. */
+	uint32_t head;                                    /*!< Records ever written, the next slot is head % PCA9420_EVLOG_LEN. */
+	uint16_t boot;                                    /*!< Boots since the log was cleared. */
+	uint16_t crc;                                     /*!< CRC16 of the header fields above. */
+	pca9420_evlog_record_t records[PCA9420_EVLOG_LEN]; /*!< Ring. */
+} pca9420_evlog_t;
+
+/*! @brief Called by PCA9420_EVLOG_Dump() per record, corrupt is set when the record failed its CRC. */
+typedef void (*pca9420_evlog_visit_t)(const pca9420_evlog_record_t *pRecord, bool corrupt, void *pUserData);
+
+/*! @brief Called by PCA9420_EVLOG_Record() per record written, from the caller's context. */
+typedef void (*pca9420_evlog_listener_t)(uint8_t type, uint8_t arg, uint16_t value, void *pUserData);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to recover or clear the retained log.
+ *  @details     A valid log is kept and its boot count incremented, anything else is cleared.
+ *  @constraints Call once at boot, before the first PCA9420_EVLOG_Record().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_EVLOG_Init() returns true when a log from before the reset was recovered.
+ */
+bool PCA9420_EVLOG_Init(void);
+
+/*! @brief       The interface function to append one record.
+ *  @details     The oldest record is overwritten once the ring is full.
+ *  @param[in]   type           enum _pca9420_evlog_type.
+ *  @param[in]   arg            type specific.
+ *  @param[in]   value          type specific.
+ *  @constraints None, callable from thread and interrupt context.
+ *  @reeentrant  Yes
+ *  @return      void.
+ */
+void PCA9420_EVLOG_Record(uint8_t type, uint8_t arg, uint16_t value);
+
+/*! @brief       The interface function to walk the log, oldest record first.
+ *  @param[in]   visit          function called per record.
+ *  @param[in]   pUserData      argument of visit.
+ *  @constraints Thread context only. Records written during the walk may be missed.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_EVLOG_Dump() returns the number of records visited.
+ */
+uint32_t PCA9420_EVLOG_Dump(pca9420_evlog_visit_t visit, void *pUserData);
+
+/*! @brief       The interface function to print the log and the reset cause on the debug console.
+ *  @details     The reset cause is decoded from RESET_MONITOR alone. The caller clears it afterwards.
+ *  @param[in]   resetMonitor   RESET_MONITOR as read at boot.
+ *  @param[in]   subInt0        SUB_INT0 as read at boot, before any interrupt is cleared.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_EVLOG_Print(uint8_t resetMonitor, uint8_t subInt0);
+
+/*! @brief       The interface function to read the current boot count.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_EVLOG_GetBoot() returns the boot count.
+ */
+uint16_t PCA9420_EVLOG_GetBoot(void);
+
+/*! @brief       The interface function to follow the records as they are written.
+ *  @details     The listener is called after the record is stored, with interrupts enabled.
+ *  @param[in]   listener       function called per record, NULL to remove it.
+ *  @param[in]   pUserData      argument of listener.
+ *  @constraints The listener runs in interrupt context for records written there and has to return quickly.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_EVLOG_SetListener(pca9420_evlog_listener_t listener, void *pUserData);
+
+#endif /* PCA9420UK_EVLOG_H_ */
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_ilim.c
+ * @brief The pca9420uk_ilim.c file implements the PCA9420UK VIN input current limit manager.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_ilim.h"
+#include "pca9420uk.h"
+#include "pca9420uk_config.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* VIN status of CHG_STATUS1 when input power is valid. */
+#define PCA9420_ILIM_VIN_VALID (3u)
+
+/* Setting before the first write. */
+#define PCA9420_ILIM_SETTING_NONE (0xFFu)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const uint16_t s_settingMa[PCA9420_ILIM_SETTINGS] = {85u, 425u};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void PCA9420_ILIM_EndLimit(pca9420_ilim_t *pIlim, uint32_t now)
+{
+	if (pIlim->inLimit)
+	{
+		pIlim->limitTicks[pIlim->setting] += now - pIlim->limitStart;
+		pIlim->inLimit = false;
+		SW_TIMER_Stop(&pIlim->clearTimer);
+	}
+}
+
+static int32_t PCA9420_ILIM_ReadVin(pca9420_ilim_t *pIlim)
+{
+	uint8_t data;
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pIlim->pSensorHandle, PCA9420UK_CHG_STATUS1, &data, 1u);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pIlim->busErrors++;
+		return status;
+	}
+	pIlim->vinStatus = (uint8_t)((data & PCA9420_IN_PWR_STATUS_MASK) >> PCA9420_IN_PWR_STATUS_SHIFT);
+	return SENSOR_ERROR_NONE;
+}
+
+/* Writes VIN_ILIM_SEL, the running limit interval is closed under the old setting. */
+static int32_t PCA9420_ILIM_Set(pca9420_ilim_t *pIlim, uint8_t setting, uint8_t reason)
+{
+	pca9420_config_t target;
+	uint8_t careMask[PCA9420_CFG_REG_COUNT];
+	uint32_t now = SW_TIMER_GetTicks();
+	int32_t status;
+
+	if (setting == pIlim->setting)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	memset(&target, 0, sizeof(target));
+	memset(careMask, 0, sizeof(careMask));
+	target.regions = PCA9420_CFG_REGION_TOP;
+	target.regs[PCA9420UK_TOP_CNTL0] = (uint8_t)(setting << PCA9420_MODE_VIN_ILIM_SEL_SHIFT);
+	careMask[PCA9420UK_TOP_CNTL0] = PCA9420_MODE_VIN_ILIM_SEL_MASK;
+	status = PCA9420_CFG_Reconcile(pIlim->pSensorHandle, &target, careMask, NULL, NULL);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pIlim->busErrors++;
+		return status;
+	}
+
+	PCA9420_ILIM_EndLimit(pIlim, now);
+	pIlim->setting = setting;
+	if (setting == kPCA9420_VinIlim_370_425_489)
+	{
+		pIlim->highSince = now;
+	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogInputLimit, reason, s_settingMa[setting]);
+	return SENSOR_ERROR_NONE;
+}
+
+/* Falls back to the low limit and waits before the next try. */
+static void PCA9420_ILIM_Fallback(pca9420_ilim_t *pIlim, uint8_t reason)
+{
+	uint32_t now = SW_TIMER_GetTicks();
+
+	if ((pIlim->setting != kPCA9420_VinIlim_370_425_489) ||
+	    (SENSOR_ERROR_NONE != PCA9420_ILIM_Set(pIlim, kPCA9420_VinIlim_74_85_98, reason)))
+	{
+		return;
+	}
+	pIlim->fallbacks++;
+
+	/* A high limit that held resets the wait, each quick fallback doubles the next one. */
+	if ((now - pIlim->highSince) >= SW_TIMER_MS_TO_TICKS(pIlim->config.stableMs))
+	{
+		pIlim->waitMs = pIlim->config.backoffMs;
+	}
+	SW_TIMER_Start(&pIlim->retryTimer, SW_TIMER_MS_TO_TICKS(pIlim->waitMs), 0u);
+	pIlim->waitMs = ((pIlim->waitMs * 2u) < pIlim->config.maxBackoffMs) ? (pIlim->waitMs * 2u) : pIlim->config.maxBackoffMs;
+}
+
+static void PCA9420_ILIM_Interrupt(uint32_t sources, void *pUserData)
+{
+	pca9420_ilim_t *pIlim = (pca9420_ilim_t *)pUserData;
+	uint8_t previous = pIlim->vinStatus;
+	bool vinRead = false;
+
+	if ((sources & kPCA9420_IntSrcSysVinOKChanged) != 0u)
+	{
+		vinRead = (SENSOR_ERROR_NONE == PCA9420_ILIM_ReadVin(pIlim));
+		if (vinRead && (pIlim->vinStatus == PCA9420_ILIM_VIN_VALID) && (previous != PCA9420_ILIM_VIN_VALID))
+		{
+			/* New adapter, find its limit from the top. */
+			SW_TIMER_Stop(&pIlim->retryTimer);
+			pIlim->waitMs = pIlim->config.backoffMs;
+			(void)PCA9420_ILIM_Set(pIlim, kPCA9420_VinIlim_370_425_489, kPCA9420_IlimAdapter);
+		}
+		else if (vinRead && (pIlim->vinStatus != PCA9420_ILIM_VIN_VALID))
+		{
+			PCA9420_ILIM_EndLimit(pIlim, SW_TIMER_GetTicks());
+		}
+	}
+
+	if ((sources & kPCA9420_IntSrcSysAsysPreWarn) != 0u)
+	{
+		PCA9420_ILIM_Fallback(pIlim, kPCA9420_IlimAsysWarn);
+	}
+
+	if ((sources & kPCA9420_IntSrcChgInputCurrentLmt) != 0u)
+	{
+		if (!pIlim->inLimit)
+		{
+			pIlim->inLimit = true;
+			pIlim->limitStart = SW_TIMER_GetTicks();
+			pIlim->limitEvents++;
+		}
+		SW_TIMER_Start(&pIlim->clearTimer, SW_TIMER_MS_TO_TICKS(pIlim->config.clearMs), 0u);
+
+		/* In limit and CHG_STATUS1 no longer reports VIN valid, the adapter is sagging. */
+		if ((vinRead || (SENSOR_ERROR_NONE == PCA9420_ILIM_ReadVin(pIlim))) &&
+		    (pIlim->vinStatus != PCA9420_ILIM_VIN_VALID))
+		{
+			PCA9420_ILIM_Fallback(pIlim, kPCA9420_IlimSag);
+		}
+	}
+}
+
+static void PCA9420_ILIM_Clear(void *pUserData)
+{
+	PCA9420_ILIM_EndLimit((pca9420_ilim_t *)pUserData, SW_TIMER_GetTicks());
+}
+
+static void PCA9420_ILIM_Retry(void *pUserData)
+{
+	pca9420_ilim_t *pIlim = (pca9420_ilim_t *)pUserData;
+
+	/* Without input power the next adapter starts high anyway. */
+	if ((SENSOR_ERROR_NONE == PCA9420_ILIM_ReadVin(pIlim)) && (pIlim->vinStatus == PCA9420_ILIM_VIN_VALID) &&
+	    (SENSOR_ERROR_NONE == PCA9420_ILIM_Set(pIlim, kPCA9420_VinIlim_370_425_489, kPCA9420_IlimRetry)))
+	{
+		pIlim->retries++;
+	}
+}
+
+int32_t PCA9420_ILIM_Init(pca9420_ilim_t *pIlim, pca9420_irq_t *pIrq, const pca9420_ilim_config_t *pConfig)
+{
+	int32_t status;
+
+	if ((pIlim == NULL) || (pIrq == NULL) || (pConfig == NULL) || (pConfig->clearMs == 0u) || (pConfig->stableMs == 0u) ||
+	    (pConfig->backoffMs == 0u) || (pConfig->backoffMs > pConfig->maxBackoffMs))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pIlim, 0, sizeof(*pIlim));
+	pIlim->pSensorHandle = pIrq->pSensorHandle;
+	pIlim->config = *pConfig;
+	pIlim->setting = PCA9420_ILIM_SETTING_NONE;
+	pIlim->waitMs = pConfig->backoffMs;
+	SW_TIMER_Setup(&pIlim->clearTimer, PCA9420_ILIM_Clear, pIlim);
+	SW_TIMER_Setup(&pIlim->retryTimer, PCA9420_ILIM_Retry, pIlim);
+
+	status = PCA9420_ILIM_ReadVin(pIlim);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCA9420_ILIM_Set(pIlim, kPCA9420_VinIlim_370_425_489, kPCA9420_IlimStart);
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	return PCA9420_IRQ_Register(pIrq,
+	                            kPCA9420_IntSrcSysVinOKChanged | kPCA9420_IntSrcSysAsysPreWarn |
+	                                kPCA9420_IntSrcChgInputCurrentLmt,
+	                            PCA9420_ILIM_Interrupt, pIlim);
+}
+
+uint32_t PCA9420_ILIM_GetLimitMs(const pca9420_ilim_t *pIlim, uint8_t setting)
+{
+	uint32_t ticks = pIlim->limitTicks[setting];
+
+	if (pIlim->inLimit && (setting == pIlim->setting))
+	{
+		ticks += SW_TIMER_GetTicks() - pIlim->limitStart;
+	}
+	return (uint32_t)((uint64_t)ticks * 1000u / SW_TIMER_TICK_HZ);
+}
+
+uint32_t PCA9420_ILIM_GetMa(const pca9420_ilim_t *pIlim)
+{
+	return s_settingMa[pIlim->setting];
+}
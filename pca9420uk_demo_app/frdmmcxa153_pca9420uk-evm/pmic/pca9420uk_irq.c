@@ -0,0 +1,118 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_irq.c
+ * @brief The pca9420uk_irq.c file implements the PCA9420UK interrupt dispatcher.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_irq.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* TOP_INT up to SUB_INT2, the masks interleaved with the flags. */
+#define PCA9420_IRQ_READ_LEN (PCA9420UK_SUB_INT2 - PCA9420UK_TOP_INT + 1)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+int32_t PCA9420_IRQ_Init(pca9420_irq_t *pIrq, pca9420_i2c_sensorhandle_t *pSensorHandle)
+{
+	if ((pIrq == NULL) || (pSensorHandle == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pIrq, 0, sizeof(*pIrq));
+	pIrq->pSensorHandle = pSensorHandle;
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_IRQ_Register(pca9420_irq_t *pIrq, uint32_t sources, pca9420_irq_handler_t handler, void *pUserData)
+{
+	if ((pIrq == NULL) || (handler == NULL) || (pIrq->count >= PCA9420_IRQ_MAX_HANDLERS))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	pIrq->entries[pIrq->count].sources = sources;
+	pIrq->entries[pIrq->count].handler = handler;
+	pIrq->entries[pIrq->count].pUserData = pUserData;
+	pIrq->count++;
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_IRQ_Service(pca9420_irq_t *pIrq, uint32_t *pSources)
+{
+	uint8_t regs[PCA9420_IRQ_READ_LEN];
+	uint32_t sources, matched, i;
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pIrq->pSensorHandle, PCA9420UK_TOP_INT, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pIrq->busErrors++;
+		return status;
+	}
+	sources = (uint32_t)regs[PCA9420UK_SUB_INT0 - PCA9420UK_TOP_INT] |
+	          ((uint32_t)regs[PCA9420UK_SUB_INT1 - PCA9420UK_TOP_INT] << 8) |
+	          ((uint32_t)regs[PCA9420UK_SUB_INT2 - PCA9420UK_TOP_INT] << 16);
+	pIrq->topInt = regs[0];
+	pIrq->lastSources = sources;
+	if (pSources != NULL)
+	{
+		*pSources = sources;
+	}
+	if (sources == 0u)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	/* The flags are write-1-to-clear: writing back what was read clears those flags only, the masks
+	 * in between go back unchanged. */
+	status = PCA9420_DRV_BlockWrite(pIrq->pSensorHandle, PCA9420UK_SUB_INT0, &regs[PCA9420UK_SUB_INT0 - PCA9420UK_TOP_INT],
+	                                PCA9420UK_SUB_INT2 - PCA9420UK_SUB_INT0 + 1);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pIrq->busErrors++;
+		return status;
+	}
+	pIrq->services++;
+	pIrq->latchedTopInt |= pIrq->topInt;
+	pIrq->latched |= sources;
+	PCA9420_EVLOG_Record(kPCA9420_EvlogInterrupt, pIrq->topInt, (uint16_t)sources);
+
+	for (i = 0u; i < pIrq->count; i++)
+	{
+		matched = sources & pIrq->entries[i].sources;
+		if (matched != 0u)
+		{
+			pIrq->entries[i].handler(matched, pIrq->entries[i].pUserData);
+		}
+	}
+	return SENSOR_ERROR_NONE;
+}
+
+uint32_t PCA9420_IRQ_TakeLatched(pca9420_irq_t *pIrq, uint8_t *pTopInt)
+{
+	uint32_t sources = pIrq->latched;
+
+	if (pTopInt != NULL)
+	{
+		*pTopInt = pIrq->latchedTopInt;
+	}
+	pIrq->latched = 0u;
+	pIrq->latchedTopInt = 0u;
+	return sources;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_jeita.c
+ * @brief The pca9420uk_jeita.c file implements the PCA9420UK temperature zoned charging profile engine.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_jeita.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Programs the settings of a zone in one reconcile of the CHARGER region. */
+static int32_t PCA9420_JEITA_Apply(pca9420_jeita_t *pJeita, uint8_t zone)
+{
+	const pca9420_jeita_zone_t *pZone = &pJeita->profile.zones[zone];
+	pca9420_config_t target;
+	uint8_t careMask[PCA9420_CFG_REG_COUNT];
+	uint8_t ichgCode = pZone->ichgCode;
+	int32_t status;
+
+	if (pJeita->pThermal != NULL)
+	{
+		ichgCode = PCA9420_THERMAL_SetLimit(pJeita->pThermal, ichgCode);
+	}
+
+	memset(&target, 0, sizeof(target));
+	memset(careMask, 0, sizeof(careMask));
+	target.regions = PCA9420_CFG_REGION_CHARGER;
+	target.regs[PCA9420UK_CHG_CNTL0] = (uint8_t)(pZone->charge << PCA9420_CHG_EN_SHIFT);
+	careMask[PCA9420UK_CHG_CNTL0] = PCA9420_CHG_EN_MASK;
+	target.regs[PCA9420UK_CHG_CNTL1] = (uint8_t)(ichgCode << PCA9420_MODE_ICHG_CC_SHIFT);
+	careMask[PCA9420UK_CHG_CNTL1] = PCA9420_MODE_ICHG_CC_MASK;
+	target.regs[PCA9420UK_CHG_CNTL2] = (uint8_t)(pZone->topoffCode << PCA9420_MODE_ICHG_TOPOFF_SHIFT);
+	careMask[PCA9420UK_CHG_CNTL2] = PCA9420_MODE_ICHG_TOPOFF_MASK;
+	target.regs[PCA9420UK_CHG_CNTL5] =
+	    (uint8_t)((pZone->vbatReg << PCA9420_VBAT_REG_SHIFT) | (pZone->recharge << PCA9420_VBAT_RESTART_SHIFT));
+	careMask[PCA9420UK_CHG_CNTL5] = PCA9420_VBAT_REG_MASK | PCA9420_VBAT_RESTART_MASK;
+
+	status = PCA9420_CFG_Reconcile(pJeita->pSensorHandle, &target, careMask, NULL, &pJeita->last);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pJeita->busErrors++;
+		return status;
+	}
+	if (pJeita->pThermal != NULL)
+	{
+		PCA9420_THERMAL_Written(pJeita->pThermal, ichgCode);
+	}
+	return SENSOR_ERROR_NONE;
+}
+
+static void PCA9420_JEITA_Interrupt(uint32_t sources, void *pUserData)
+{
+	(void)PCA9420_JEITA_Update((pca9420_jeita_t *)pUserData);
+}
+
+static void PCA9420_JEITA_Poll(void *pUserData)
+{
+	(void)PCA9420_JEITA_Update((pca9420_jeita_t *)pUserData);
+}
+
+int32_t PCA9420_JEITA_Init(pca9420_jeita_t *pJeita, pca9420_irq_t *pIrq, const pca9420_jeita_profile_t *pProfile,
+                           pca9420_thermal_t *pThermal)
+{
+	const pca9420_jeita_zone_t *pZone;
+	uint32_t zone;
+	int32_t status;
+
+	if ((pJeita == NULL) || (pIrq == NULL) || (pProfile == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	for (zone = 0u; zone < PCA9420_JEITA_ZONES; zone++)
+	{
+		pZone = &pProfile->zones[zone];
+		if ((pZone->charge > 1u) || (pZone->ichgCode > PCA9420_MODE_ICHG_CC_MASK) ||
+		    (pZone->topoffCode > PCA9420_MODE_ICHG_TOPOFF_MASK) || (pZone->vbatReg > PCA9420_VBAT_REG_MASK) ||
+		    (pZone->recharge > (PCA9420_VBAT_RESTART_MASK >> PCA9420_VBAT_RESTART_SHIFT)))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+	}
+
+	memset(pJeita, 0, sizeof(*pJeita));
+	pJeita->pSensorHandle = pIrq->pSensorHandle;
+	pJeita->profile = *pProfile;
+	pJeita->pThermal = pThermal;
+	pJeita->zone = PCA9420_JEITA_ZONE_UNKNOWN;
+	SW_TIMER_Setup(&pJeita->timer, PCA9420_JEITA_Poll, pJeita);
+
+	status = PCA9420_JEITA_Update(pJeita);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	return PCA9420_IRQ_Register(pIrq, kPCA9420_IntSrcChgAll, PCA9420_JEITA_Interrupt, pJeita);
+}
+
+int32_t PCA9420_JEITA_Update(pca9420_jeita_t *pJeita)
+{
+	uint32_t now = SW_TIMER_GetTicks();
+	uint8_t regs[PCA9420UK_CHG_STATUS3 - PCA9420UK_CHG_STATUS2 + 1];
+	uint8_t phase, zone;
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pJeita->pSensorHandle, PCA9420UK_CHG_STATUS2, regs, sizeof(regs));
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pJeita->busErrors++;
+		return status;
+	}
+	phase = (uint8_t)((regs[0] & PCA9420_BAT_CHG_STATUS_MASK) >> PCA9420_BAT_CHG_STATUS_SHIFT);
+	zone = (uint8_t)((regs[1] & PCA9420_TEMP_STATUS_MASK) >> PCA9420_TEMP_STATUS_SHIFT);
+
+	/* No interrupt tells of a zone crossing, poll while charging. */
+	if ((phase >= kPCA9420_ChgDeadBattery) && (phase <= kPCA9420_ChgTopOff))
+	{
+		if (!SW_TIMER_IsActive(&pJeita->timer))
+		{
+			SW_TIMER_Start(&pJeita->timer, SW_TIMER_MS_TO_TICKS(PCA9420_JEITA_POLL_MS), SW_TIMER_MS_TO_TICKS(PCA9420_JEITA_POLL_MS));
+		}
+	}
+	else
+	{
+		SW_TIMER_Stop(&pJeita->timer);
+	}
+	if ((zone == pJeita->zone) || (zone >= PCA9420_JEITA_ZONES))
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	/* A failed write leaves the zone as it was, the next interrupt or poll tries again. */
+	status = PCA9420_JEITA_Apply(pJeita, zone);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	if (pJeita->zone < PCA9420_JEITA_ZONES)
+	{
+		pJeita->zoneTicks[pJeita->zone] += now - pJeita->since;
+		pJeita->changes++;
+	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogChargeZone, zone, pJeita->zone);
+	pJeita->zone = zone;
+	pJeita->since = now;
+	return SENSOR_ERROR_NONE;
+}
+
+uint32_t PCA9420_JEITA_GetZoneMs(const pca9420_jeita_t *pJeita, uint8_t zone)
+{
+	uint32_t ticks = pJeita->zoneTicks[zone];
+
+	if (zone == pJeita->zone)
+	{
+		ticks += SW_TIMER_GetTicks() - pJeita->since;
+	}
+	return (uint32_t)((uint64_t)ticks * 1000u / SW_TIMER_TICK_HZ);
+}
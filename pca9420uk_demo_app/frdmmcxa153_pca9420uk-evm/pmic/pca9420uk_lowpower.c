@@ -0,0 +1,284 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_lowpower.c
+ * @brief The pca9420uk_lowpower.c file implements the PCA9420UK low-power entry/exit sequencer.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_lowpower.h"
+#include "pca9420uk.h"
+#include "systick_utils.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t PCA9420_LP_ElapsedUs(int32_t *pStart)
+{
+	return (uint32_t)COUNT_TO_USEC((uint32_t)BOARD_SystickElapsedTicks(pStart), SystemCoreClock);
+}
+
+/* Steps first and first + 1 go out in one register write. */
+static bool PCA9420_LP_Joined(const pca9420_lp_step_t *pSteps, uint32_t first)
+{
+	return (pSteps[first].type == kPCA9420_LpStepRegister) && (pSteps[first + 1u].type == kPCA9420_LpStepRegister) &&
+	       (pSteps[first].settleUs == 0u) &&
+	       (PCA9420_CFG_RegionOf(pSteps[first].address) == PCA9420_CFG_RegionOf(pSteps[first + 1u].address));
+}
+
+/* Runs steps first..last, one write group or one hook, and waits its settle time. */
+static int32_t PCA9420_LP_RunGroup(pca9420_lp_t *pLp, uint32_t first, uint32_t last, bool entering, int32_t *pStart,
+                                   uint32_t *pStepUs, uint8_t *pReads, uint8_t *pWrites)
+{
+	const pca9420_lp_step_t *pStep = &pLp->pSteps[first];
+	pca9420_config_t target;
+	pca9420_cfg_result_t result;
+	uint8_t care[PCA9420_CFG_REG_COUNT];
+	uint32_t i, doneUs;
+	int32_t status;
+
+	if (pStep->type == kPCA9420_LpStepHook)
+	{
+		status = pStep->hook(entering, pStep->pUserData);
+	}
+	else
+	{
+		/* Entry takes the step values, exit the bits saved before the entry. */
+		memset(care, 0, sizeof(care));
+		target = pLp->saved;
+		for (i = first; i <= last; i++)
+		{
+			pStep = &pLp->pSteps[i];
+			care[pStep->address] |= pStep->mask;
+			if (entering)
+			{
+				target.regs[pStep->address] = (uint8_t)((target.regs[pStep->address] & ~pStep->mask) | pStep->value);
+			}
+		}
+		memset(&result, 0, sizeof(result));
+		status = PCA9420_CFG_Reconcile(pLp->pSensorHandle, &target, care, &pLp->live, &result);
+		*pReads += result.reads;
+		*pWrites += result.writes;
+		pStep = &pLp->pSteps[last];
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	doneUs = PCA9420_LP_ElapsedUs(pStart) + pStep->settleUs;
+	while (PCA9420_LP_ElapsedUs(pStart) < doneUs)
+	{
+	}
+	for (i = first; i <= last; i++)
+	{
+		pStepUs[i] = doneUs;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Undoes the steps in force, last group first. Every group is tried, the first error is returned. */
+static int32_t PCA9420_LP_Undo(pca9420_lp_t *pLp, int32_t *pStart)
+{
+	uint32_t first, last;
+	int32_t status, firstStatus = SENSOR_ERROR_NONE;
+
+	/* Nothing guarantees the PMIC kept its registers meanwhile, the first group reads them again. */
+	pLp->live.regions = 0u;
+	pLp->stats.exitReads = 0u;
+	pLp->stats.exitWrites = 0u;
+	memset(pLp->stats.exitStepUs, 0, sizeof(pLp->stats.exitStepUs));
+
+	while (pLp->done > 0u)
+	{
+		last = pLp->done - 1u;
+		for (first = last; (first > 0u) && PCA9420_LP_Joined(pLp->pSteps, first - 1u); first--)
+		{
+		}
+		status = PCA9420_LP_RunGroup(pLp, first, last, false, pStart, pLp->stats.exitStepUs, &pLp->stats.exitReads,
+		                             &pLp->stats.exitWrites);
+		if ((SENSOR_ERROR_NONE != status) && (SENSOR_ERROR_NONE == firstStatus))
+		{
+			firstStatus = status;
+		}
+		pLp->done = (uint8_t)first;
+	}
+	pLp->stats.exitUs = PCA9420_LP_ElapsedUs(pStart);
+
+	return firstStatus;
+}
+
+int32_t PCA9420_LP_Init(pca9420_lp_t *pLp, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_dvfs_t *pDvfs,
+                        const pca9420_lp_step_t *pSteps, uint8_t count)
+{
+	uint8_t region;
+	uint32_t i;
+
+	if ((pLp == NULL) || (pSensorHandle == NULL) || (pSteps == NULL) || (count == 0u) || (count > PCA9420_LP_MAX_STEPS))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pLp, 0, sizeof(*pLp));
+	for (i = 0u; i < count; i++)
+	{
+		if (pSteps[i].type == kPCA9420_LpStepHook)
+		{
+			if (pSteps[i].hook == NULL)
+			{
+				return SENSOR_ERROR_INVALID_PARAM;
+			}
+			continue;
+		}
+		region = PCA9420_CFG_RegionOf(pSteps[i].address);
+		if ((pSteps[i].type != kPCA9420_LpStepRegister) || (region == 0u) || (pSteps[i].address == PCA9420UK_SUB_INT1) ||
+		    (pSteps[i].address == PCA9420UK_SUB_INT2) || (pSteps[i].mask == 0u) || ((pSteps[i].value & ~pSteps[i].mask) != 0u))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		pLp->regions |= region;
+	}
+
+	pLp->pSensorHandle = pSensorHandle;
+	pLp->pDvfs = pDvfs;
+	pLp->pSteps = pSteps;
+	pLp->count = count;
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Runs the entry steps, timed, and undoes them on a failure. */
+static int32_t PCA9420_LP_Run(pca9420_lp_t *pLp)
+{
+	pca9420_config_t none;
+	pca9420_cfg_result_t result;
+	uint8_t care[PCA9420_CFG_REG_COUNT];
+	uint32_t first, last;
+	int32_t start, status = SENSOR_ERROR_NONE;
+
+	BOARD_SystickStart(&start);
+	pLp->stats.entryReads = 0u;
+	pLp->stats.entryWrites = 0u;
+	memset(pLp->stats.entryStepUs, 0, sizeof(pLp->stats.entryStepUs));
+
+	/* Reconciling with nothing cared for reads every touched region in one burst and writes nothing. */
+	if (pLp->regions != 0u)
+	{
+		memset(&none, 0, sizeof(none));
+		memset(care, 0, sizeof(care));
+		memset(&result, 0, sizeof(result));
+		none.regions = pLp->regions;
+		pLp->live.regions = 0u;
+		status = PCA9420_CFG_Reconcile(pLp->pSensorHandle, &none, care, &pLp->live, &result);
+		pLp->stats.entryReads = result.reads;
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+		pLp->saved = pLp->live;
+	}
+
+	for (first = 0u; (first < pLp->count) && (SENSOR_ERROR_NONE == status); first = last + 1u)
+	{
+		for (last = first; (last + 1u < pLp->count) && PCA9420_LP_Joined(pLp->pSteps, last); last++)
+		{
+		}
+		status = PCA9420_LP_RunGroup(pLp, first, last, true, &start, pLp->stats.entryStepUs, &pLp->stats.entryReads,
+		                             &pLp->stats.entryWrites);
+		if ((SENSOR_ERROR_NONE == status) || (pLp->pSteps[first].type == kPCA9420_LpStepRegister))
+		{
+			/* A register group may be partly written, undoing it is harmless. */
+			pLp->done = (uint8_t)(last + 1u);
+		}
+	}
+	pLp->stats.entryUs = PCA9420_LP_ElapsedUs(&start);
+
+	if (SENSOR_ERROR_NONE != status)
+	{
+		BOARD_SystickStart(&start);
+		(void)PCA9420_LP_Undo(pLp, &start);
+		pLp->stats.rollbacks++;
+		return status;
+	}
+
+	pLp->stats.entries++;
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_LP_Enter(pca9420_lp_t *pLp)
+{
+	int32_t status;
+
+	if (pLp == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if ((pLp->count == 0u) || (pLp->done != 0u))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/* The core runs on the lowered rails until it sleeps, it goes to its slowest point first. */
+	if (pLp->pDvfs != NULL)
+	{
+		pLp->dvfsPoint = pLp->pDvfs->current;
+		status = PCA9420_DVFS_SetPoint(pLp->pDvfs, 0u);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			(void)PCA9420_DVFS_SetPoint(pLp->pDvfs, pLp->dvfsPoint);
+			return status;
+		}
+	}
+
+	status = PCA9420_LP_Run(pLp);
+	if ((SENSOR_ERROR_NONE != status) && (pLp->pDvfs != NULL))
+	{
+		(void)PCA9420_DVFS_SetPoint(pLp->pDvfs, pLp->dvfsPoint);
+	}
+
+	return status;
+}
+
+int32_t PCA9420_LP_Exit(pca9420_lp_t *pLp)
+{
+	int32_t start, status, dvfsStatus;
+
+	if (pLp == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if ((pLp->count == 0u) || (pLp->done != pLp->count))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	BOARD_SystickStart(&start);
+	status = PCA9420_LP_Undo(pLp, &start);
+	pLp->stats.exits++;
+
+	/* The rails are back, the clock may go up again. */
+	if (pLp->pDvfs != NULL)
+	{
+		dvfsStatus = PCA9420_DVFS_SetPoint(pLp->pDvfs, pLp->dvfsPoint);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			status = dvfsStatus;
+		}
+	}
+
+	return status;
+}
+
+bool PCA9420_LP_IsEntered(const pca9420_lp_t *pLp)
+{
+	return (pLp != NULL) && (pLp->count != 0u) && (pLp->done == pLp->count);
+}
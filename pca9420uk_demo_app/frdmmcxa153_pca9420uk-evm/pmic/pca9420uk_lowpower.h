@@ -0,0 +1,170 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_lowpower.h
+ * @brief The pca9420uk_lowpower.h file describes the PCA9420UK low-power entry/exit sequencer.
+
+    A low-power sequence is a table of steps run in order on entry and undone in the reverse
+    order on exit. A register step sets masked bits of one PMIC register, a hook step calls
+    the application, for example to arm the MCU low-power request. Each step may ask for a
+    settle time before the next one starts.
+
+    The registers are handled through a cached configuration image, see pca9420uk_config.h:
+    entry reads every touched region in one burst, consecutive register steps of one region
+    with no settle time between them are written together, and registers that already hold
+    the wanted bits are not written at all. Exit restores the bits saved at entry the same way.
+
+    When an entry step fails, the steps already done are undone and the PMIC is back where it
+    was. Entry and exit are timed per step and in total, together with the number of bus
+    transfers they took, to size a duty cycle around the low-power periods.
+
+    The steps lower the rails while the core still runs, until the MCU itself goes to deep
+    sleep. With a DVFS engine given, entry first takes the core to the lowest operating point
+    and exit brings back the point in force before, so no step may take SW1 below the voltage
+    of that lowest point. The DVFS transition is not part of the timed sequence.
+*/
+
+#ifndef PCA9420UK_LOWPOWER_H_
+#define PCA9420UK_LOWPOWER_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_config.h"
+#include "pca9420uk_dvfs.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Longest sequence. */
+#ifndef PCA9420_LP_MAX_STEPS
+#define PCA9420_LP_MAX_STEPS (12u)
+#endif
+
+/*! @brief Application step, entering is true on entry and false when the step is undone. */
+typedef int32_t (*pca9420_lp_hook_t)(bool entering, void *pUserData);
+
+/*! @brief Step types. */
+typedef enum
+{
+	kPCA9420_LpStepRegister = 0u, /*!< Set masked bits of a PMIC register. */
+	kPCA9420_LpStepHook     = 1u, /*!< Call the application. */
+} pca9420_lp_step_type_t;
+
+/*!
+ * @brief Sequence step.
+ */
+typedef struct
+{
+	pca9420_lp_step_type_t type; /*!< Step type. */
+	uint8_t address;             /*!< Register, held by a PCA9420_CFG_REGION_ region. */
+	uint8_t mask;                /*!< Bits set by the step. */
+	uint8_t value;               /*!< Their value on entry. */
+	uint16_t settleUs;           /*!< Wait after the step, on entry and on exit. */
+	pca9420_lp_hook_t hook;      /*!< Hook of a kPCA9420_LpStepHook step. */
+	void *pUserData;             /*!< Argument of hook. */
+} pca9420_lp_step_t;
+
+/*! @brief Register step initializer. */
+#define PCA9420_LP_REGISTER(address, mask, value, settleUs) \
+	{kPCA9420_LpStepRegister, (address), (mask), (value), (settleUs), NULL, NULL}
+
+/*! @brief Hook step initializer. */
+#define PCA9420_LP_HOOK(hook, pUserData, settleUs) \
+	{kPCA9420_LpStepHook, 0u, 0u, 0u, (settleUs), (hook), (pUserData)}
+
+/*!
+ * @brief Sequence statistics of the last entry and exit, times in microseconds.
+ */
+typedef struct
+{
+	uint32_t entries;                          /*!< Completed entries. */
+	uint32_t exits;                            /*!< Completed exits, with or without errors. */
+	uint32_t rollbacks;                        /*!< Entries undone after a failed step. */
+	uint32_t entryUs;                          /*!< Entry latency, settle times included. */
+	uint32_t exitUs;                           /*!< Exit latency, settle times included. */
+	uint8_t entryReads;                        /*!< Burst reads of the entry. */
+	uint8_t entryWrites;                       /*!< Burst writes of the entry. */
+	uint8_t exitReads;                         /*!< Burst reads of the exit. */
+	uint8_t exitWrites;                        /*!< Burst writes of the exit. */
+	uint32_t entryStepUs[PCA9420_LP_MAX_STEPS]; /*!< Time from the start of the entry to the end of each step. */
+	uint32_t exitStepUs[PCA9420_LP_MAX_STEPS];  /*!< Time from the start of the exit to the end of undoing each step. */
+} pca9420_lp_stats_t;
+
+/*!
+ * @brief Sequencer context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+	pca9420_dvfs_t *pDvfs;                     /*!< DVFS engine taken to its lowest point while entered, may be NULL. */
+	uint8_t dvfsPoint;                         /*!< Operating point before the entry. */
+	const pca9420_lp_step_t *pSteps;           /*!< Sequence. */
+	uint8_t count;                             /*!< Number of steps. */
+	uint8_t done;                              /*!< Steps in force, count once entered. */
+	uint8_t regions;                           /*!< PCA9420_CFG_REGION_ bits the steps touch. */
+	pca9420_config_t live;                     /*!< Register cache. */
+	pca9420_config_t saved;                    /*!< Registers before the entry. */
+	pca9420_lp_stats_t stats;                  /*!< Statistics. */
+} pca9420_lp_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to set up a low-power sequence.
+ *  @details     This function checks the steps, nothing is written.
+ *  @param[out]  pLp            sequencer context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pDvfs          DVFS engine of the core the rails feed, may be NULL.
+ *  @param[in]   pSteps         sequence, in entry order.
+ *  @param[in]   count          number of steps, 1..PCA9420_LP_MAX_STEPS.
+ *  @constraints None.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_LP_Init() returns the status, SENSOR_ERROR_INVALID_PARAM for a register outside the
+ *               configuration regions, an interrupt flag register or a value outside its mask.
+ */
+int32_t PCA9420_LP_Init(pca9420_lp_t *pLp, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_dvfs_t *pDvfs,
+                        const pca9420_lp_step_t *pSteps, uint8_t count);
+
+/*! @brief       The interface function to run the entry sequence.
+ *  @details     This function moves the DVFS engine to its lowest point, saves the touched registers and
+ *               runs the steps in order. When a step fails the steps done so far are undone in the reverse
+ *               order and the operating point is restored.
+ *  @param[in]   pLp            sequencer context.
+ *  @constraints Thread context only, the settle times are busy waits. The hooks must not call
+ *               BOARD_SystickStart(), it times the sequence.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_LP_Enter() returns the status of the failed step, SENSOR_ERROR_INIT when
+ *               already entered.
+ */
+int32_t PCA9420_LP_Enter(pca9420_lp_t *pLp);
+
+/*! @brief       The interface function to run the exit sequence.
+ *  @details     This function undoes the steps in the reverse order, the registers get back the bits
+ *               saved at entry, then restores the operating point in force before the entry. The live
+ *               registers are read again first. A failing step does not stop the sequence, the remaining
+ *               steps are still undone.
+ *  @param[in]   pLp            sequencer context.
+ *  @constraints Thread context only, see PCA9420_LP_Enter().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_LP_Exit() returns the status of the first failed step, SENSOR_ERROR_INIT
+ *               when not entered.
+ */
+int32_t PCA9420_LP_Exit(pca9420_lp_t *pLp);
+
+/*! @brief       The interface function to tell whether the entry sequence is in force.
+ *  @param[in]   pLp            sequencer context.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_LP_IsEntered() returns true between a successful entry and the next exit.
+ */
+bool PCA9420_LP_IsEntered(const pca9420_lp_t *pLp);
+
+#endif /* PCA9420UK_LOWPOWER_H_ */
@@ -0,0 +1,333 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_profile.c
+ * @brief The pca9420uk_profile.c file implements the PCA9420UK named power profile store.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <stddef.h>
+#include <string.h>
+#include "pca9420uk_profile.h"
+#include "crc16.h"
+#include "nvm_store.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Table header magic, "PPRF". */
+#define PCA9420_PROFILE_MAGIC (0x46525050u)
+
+/* Space per slot and for the header, a multiple of any flash page size the store runs on. */
+#define PCA9420_PROFILE_SLOT_SIZE (128u)
+
+#define PCA9420_PROFILE_NO_SECTOR (0xFFFFFFFFu)
+
+typedef struct
+{
+	uint32_t magic;      /* PCA9420_PROFILE_MAGIC. */
+	uint32_t generation; /* Incremented per table written, the higher one is in force. */
+	uint16_t slots;      /* PCA9420_PROFILE_SLOTS. */
+	uint16_t crc;        /* CRC16 of the fields above. */
+} pca9420_profile_header_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint32_t s_sector = PCA9420_PROFILE_NO_SECTOR; /* Sector of the table in force. */
+static uint32_t s_generation;
+static bool s_ready;
+
+/* Program buffer, one slot or the header padded to the slot size. */
+static uint8_t s_page[PCA9420_PROFILE_SLOT_SIZE] __attribute__((aligned(4)));
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static const pca9420_profile_header_t *PCA9420_PROFILE_Header(uint32_t sector)
+{
+	const pca9420_profile_header_t *pHeader = (const pca9420_profile_header_t *)NVM_GetSector(sector);
+
+	if ((pHeader == NULL) || (pHeader->magic != PCA9420_PROFILE_MAGIC) || (pHeader->slots != PCA9420_PROFILE_SLOTS) ||
+	    (pHeader->crc != CRC16_Compute((const uint8_t *)pHeader, offsetof(pca9420_profile_header_t, crc))))
+	{
+		return NULL;
+	}
+	return pHeader;
+}
+
+/* The slot of the table in force, NULL when it is empty, corrupt or of another format. */
+static const pca9420_profile_t *PCA9420_PROFILE_Slot(uint32_t slot)
+{
+	const pca9420_profile_t *pProfile;
+
+	if ((s_sector == PCA9420_PROFILE_NO_SECTOR) || (slot >= PCA9420_PROFILE_SLOTS))
+	{
+		return NULL;
+	}
+
+	pProfile = (const pca9420_profile_t *)(NVM_GetSector(s_sector) + (slot + 1u) * PCA9420_PROFILE_SLOT_SIZE);
+	if ((pProfile->version != PCA9420_PROFILE_VERSION) || (pProfile->length != sizeof(pca9420_profile_t)) ||
+	    (pProfile->crc != CRC16_Compute((const uint8_t *)pProfile, offsetof(pca9420_profile_t, crc))) ||
+	    (pProfile->name[0] == '\0') || (pProfile->name[PCA9420_PROFILE_NAME_LEN] != '\0'))
+	{
+		return NULL;
+	}
+	return pProfile;
+}
+
+static uint32_t PCA9420_PROFILE_Find(const char *pName)
+{
+	const pca9420_profile_t *pProfile;
+	uint32_t slot;
+
+	for (slot = 0u; slot < PCA9420_PROFILE_SLOTS; slot++)
+	{
+		pProfile = PCA9420_PROFILE_Slot(slot);
+		if ((pProfile != NULL) && (strcmp(pProfile->name, pName) == 0))
+		{
+			return slot;
+		}
+	}
+	return PCA9420_PROFILE_SLOTS;
+}
+
+/* Writes the table with the target slot replaced, or cleared when pConfig is NULL, into the other sector. */
+static int32_t PCA9420_PROFILE_Commit(uint32_t target, const char *pName, const pca9420_config_t *pConfig)
+{
+	pca9420_profile_header_t *pHeader = (pca9420_profile_header_t *)s_page;
+	pca9420_profile_t *pProfile = (pca9420_profile_t *)s_page;
+	const pca9420_profile_t *pOld;
+	uint32_t sector, slot;
+
+	sector = (s_sector == PCA9420_PROFILE_NO_SECTOR) ? 0u : (s_sector ^ 1u);
+	if (kStatus_Success != NVM_EraseSector(sector))
+	{
+		return SENSOR_ERROR_WRITE;
+	}
+
+	for (slot = 0u; slot < PCA9420_PROFILE_SLOTS; slot++)
+	{
+		memset(s_page, 0xFF, sizeof(s_page));
+		if (slot == target)
+		{
+			if (pConfig == NULL)
+			{
+				continue;
+			}
+			memset(pProfile, 0, sizeof(*pProfile));
+			pProfile->version = PCA9420_PROFILE_VERSION;
+			pProfile->length = sizeof(pca9420_profile_t);
+			strncpy(pProfile->name, pName, PCA9420_PROFILE_NAME_LEN);
+			pProfile->config = *pConfig;
+			pProfile->crc = CRC16_Compute((const uint8_t *)pProfile, offsetof(pca9420_profile_t, crc));
+		}
+		else
+		{
+			pOld = PCA9420_PROFILE_Slot(slot);
+			if (pOld == NULL)
+			{
+				continue;
+			}
+			memcpy(pProfile, pOld, sizeof(*pProfile));
+		}
+		if (kStatus_Success != NVM_Program(sector, (slot + 1u) * PCA9420_PROFILE_SLOT_SIZE, s_page, sizeof(s_page)))
+		{
+			return SENSOR_ERROR_WRITE;
+		}
+	}
+
+	/* The header goes last, until it is written the old table stays in force. */
+	memset(s_page, 0xFF, sizeof(s_page));
+	pHeader->magic = PCA9420_PROFILE_MAGIC;
+	pHeader->generation = s_generation + 1u;
+	pHeader->slots = PCA9420_PROFILE_SLOTS;
+	pHeader->crc = CRC16_Compute((const uint8_t *)pHeader, offsetof(pca9420_profile_header_t, crc));
+	if (kStatus_Success != NVM_Program(sector, 0u, s_page, sizeof(s_page)))
+	{
+		return SENSOR_ERROR_WRITE;
+	}
+
+	s_sector = sector;
+	s_generation++;
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_PROFILE_Init(void)
+{
+	const pca9420_profile_header_t *pHeader;
+	uint32_t sector, unit;
+
+	s_ready = false;
+	s_sector = PCA9420_PROFILE_NO_SECTOR;
+	s_generation = 0u;
+
+	if (kStatus_Success != NVM_Init())
+	{
+		return SENSOR_ERROR_INIT;
+	}
+	unit = NVM_GetProgramUnit();
+	if ((unit == 0u) || (unit > PCA9420_PROFILE_SLOT_SIZE) || ((PCA9420_PROFILE_SLOT_SIZE % unit) != 0u) ||
+	    ((PCA9420_PROFILE_SLOTS + 1u) * PCA9420_PROFILE_SLOT_SIZE > NVM_GetSectorSize()))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	for (sector = 0u; sector < NVM_SECTOR_COUNT; sector++)
+	{
+		pHeader = PCA9420_PROFILE_Header(sector);
+		if ((pHeader != NULL) &&
+		    ((s_sector == PCA9420_PROFILE_NO_SECTOR) || ((int32_t)(pHeader->generation - s_generation) > 0)))
+		{
+			s_sector = sector;
+			s_generation = pHeader->generation;
+		}
+	}
+	s_ready = true;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_PROFILE_Load(const char *pName, pca9420_config_t *pConfig)
+{
+	uint32_t slot;
+
+	if ((pName == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (!s_ready)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	slot = PCA9420_PROFILE_Find(pName);
+	if (slot == PCA9420_PROFILE_SLOTS)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	*pConfig = PCA9420_PROFILE_Slot(slot)->config;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_PROFILE_Store(const char *pName, const pca9420_config_t *pConfig)
+{
+	uint32_t slot, length;
+
+	if ((pName == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	length = strlen(pName);
+	if ((length == 0u) || (length > PCA9420_PROFILE_NAME_LEN))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (!s_ready)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	slot = PCA9420_PROFILE_Find(pName);
+	if (slot == PCA9420_PROFILE_SLOTS)
+	{
+		for (slot = 0u; (slot < PCA9420_PROFILE_SLOTS) && (PCA9420_PROFILE_Slot(slot) != NULL); slot++)
+		{
+		}
+		if (slot == PCA9420_PROFILE_SLOTS)
+		{
+			return SENSOR_ERROR_WRITE;
+		}
+	}
+
+	return PCA9420_PROFILE_Commit(slot, pName, pConfig);
+}
+
+int32_t PCA9420_PROFILE_Delete(const char *pName)
+{
+	uint32_t slot;
+
+	if (pName == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (!s_ready)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	slot = PCA9420_PROFILE_Find(pName);
+	if (slot == PCA9420_PROFILE_SLOTS)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	return PCA9420_PROFILE_Commit(slot, pName, NULL);
+}
+
+int32_t PCA9420_PROFILE_Save(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName)
+{
+	pca9420_config_t config;
+	int32_t status;
+
+	status = PCA9420_CFG_Capture(pSensorHandle, &config, PCA9420_CFG_REGION_ALL);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	return PCA9420_PROFILE_Store(pName, &config);
+}
+
+int32_t PCA9420_PROFILE_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName, pca9420_cfg_result_t *pResult)
+{
+	pca9420_config_t config;
+	int32_t status;
+
+	status = PCA9420_PROFILE_Load(pName, &config);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	return PCA9420_CFG_Reconcile(pSensorHandle, &config, NULL, NULL, pResult);
+}
+
+int32_t PCA9420_PROFILE_Diff(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName, pca9420_cfg_diff_visit_t visit,
+                             void *pUserData, uint32_t *pCount)
+{
+	pca9420_config_t stored, live;
+	int32_t status;
+
+	status = PCA9420_PROFILE_Load(pName, &stored);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCA9420_CFG_Capture(pSensorHandle, &live, stored.regions);
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	*pCount = PCA9420_CFG_Diff(&stored, &live, visit, pUserData);
+	return SENSOR_ERROR_NONE;
+}
+
+const char *PCA9420_PROFILE_GetName(uint32_t slot)
+{
+	const pca9420_profile_t *pProfile = PCA9420_PROFILE_Slot(slot);
+
+	return (pProfile != NULL) ? pProfile->name : NULL;
+}
+
+bool PCA9420_PROFILE_IsPersistent(void)
+{
+	return s_ready && NVM_IsPersistent();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_telemetry.h
+ * @brief The pca9420uk_telemetry.h file describes the PCA9420UK telemetry streaming service.
+
+    A software timer samples the selected PMIC registers with burst reads and emits one
+    frame per sample. A frame is COBS encoded and enclosed in zero bytes, so it can share
+    the debug UART with console text. Decoded, a frame is laid out as
+
+        type(1) sequence(1) timestamp_ms(4, LE) fields(1) payload CRC16(2, LE)
+
+    where the payload holds the selected fields in bit order: TOP_INT(1),
+    CHG_STATUS0..3(4), REG_STATUS(1), active mode(1) + its MODECFG_m_0..3(4).
+    The CRC is CRC-16/CCITT-FALSE over all bytes before it. tools/telemetry_decode.py
+    turns the stream into CSV.
+
+    A keyframe with every field is 20 bytes decoded. COBS adds one byte and the two
+    delimiters two more, so it takes 23 bytes on the wire, about 2.3 kB/s at 100 Hz.
+
+    Status registers rarely change, so after a full sample (a keyframe) the service only
+    sends what differs from the last frame sent. A delta frame has the same header, type
+    0x02, and replaces the payload with (offset, value) pairs, the offset indexing the
+    keyframe payload. A sample without changes sends nothing. Keyframes repeat at the
+    keyframe interval and follow every start, field change and dropped frame, so a host
+    that missed a frame is back in sync at the next keyframe.
+*/
+
+#ifndef PCA9420UK_TELEMETRY_H_
+#define PCA9420UK_TELEMETRY_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Frame types. */
+#define PCA9420_TLM_FRAME_SAMPLE (0x01u) /*!< Full sample, the keyframe. */
+#define PCA9420_TLM_FRAME_DELTA  (0x02u) /*!< Changed bytes against the last frame sent. */
+
+/*! @brief Selectable sample fields. */
+#define PCA9420_TLM_FIELD_TOP_INT    (0x01u) /*!< TOP_INT. */
+#define PCA9420_TLM_FIELD_CHG_STATUS (0x02u) /*!< CHG_STATUS0..3, not on PCA9421. */
+#define PCA9420_TLM_FIELD_REG_STATUS (0x04u) /*!< REG_STATUS. */
+#define PCA9420_TLM_FIELD_MODECFG    (0x08u) /*!< Active mode and its MODECFG_m_0..3. */
+#define PCA9420_TLM_FIELD_ALL        (0x0Fu)
+
+/*! @brief Highest sample rate, one sample per timer tick at most. */
+#define PCA9420_TLM_MAX_RATE_HZ (200u)
+
+/*! @brief Default keyframe interval in milliseconds. */
+#define PCA9420_TLM_DEFAULT_KEYFRAME_MS (1000u)
+
+/*! @brief Largest payload, all fields selected. */
+#define PCA9420_TLM_MAX_PAYLOAD_LEN (1u + 4u + 1u + 5u)
+
+/*! @brief Largest decoded frame: header, payload and the CRC. A delta frame is never longer than a keyframe. */
+#define PCA9420_TLM_MAX_FRAME_LEN (7u + PCA9420_TLM_MAX_PAYLOAD_LEN + 2u)
+
+/*! @brief Sends an encoded frame, returns false when it had to be dropped. */
+typedef bool (*pca9420_tlm_write_t)(const uint8_t *pData, uint32_t length);
+
+/*!
+ * @brief Telemetry statistics.
+ */
+typedef struct
+{
+	uint32_t samples;    /*!< Frames handed to the write function. */
+	uint32_t dropped;    /*!< Frames the write function refused. */
+	uint32_t readErrors; /*!< Samples lost to a failed bus transfer. */
+	uint32_t bytesSent;  /*!< Encoded bytes accepted, delimiters included. */
+	uint32_t keyframes;  /*!< Full samples sent. */
+	uint32_t deltas;     /*!< Delta frames sent. */
+	uint32_t unchanged;  /*!< Samples that matched the last frame and sent nothing. */
+} pca9420_tlm_stats_t;
+
+/*!
+ * @brief Telemetry context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;     /*!< PMIC handle. */
+	pca9420_tlm_write_t write;                     /*!< Frame output. */
+	sw_timer_t timer;                              /*!< Sample timer. */
+	uint32_t period;                               /*!< Sample period in ticks, 0 when stopped. */
+	uint32_t keyframePeriod;                       /*!< Keyframe interval in ticks, 0 sends keyframes only. */
+	uint32_t lastKeyframe;                         /*!< Tick of the last keyframe. */
+	uint16_t rateHz;                               /*!< Sample rate. */
+	uint8_t fields;                                /*!< Selected PCA9420_TLM_FIELD_ bits. */
+	uint8_t sequence;                              /*!< Sequence number of the next frame. */
+	bool snapshotValid;                            /*!< The host holds snapshot, deltas may be sent. */
+	uint8_t snapshotLen;                           /*!< Payload length of snapshot. */
+	uint8_t snapshot[PCA9420_TLM_MAX_PAYLOAD_LEN]; /*!< Payload as last reported. */
+	pca9420_tlm_stats_t stats;                     /*!< Statistics. */
+} pca9420_telemetry_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to initialize the telemetry service.
+ *  @param[in]   pTelemetry     handle to the telemetry context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   write          frame output function.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize() and SW_TIMER_Init().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_TLM_Init() returns the status.
+ */
+int32_t PCA9420_TLM_Init(pca9420_telemetry_t *pTelemetry, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_tlm_write_t write);
+
+/*! @brief       The interface function to start streaming.
+ *  @details     This function (re)starts the sample timer and clears the statistics. The sequence number
+ *               keeps counting, so a host sees a restart as a continuous stream.
+ *  @param[in]   pTelemetry     handle to the telemetry context.
+ *  @param[in]   rateHz         samples per second, 1..PCA9420_TLM_MAX_RATE_HZ.
+ *  @param[in]   fields         PCA9420_TLM_FIELD_ bits to sample.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_TLM_Start() returns the status.
+ */
+int32_t PCA9420_TLM_Start(pca9420_telemetry_t *pTelemetry, uint16_t rateHz, uint8_t fields);
+
+/*! @brief       The interface function to set the keyframe interval.
+ *  @details     Between keyframes only changes are sent. The new interval applies from the next keyframe.
+ *  @param[in]   pTelemetry     handle to the telemetry context.
+ *  @param[in]   intervalMs     keyframe interval in milliseconds, 0 sends every sample as a keyframe.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_TLM_SetKeyframeInterval(pca9420_telemetry_t *pTelemetry, uint32_t intervalMs);
+
+/*! @brief       The interface function to stop streaming.
+ *  @param[in]   pTelemetry     handle to the telemetry context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_TLM_Stop(pca9420_telemetry_t *pTelemetry);
+
+/*! @brief       The interface function to take and send one sample.
+ *  @details     This function is run by the sample timer. It may also be called directly for a single frame.
+ *               A sample equal to the last frame sent produces no frame.
+ *  @param[in]   pTelemetry     handle to the telemetry context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_TLM_Sample() returns the status.
+ */
+int32_t PCA9420_TLM_Sample(pca9420_telemetry_t *pTelemetry);
+
+#endif /* PCA9420UK_TELEMETRY_H_ */
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_thermal.c
+ * @brief The pca9420uk_thermal.c file implements the PCA9420UK charge current thermal governor.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_thermal.h"
+#include "pca9420uk.h"
+#include "pca9420uk_config.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Charge current per ICHG_CC code. */
+#define PCA9420_THERMAL_MA_PER_CODE (5u)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint8_t PCA9420_THERMAL_Ceiling(const pca9420_thermal_t *pThermal)
+{
+	switch (pThermal->zone)
+	{
+	case kPCA9420_TsWarm:
+		return pThermal->config.warmCode;
+	case kPCA9420_TsCold:
+	case kPCA9420_TsHot:
+		return pThermal->config.minCode;
+	default:
+		return pThermal->config.maxCode;
+	}
+}
+
+/* Code in force for the level and the ceiling. */
+static uint8_t PCA9420_THERMAL_Target(const pca9420_thermal_t *pThermal)
+{
+	return (pThermal->level < pThermal->ceiling) ? pThermal->level : pThermal->ceiling;
+}
+
+static void PCA9420_THERMAL_Take(pca9420_thermal_t *pThermal, uint8_t code)
+{
+	pThermal->code = code;
+	if (code < pThermal->lowestCode)
+	{
+		pThermal->lowestCode = code;
+	}
+}
+
+/* Writes ICHG_CC when the target moved, the reconcile carries the CHG_CNTL0 unlock key. */
+static int32_t PCA9420_THERMAL_Write(pca9420_thermal_t *pThermal, uint8_t reason)
+{
+	pca9420_config_t target;
+	uint8_t careMask[PCA9420_CFG_REG_COUNT];
+	uint8_t code = PCA9420_THERMAL_Target(pThermal);
+	int32_t status;
+
+	if (code == pThermal->code)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	memset(&target, 0, sizeof(target));
+	memset(careMask, 0, sizeof(careMask));
+	target.regions = PCA9420_CFG_REGION_CHARGER;
+	target.regs[PCA9420UK_CHG_CNTL1] = code;
+	careMask[PCA9420UK_CHG_CNTL1] = PCA9420_MODE_ICHG_CC_MASK;
+	status = PCA9420_CFG_Reconcile(pThermal->pSensorHandle, &target, careMask, NULL, NULL);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pThermal->busErrors++;
+		return status;
+	}
+
+	PCA9420_EVLOG_Record(kPCA9420_EvlogChargeCurrent, reason, code);
+	PCA9420_THERMAL_Take(pThermal, code);
+	return SENSOR_ERROR_NONE;
+}
+
+/* Reads the TS zone and writes the target, a new ceiling applies at once. */
+static void PCA9420_THERMAL_Zone(pca9420_thermal_t *pThermal, uint8_t reason)
+{
+	uint8_t data;
+
+	if (SENSOR_ERROR_NONE != PCA9420_DRV_BlockRead(pThermal->pSensorHandle, PCA9420UK_CHG_STATUS3, &data, 1u))
+	{
+		pThermal->busErrors++;
+		return;
+	}
+	pThermal->zone = (uint8_t)((data & PCA9420_TEMP_STATUS_MASK) >> PCA9420_TEMP_STATUS_SHIFT);
+	pThermal->ceiling = PCA9420_THERMAL_Ceiling(pThermal);
+	(void)PCA9420_THERMAL_Write(pThermal, reason);
+}
+
+static void PCA9420_THERMAL_Interrupt(uint32_t sources, void *pUserData)
+{
+	pca9420_thermal_t *pThermal = (pca9420_thermal_t *)pUserData;
+	const pca9420_thermal_config_t *pConfig = &pThermal->config;
+	uint32_t now = SW_TIMER_GetTicks();
+
+	if (((sources & kPCA9420_IntSrcChgAll) != 0u) && !pThermal->limited)
+	{
+		PCA9420_THERMAL_Zone(pThermal, kPCA9420_ThermalZone);
+	}
+
+	if ((sources & kPCA9420_IntSrcSysTempWarn) != 0u)
+	{
+		pThermal->warnings++;
+		if ((pThermal->stepsDown == 0u) || ((now - pThermal->lastDown) >= SW_TIMER_MS_TO_TICKS(pConfig->settleMs)))
+		{
+			/* Down from the code in force, a level above it would not cool anything. */
+			pThermal->level = (pThermal->code > (pConfig->minCode + pConfig->downStep))
+			                      ? (uint8_t)(pThermal->code - pConfig->downStep)
+			                      : pConfig->minCode;
+			pThermal->lastDown = now;
+			pThermal->stepsDown++;
+			(void)PCA9420_THERMAL_Write(pThermal, kPCA9420_ThermalDieWarn);
+		}
+		/* Every warning starts the quiet period over. */
+		SW_TIMER_Start(&pThermal->timer, SW_TIMER_MS_TO_TICKS(pConfig->quietMs), 0u);
+	}
+}
+
+/* Quiet period over, one step up. */
+static void PCA9420_THERMAL_Quiet(void *pUserData)
+{
+	pca9420_thermal_t *pThermal = (pca9420_thermal_t *)pUserData;
+	uint32_t level = pThermal->level + pThermal->config.upStep;
+
+	if (pThermal->level < pThermal->config.maxCode)
+	{
+		pThermal->stepsUp++;
+	}
+	pThermal->level = (uint8_t)((level < pThermal->config.maxCode) ? level : pThermal->config.maxCode);
+	if (pThermal->limited)
+	{
+		(void)PCA9420_THERMAL_Write(pThermal, kPCA9420_ThermalQuiet);
+	}
+	else
+	{
+		PCA9420_THERMAL_Zone(pThermal, kPCA9420_ThermalQuiet);
+	}
+	if (pThermal->level < pThermal->config.maxCode)
+	{
+		SW_TIMER_Start(&pThermal->timer, SW_TIMER_MS_TO_TICKS(pThermal->config.quietMs), 0u);
+	}
+}
+
+int32_t PCA9420_THERMAL_Init(pca9420_thermal_t *pThermal, pca9420_irq_t *pIrq, const pca9420_thermal_config_t *pConfig)
+{
+	pca9420_config_t target;
+	uint8_t careMask[PCA9420_CFG_REG_COUNT];
+	uint8_t data;
+	int32_t status;
+
+	if ((pThermal == NULL) || (pIrq == NULL) || (pConfig == NULL) || (pConfig->maxCode > PCA9420_MODE_ICHG_CC_MASK) ||
+	    (pConfig->warmCode > pConfig->maxCode) || (pConfig->minCode > pConfig->warmCode) || (pConfig->downStep == 0u) ||
+	    (pConfig->upStep == 0u) || (pConfig->dieWarn > PCA9420_MODE_DIE_TEMP_MASK) ||
+	    (pConfig->thermalReg > PCA9420_THM_REG_MASK))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pThermal, 0, sizeof(*pThermal));
+	pThermal->pSensorHandle = pIrq->pSensorHandle;
+	pThermal->config = *pConfig;
+	pThermal->level = pConfig->maxCode;
+	SW_TIMER_Setup(&pThermal->timer, PCA9420_THERMAL_Quiet, pThermal);
+
+	status = PCA9420_DRV_BlockRead(pThermal->pSensorHandle, PCA9420UK_CHG_STATUS3, &data, 1u);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	pThermal->zone = (uint8_t)((data & PCA9420_TEMP_STATUS_MASK) >> PCA9420_TEMP_STATUS_SHIFT);
+	pThermal->ceiling = PCA9420_THERMAL_Ceiling(pThermal);
+
+	/* Thresholds and the starting current in one reconcile. */
+	memset(&target, 0, sizeof(target));
+	memset(careMask, 0, sizeof(careMask));
+	target.regions = PCA9420_CFG_REGION_TOP | PCA9420_CFG_REGION_CHARGER;
+	target.regs[PCA9420UK_TOP_CNTL2] = (uint8_t)(pConfig->dieWarn << PCA9420_MODE_DIE_TEMP_SHIFT);
+	careMask[PCA9420UK_TOP_CNTL2] = PCA9420_MODE_DIE_TEMP_MASK;
+	target.regs[PCA9420UK_CHG_CNTL1] = pThermal->ceiling;
+	careMask[PCA9420UK_CHG_CNTL1] = PCA9420_MODE_ICHG_CC_MASK;
+	target.regs[PCA9420UK_CHG_CNTL7] = (uint8_t)(pConfig->thermalReg << PCA9420_THM_REG_SHIFT);
+	careMask[PCA9420UK_CHG_CNTL7] = PCA9420_THM_REG_MASK;
+	status = PCA9420_CFG_Reconcile(pThermal->pSensorHandle, &target, careMask, NULL, NULL);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	pThermal->code = pThermal->ceiling;
+	pThermal->lowestCode = pThermal->ceiling;
+
+	return PCA9420_IRQ_Register(pIrq, kPCA9420_IntSrcSysTempWarn | kPCA9420_IntSrcChgAll, PCA9420_THERMAL_Interrupt,
+	                            pThermal);
+}
+
+uint8_t PCA9420_THERMAL_SetLimit(pca9420_thermal_t *pThermal, uint8_t limitCode)
+{
+	pThermal->ceiling = (limitCode < pThermal->config.maxCode) ? limitCode : pThermal->config.maxCode;
+	pThermal->limited = true;
+	return PCA9420_THERMAL_Target(pThermal);
+}
+
+void PCA9420_THERMAL_Written(pca9420_thermal_t *pThermal, uint8_t code)
+{
+	PCA9420_THERMAL_Take(pThermal, code);
+}
+
+uint32_t PCA9420_THERMAL_GetMa(const pca9420_thermal_t *pThermal)
+{
+	return (uint32_t)pThermal->code * PCA9420_THERMAL_MA_PER_CODE;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_thermal.h
+ * @brief The pca9420uk_thermal.h file describes the PCA9420UK charge current thermal governor.
+
+    The governor charges at the highest ICHG_CC code the thermal state allows, the lower of
+    a die level and a battery ceiling. A die temperature warning sets the level downStep codes
+    under the code in force, warnings sooner than settleMs after a step down are counted but
+    not acted on, so the die has time to respond. Once quietMs pass without a warning, upStep
+    codes are given back, and again after every further quietMs until maxCode. With upStep
+    smaller than downStep a die that keeps warning settles just under its warning threshold
+    instead of oscillating across it.
+
+    The ceiling comes from the TS zone of CHG_STATUS3: maxCode while nominal or cool,
+    warmCode while warm and minCode while cold or hot. It applies at once both ways. The PMIC
+    has no interrupt for zone crossings, the zone is read again on every charger interrupt and
+    before every step up. A charging profile that sets its own current per zone takes over the
+    ceiling with PCA9420_THERMAL_SetLimit(), the governor then leaves the zone to it.
+
+    Everything runs from the interrupt dispatcher, see pca9420uk_irq.h, and a one-shot
+    software timer, nothing polls. The warning threshold is programmed below the thermal
+    regulation one so the governor acts before the charger folds back, both far below thermal
+    shutdown. Each change is recorded in the event log.
+*/
+
+#ifndef PCA9420UK_THERMAL_H_
+#define PCA9420UK_THERMAL_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_irq.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Reasons of the kPCA9420_EvlogChargeCurrent records. */
+enum _pca9420_thermal_reason
+{
+	kPCA9420_ThermalDieWarn = 0u, /*!< Step down on a die temperature warning. */
+	kPCA9420_ThermalQuiet   = 1u, /*!< Step up after a quiet period. */
+	kPCA9420_ThermalZone    = 2u, /*!< Ceiling changed by the TS zone. */
+};
+
+/*!
+ * @brief Governor configuration, codes are enum _pca9420_bat_chrg_cur.
+ */
+typedef struct
+{
+	uint8_t maxCode;    /*!< Code without thermal stress. */
+	uint8_t warmCode;   /*!< Ceiling while the battery is warm. */
+	uint8_t minCode;    /*!< Floor of the steps down, and ceiling while the battery is cold or hot. */
+	uint8_t downStep;   /*!< Codes taken off per warning. */
+	uint8_t upStep;     /*!< Codes given back per quiet period. */
+	uint8_t dieWarn;    /*!< enum _pca9420_die_temp_warning programmed at start. */
+	uint8_t thermalReg; /*!< enum _pca9420_thrml_reg_thshld programmed at start. */
+	uint16_t settleMs;  /*!< Time after a step down during which warnings are not acted on. */
+	uint16_t quietMs;   /*!< Time without warnings before a step up. */
+} pca9420_thermal_config_t;
+
+/*!
+ * @brief Governor context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+	pca9420_thermal_config_t config;           /*!< Configuration in use. */
+	sw_timer_t timer;                          /*!< Quiet period timer. */
+	uint8_t code;                              /*!< ICHG_CC code in force, the lower of level and ceiling. */
+	uint8_t level;                             /*!< Highest code the die temperature allows. */
+	uint8_t ceiling;                           /*!< Highest code the TS zone or the profile allows. */
+	bool limited;                              /*!< A charging profile sets the ceiling. */
+	uint8_t zone;                              /*!< enum _pca9420_ts_status last read, not followed when limited. */
+	uint8_t lowestCode;                        /*!< Lowest code since the start. */
+	uint32_t lastDown;                         /*!< Tick of the last step down. */
+	uint32_t warnings;                         /*!< Die temperature warnings. */
+	uint32_t stepsDown;                        /*!< Steps down on warnings. */
+	uint32_t stepsUp;                          /*!< Steps up after quiet periods. */
+	uint32_t busErrors;                        /*!< Reads or writes that failed. */
+} pca9420_thermal_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start the governor.
+ *  @details     This function programs the die warning and thermal regulation thresholds, reads the TS
+ *               zone, sets the charge current to its ceiling and registers with the dispatcher for the
+ *               die warning and the charger interrupts.
+ *  @param[out]  pThermal       governor context.
+ *  @param[in]   pIrq           interrupt dispatcher.
+ *  @param[in]   pConfig        configuration, copied.
+ *  @constraints SW_TIMER_Init() and PCA9420_IRQ_Init() must have been called. Not on PCA9421. Nothing else may
+ *               write ICHG_CC while the governor runs.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_THERMAL_Init() returns the status, SENSOR_ERROR_INVALID_PARAM when the codes are not
+ *               ordered minCode <= warmCode <= maxCode or a step is zero.
+ */
+int32_t PCA9420_THERMAL_Init(pca9420_thermal_t *pThermal, pca9420_irq_t *pIrq, const pca9420_thermal_config_t *pConfig);
+
+/*! @brief       The interface function to take the ceiling from a charging profile.
+ *  @details     The ceiling becomes limitCode and the TS zone is no longer read. Nothing is written, the
+ *               caller writes the returned code with its own settings and reports it with
+ *               PCA9420_THERMAL_Written(). Until then the code in force stays the one last written.
+ *  @param[in]   pThermal       governor context.
+ *  @param[in]   limitCode      highest code, enum _pca9420_bat_chrg_cur.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_THERMAL_SetLimit() returns the code the caller must write.
+ */
+uint8_t PCA9420_THERMAL_SetLimit(pca9420_thermal_t *pThermal, uint8_t limitCode);
+
+/*! @brief       The interface function to report the code a charging profile wrote.
+ *  @param[in]   pThermal       governor context.
+ *  @param[in]   code           ICHG_CC code now in the PMIC, from PCA9420_THERMAL_SetLimit().
+ *  @constraints Thread context only, only after the write succeeded.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_THERMAL_Written(pca9420_thermal_t *pThermal, uint8_t code);
+
+/*! @brief       The interface function to read the charge current in force.
+ *  @param[in]   pThermal       governor context.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_THERMAL_GetMa() returns the charge current in mA.
+ */
+uint32_t PCA9420_THERMAL_GetMa(const pca9420_thermal_t *pThermal);
+
+#endif /* PCA9420UK_THERMAL_H_ */
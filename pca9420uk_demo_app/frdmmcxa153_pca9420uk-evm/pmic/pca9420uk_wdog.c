@@ -0,0 +1,209 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_wdog.c
+ * @brief The pca9420uk_wdog.c file implements the PCA9420UK watchdog keeper service.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include "pca9420uk_wdog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PCA9420_WDOG_TIMEOUT_16S_MS (16000u)
+
+/* Register distance of two mode banks. */
+#define PCA9420_WDOG_BANK_STRIDE (PCA9420UK_MODECFG_1_3 - PCA9420UK_MODECFG_0_3)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static int32_t PCA9420_WDOG_Kick(pca9420_wdog_keeper_t *pKeeper, bool coalesced)
+{
+	int32_t status;
+	uint32_t now, elapsed;
+
+	status = PCA9420_wtchdg_timer_reset(pKeeper->pSensorHandle);
+	now = SW_TIMER_GetTicks();
+	if (SENSOR_ERROR_NONE != status)
+	{
+		/* The deadline has not moved, try again shortly. */
+		pKeeper->stats.busErrors++;
+		SW_TIMER_Start(&pKeeper->timer, SW_TIMER_MS_TO_TICKS(PCA9420_WDOG_RETRY_MS), 0);
+		return status;
+	}
+
+	elapsed = now - pKeeper->lastKick;
+	if (elapsed > pKeeper->timeout)
+	{
+		pKeeper->stats.missedDeadlines++;
+		pKeeper->stats.lastMargin = 0;
+		pKeeper->stats.minMargin = 0;
+		if (pKeeper->missCallback != NULL)
+		{
+			pKeeper->missCallback(elapsed - pKeeper->timeout, pKeeper->pUserData);
+		}
+	}
+	else
+	{
+		pKeeper->stats.lastMargin = pKeeper->timeout - elapsed;
+		if (pKeeper->stats.lastMargin < pKeeper->stats.minMargin)
+		{
+			pKeeper->stats.minMargin = pKeeper->stats.lastMargin;
+		}
+	}
+
+	pKeeper->stats.kicks++;
+	if (coalesced)
+	{
+		pKeeper->stats.coalescedKicks++;
+	}
+
+	pKeeper->lastKick = now;
+	pKeeper->dueKick = now + pKeeper->interval;
+	SW_TIMER_Start(&pKeeper->timer, pKeeper->interval, 0);
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Reads the active mode and its watchdog setting. Plain register reads, a bus error must not mark the
+ * shared PMIC handle uninitialized and stop every later kick with it. */
+static int32_t PCA9420_WDOG_ReadSetting(pca9420_wdog_keeper_t *pKeeper, enum _pca9420_mode *pMode,
+                                        enum _pca9420_wd_timer *pWdTimer)
+{
+	pca9420_i2c_sensorhandle_t *pHandle = pKeeper->pSensorHandle;
+	uint8_t reg;
+
+	if (ARM_DRIVER_OK != Register_I2C_Read(pHandle->pCommDrv, &pHandle->deviceInfo, pHandle->slaveAddress,
+	                                       PCA9420UK_TOP_CNTL3, PCA9420UK_REG_SIZE_BYTES, &reg))
+	{
+		return SENSOR_ERROR_READ;
+	}
+	*pMode = (enum _pca9420_mode)((reg & PCA9420_MODE_CNTL_SEL_MASK) >> PCA9420_MODE_CNTL_SEL_SHIFT);
+
+	if (ARM_DRIVER_OK != Register_I2C_Read(pHandle->pCommDrv, &pHandle->deviceInfo, pHandle->slaveAddress,
+	                                       (uint8_t)(PCA9420UK_MODECFG_0_3 + *pMode * PCA9420_WDOG_BANK_STRIDE),
+	                                       PCA9420UK_REG_SIZE_BYTES, &reg))
+	{
+		return SENSOR_ERROR_READ;
+	}
+	*pWdTimer = (enum _pca9420_wd_timer)((reg & PCA9420_MODE_WD_TIMER_MASK) >> PCA9420_MODE_WD_TIMER_SHIFT);
+
+	return SENSOR_ERROR_NONE;
+}
+
+static void PCA9420_WDOG_TimerCallback(void *pUserData)
+{
+	pca9420_wdog_keeper_t *pKeeper = (pca9420_wdog_keeper_t *)pUserData;
+	uint32_t lateness = SW_TIMER_GetTicks() - pKeeper->dueKick;
+
+	if (pKeeper->refreshPending)
+	{
+		(void)PCA9420_WDOG_Refresh(pKeeper);
+		return;
+	}
+
+	/* Retries after a bus error fire before the due tick. */
+	if ((lateness < pKeeper->timeout) && (lateness > pKeeper->stats.maxLateness))
+	{
+		pKeeper->stats.maxLateness = lateness;
+	}
+
+	PCA9420_WDOG_Kick(pKeeper, false);
+}
+
+int32_t PCA9420_WDOG_Init(pca9420_wdog_keeper_t *pKeeper, pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t kickPercent,
+                          pca9420_wdog_miss_callback_t missCallback, void *pUserData)
+{
+	/*! Validate for the correct handle and kick point.*/
+	if ((pKeeper == NULL) || (pSensorHandle == NULL) || (kickPercent == 0) || (kickPercent > 90))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	pKeeper->pSensorHandle = pSensorHandle;
+	pKeeper->kickPercent = kickPercent;
+	pKeeper->missCallback = missCallback;
+	pKeeper->pUserData = pUserData;
+	pKeeper->timeout = 0;
+	pKeeper->interval = 0;
+	pKeeper->refreshPending = false;
+	SW_TIMER_Setup(&pKeeper->timer, PCA9420_WDOG_TimerCallback, pKeeper);
+
+	return PCA9420_WDOG_Refresh(pKeeper);
+}
+
+int32_t PCA9420_WDOG_Refresh(pca9420_wdog_keeper_t *pKeeper)
+{
+	int32_t status;
+	enum _pca9420_mode mode;
+	enum _pca9420_wd_timer wdTimer;
+
+	if (pKeeper == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCA9420_WDOG_ReadSetting(pKeeper, &mode, &wdTimer);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		/* Keep the timeout in force, the retry kicks with it once the setting reads. */
+		pKeeper->stats.busErrors++;
+		pKeeper->refreshPending = true;
+		SW_TIMER_Start(&pKeeper->timer, SW_TIMER_MS_TO_TICKS(PCA9420_WDOG_RETRY_MS), 0);
+		return status;
+	}
+
+	SW_TIMER_Stop(&pKeeper->timer);
+	pKeeper->refreshPending = false;
+	pKeeper->mode = mode;
+	pKeeper->stats.minMargin = UINT32_MAX;
+	pKeeper->stats.maxLateness = 0;
+	if (wdTimer == kPCA9420_WdTimerDisabled)
+	{
+		pKeeper->timeout = 0;
+		pKeeper->interval = 0;
+		return SENSOR_ERROR_NONE;
+	}
+
+	/* 16 s, 32 s or 64 s. */
+	pKeeper->timeout = SW_TIMER_MS_TO_TICKS(PCA9420_WDOG_TIMEOUT_16S_MS) << (wdTimer - kPCA9420_WdTimer16s);
+	pKeeper->interval = pKeeper->timeout / 100u * pKeeper->kickPercent;
+
+	/* The last kick time is unknown, count the margin from now. */
+	pKeeper->lastKick = SW_TIMER_GetTicks();
+
+	return PCA9420_WDOG_Kick(pKeeper, false);
+}
+
+int32_t PCA9420_WDOG_Coalesce(pca9420_wdog_keeper_t *pKeeper)
+{
+	if ((pKeeper == NULL) || (pKeeper->timeout == 0) || pKeeper->refreshPending)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	if ((SW_TIMER_GetTicks() - pKeeper->lastKick) < (pKeeper->interval / 2u))
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	return PCA9420_WDOG_Kick(pKeeper, true);
+}
+
+void PCA9420_WDOG_Stop(pca9420_wdog_keeper_t *pKeeper)
+{
+	if (pKeeper != NULL)
+	{
+		SW_TIMER_Stop(&pKeeper->timer);
+		pKeeper->timeout = 0;
+		pKeeper->refreshPending = false;
+	}
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_wdog.h
+ * @brief The pca9420uk_wdog.h file describes the PCA9420UK watchdog keeper service.
+
+    The keeper reads the watchdog timeout of the active mode and kicks the PMIC watchdog
+    from a software timer at a configurable fraction of it. Kicks are pulled forward to
+    piggyback on other PMIC traffic once half of the kick interval has passed.
+*/
+
+#ifndef PCA9420UK_WDOG_H_
+#define PCA9420UK_WDOG_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Default kick point in percent of the watchdog timeout. */
+#define PCA9420_WDOG_DEFAULT_KICK_PERCENT (50u)
+
+/*! @brief Retry delay after a failed kick. */
+#define PCA9420_WDOG_RETRY_MS (100u)
+
+/*! @brief Called when a kick happened after the watchdog deadline, lateTicks past the deadline. */
+typedef void (*pca9420_wdog_miss_callback_t)(uint32_t lateTicks, void *pUserData);
+
+/*!
+ * @brief Watchdog keeper statistics, times in timer ticks.
+ */
+typedef struct
+{
+    uint32_t kicks;           /*!< Successful kicks. */
+    uint32_t coalescedKicks;  /*!< Kicks that rode on other PMIC traffic. */
+    uint32_t missedDeadlines; /*!< Kicks issued after the watchdog deadline. */
+    uint32_t busErrors;       /*!< Failed kick and refresh transfers. */
+    uint32_t lastMargin;      /*!< Time left to the deadline at the last kick. */
+    uint32_t minMargin;       /*!< Smallest margin seen since the last refresh. */
+    uint32_t maxLateness;     /*!< Largest delay of a scheduled kick behind its due time. */
+} pca9420_wdog_stats_t;
+
+/*!
+ * @brief Watchdog keeper context.
+ */
+typedef struct
+{
+    pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+    sw_timer_t timer;                          /*!< Kick timer. */
+    enum _pca9420_mode mode;                   /*!< Mode the timeout was read for. */
+    uint32_t timeout;                          /*!< Watchdog timeout, 0 when disabled. */
+    uint32_t interval;                         /*!< Scheduled kick interval. */
+    uint32_t lastKick;                         /*!< Tick of the last successful kick. */
+    uint32_t dueKick;                          /*!< Tick the scheduled kick is due. */
+    uint8_t kickPercent;                       /*!< Kick point in percent of the timeout. */
+    bool refreshPending;                       /*!< A refresh failed on the bus, the timer retries it. */
+    pca9420_wdog_miss_callback_t missCallback; /*!< Missed deadline callback, may be NULL. */
+    void *pUserData;                           /*!< Argument of the callback. */
+    pca9420_wdog_stats_t stats;                /*!< Statistics. */
+} pca9420_wdog_keeper_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start the watchdog keeper.
+ *  @details     This function binds the keeper to the PMIC, reads the active watchdog timeout,
+ *               kicks once and schedules the next kick.
+ *  @param[in]   pKeeper        handle to the keeper context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   kickPercent    kick point in percent of the timeout (1..90).
+ *  @param[in]   missCallback   function called on a missed deadline, may be NULL.
+ *  @param[in]   pUserData      argument passed to missCallback.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize() and SW_TIMER_Init().
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_WDOG_Init() returns the status.
+ */
+int32_t PCA9420_WDOG_Init(pca9420_wdog_keeper_t *pKeeper, pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t kickPercent,
+                          pca9420_wdog_miss_callback_t missCallback, void *pUserData);
+
+/*! @brief       The interface function to reload the watchdog setting.
+ *  @details     This function re-reads the active mode and its watchdog timeout from MODECFG, kicks
+ *               and reschedules. The keeper goes idle while the watchdog is disabled. When a read
+ *               fails the timeout in force is kept and the refresh is retried after PCA9420_WDOG_RETRY_MS.
+ *  @param[in]   pKeeper        handle to the keeper context.
+ *  @constraints Call after every mode change or PCA9420_Set_wtchdg_timer() call.
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_WDOG_Refresh() returns the status.
+ */
+int32_t PCA9420_WDOG_Refresh(pca9420_wdog_keeper_t *pKeeper);
+
+/*! @brief       The interface function to kick opportunistically.
+ *  @details     This function kicks the watchdog right away when at least half of the kick interval has
+ *               passed, so the kick shares the bus activity of the caller and the scheduled kick moves out.
+ *               Otherwise it does not touch the bus.
+ *  @param[in]   pKeeper        handle to the keeper context.
+ *  @constraints Call next to other PMIC transfers, from thread context.
+ *               Application has to ensure that previous instances of these APIs have exited before invocation.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_WDOG_Coalesce() returns the status.
+ */
+int32_t PCA9420_WDOG_Coalesce(pca9420_wdog_keeper_t *pKeeper);
+
+/*! @brief       The interface function to stop the watchdog keeper.
+ *  @details     This function cancels the kick timer. The PMIC watchdog setting is left untouched.
+ *  @param[in]   pKeeper        handle to the keeper context.
+ *  @constraints None.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_WDOG_Stop(pca9420_wdog_keeper_t *pKeeper);
+
+#endif /* PCA9420UK_WDOG_H_ */
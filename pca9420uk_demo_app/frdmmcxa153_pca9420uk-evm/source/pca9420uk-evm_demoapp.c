@@ -16,6 +16,7 @@
 #include "pin_mux.h"
 #include "clock_config.h"
 #include "board.h"
+#include "fsl_lpuart.h"
 #include "fsl_debug_console.h"
 #include "RTE_Device.h"
 #include "stdio.h"
@@ -34,7 +35,31 @@
 #include "gpio_driver.h"
 #include "../pmic/pca9420uk_drv.h"
 #include "../pmic/pca9420uk.h"
+#include "../pmic/pca9420uk_wdog.h"
+#include "../pmic/pca9420uk_cli.h"
+#include "../pmic/pca9420uk_telemetry.h"
+#include "../pmic/pca9420uk_evlog.h"
+#include "../pmic/pca9420uk_config.h"
+#include "../pmic/pca9420uk_profile.h"
+#include "../pmic/pca9420uk_dvfs.h"
+#include "../pmic/pca9420uk_lowpower.h"
+#include "../pmic/pca9420uk_energy.h"
+#include "../pmic/pca9420uk_sequence.h"
+#include "../pmic/pca9420uk_irq.h"
+#include "../pmic/pca9420uk_thermal.h"
+#include "../pmic/pca9420uk_jeita.h"
+#include "../pmic/pca9420uk_ilim.h"
+#include "../pmic/pca9420uk_chgprof.h"
+#include "../pmic/pca9420uk_brownout.h"
+#include "fsl_spc.h"
 #include "systick_utils.h"
+#include "sw_timer.h"
+#include "trace_log.h"
+#include "fixed_point.h"
+#include "event_loop.h"
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+#include "debug_console_dma.h"
+#endif
 
 //-----------------------------------------------------------------------
 // CMSIS Includes
@@ -45,6 +70,37 @@
 //-----------------------------------------------------------------------
 // Macros
 //-----------------------------------------------------------------------
+/* Event loop event numbers, lower numbers are served first. */
+#define DEMO_EVENT_PMIC_INT   (0U)
+#define DEMO_EVENT_CONSOLE_RX (1U)
+
+/* Budget from clock setup to configured rails. */
+#define DEMO_BOOT_RAILS_TARGET_US (5000U)
+
+/* Interval of the configuration read-back check. */
+#define DEMO_VERIFY_PERIOD_MS (10000U)
+
+/* Wait after the PMIC switches to and from the low-power mode bank, for SW1 to reach its new level. */
+#define DEMO_LP_MODE_SETTLE_US (200U)
+
+/* SW1 of the lowest DVFS point. The core keeps running in the low-power mode bank, SW1 goes no lower. */
+#define DEMO_LP_SW1_OUT kPCA9420_Sw1OutVolt1V000
+
+/* Power-good timeout of a rail sequence, and LDO2 discharge time before SW2 goes off. */
+#define DEMO_SEQ_GOOD_TIMEOUT_MS (5U)
+#define DEMO_SEQ_DISCHARGE_MS    (2U)
+
+/* MCU power states of the energy model. */
+#define DEMO_MCU_RUN        (0U)
+#define DEMO_MCU_SLEEP      (1U)
+#define DEMO_MCU_DEEP_SLEEP (2U)
+
+/* Battery capacity behind the time to full estimate until a charge session has been learnt. */
+#define DEMO_BATTERY_MAH (200U)
+
+/* INT pin interrupt priority, below the I2C interrupt that completes the brown-out transfers. */
+#define DEMO_PMIC_INT_PRIORITY (1U)
+
 enum _pca9420_thrml_reg_thshld epca9420_thrml_reg_thshld;
 enum _pca9420_ntc_beta_val epca9420_ntc_beta_val;
 enum _pca9420_ntc_res_sel epca9420_ntc_res_sel;
@@ -80,18 +136,425 @@ ARM_DRIVER_I2C *I2Cdrv = &I2C_S_DRIVER;
 GENERIC_DRIVER_GPIO *pGpioDriver = &Driver_GPIO_KSDK;
 
 pca9420_i2c_sensorhandle_t pca9420Driver;
+pca9420_wdog_keeper_t pca9420Wdog;
+pca9420_cli_t pca9420Cli;
+pca9420_telemetry_t pca9420Telemetry;
+pca9420_cfg_verify_t pca9420Verify;
+sw_timer_t pca9420VerifyTimer;
+pca9420_dvfs_t pca9420Dvfs;
+pca9420_lp_t pca9420LowPower;
+pca9420_energy_t pca9420Energy;
+sw_timer_t pca9420EnergyTimer;
+pca9420_seq_t pca9420Sequence;
+pca9420_irq_t pca9420Irq;
+pca9420_brownout_t pca9420Brownout;
+const gpio_dispatch_entry_t *pca9420IntStats;
+volatile bool pca9420BrownoutReport;
+
+/* Below 3.3 V on ASYS, LDO2 and the peripherals behind it go off within 500 us of the INT pin
+ * edge. SW1, SW2 and LDO1 keep the MCU core, its I/O and the always-on logic up. */
+const pca9420_brownout_config_t pca9420BrownoutConfig = {
+	.prewarn   = kPCA9420_AsysPreWarn3V3,
+	.shedRails = PCA9420_LDO2_EN_MASK,
+	.budgetUs  = 500U,
+};
+#if (!PCA9421UK_EVM_EN)
+pca9420_thermal_t pca9420Thermal;
+
+/* Charge at 200 mA while cool enough, 40 mA off per die warning at 80C and 10 mA back per
+ * 30 s without one. The charger folds back on its own at 100C, shutdown is higher still. */
+const pca9420_thermal_config_t pca9420ThermalConfig = {
+	.maxCode    = kPCA9420_ICHG_CC_200,
+	.warmCode   = kPCA9420_ICHG_CC_100,
+	.minCode    = kPCA9420_ICHG_CC_50,
+	.downStep   = 8U,
+	.upStep     = 2U,
+	.dieWarn    = kPCA9420_DieTempWarn80C,
+	.thermalReg = kPCA9420_THM_REG_100,
+	.settleMs   = 2000U,
+	.quietMs    = 30000U,
+};
+
+pca9420_jeita_t pca9420Jeita;
+
+/* Charger settings by TS zone: nominal, cold, cool, warm, hot. Half the current when cool or
+ * warm, 100 mV less regulation voltage when warm, no charging when cold or hot. */
+const pca9420_jeita_profile_t pca9420JeitaProfile = {
+	.zones =
+	    {
+	        {1U, kPCA9420_ICHG_CC_200, kPCA9420_ICHG_TOPOFF_8, kPCA9420_VBATREG_4_20, kPCA9420_VBAT_RESTART_140},
+	        {0U, kPCA9420_ICHG_CC_0, kPCA9420_ICHG_TOPOFF_8, kPCA9420_VBATREG_4_20, kPCA9420_VBAT_RESTART_140},
+	        {1U, kPCA9420_ICHG_CC_100, kPCA9420_ICHG_TOPOFF_8, kPCA9420_VBATREG_4_20, kPCA9420_VBAT_RESTART_140},
+	        {1U, kPCA9420_ICHG_CC_100, kPCA9420_ICHG_TOPOFF_8, kPCA9420_VBATREG_4_10, kPCA9420_VBAT_RESTART_140},
+	        {0U, kPCA9420_ICHG_CC_0, kPCA9420_ICHG_TOPOFF_8, kPCA9420_VBATREG_4_20, kPCA9420_VBAT_RESTART_140},
+	    },
+};
+
+pca9420_ilim_t pca9420Ilim;
+
+/* 425 mA until the adapter sags, then 85 mA for 30 s before the next try. Tries that fail
+ * within 10 s double the wait up to 10 minutes. */
+const pca9420_ilim_config_t pca9420IlimConfig = {
+	.clearMs      = 1000U,
+	.stableMs     = 10000U,
+	.backoffMs    = 30000U,
+	.maxBackoffMs = 600000U,
+};
+
+pca9420_chgprof_t pca9420ChgProf;
+#endif
+
+/* Load per rail in uA, by MCU state run, sleep, deep sleep. Bench figures of the EVM with the
+ * MCU core on SW1, I/O on SW2, always-on logic on LDO1 and peripherals on LDO2. */
+const pca9420_energy_model_t pca9420EnergyModel = {
+	.loadUa =
+	    {
+	        {8000U, 2500U, 60U},
+	        {3000U, 1500U, 100U},
+	        {200U, 200U, 50U},
+	        {5000U, 5000U, 0U},
+	    },
+};
+
+/* Boot profile, applied before the console comes up. Every mode runs SW1 1.1 V, SW2 1.8 V,
+ * LDO1 1.8 V and LDO2 3.3 V with all four rails on, all PMIC interrupts are unmasked. The
+ * charger runs the nominal JEITA zone settings with NTC and safety timers on. */
+#if (!PCA9421UK_EVM_EN)
+#define DEMO_BOOT_REGIONS (PCA9420_CFG_REGION_INT_MASK | PCA9420_CFG_REGION_CHARGER | PCA9420_CFG_REGION_MODECFG)
+#else
+#define DEMO_BOOT_REGIONS (PCA9420_CFG_REGION_INT_MASK | PCA9420_CFG_REGION_MODECFG)
+#endif
+const pca9420_config_t pca9420BootProfile = {
+	.regions = DEMO_BOOT_REGIONS,
+	.regs =
+	    {
+	        [PCA9420UK_SUB_INT0_MASK] = 0x00, [PCA9420UK_SUB_INT1_MASK] = 0x00, [PCA9420UK_SUB_INT2_MASK] = 0x00,
+#if (!PCA9421UK_EVM_EN)
+	        [PCA9420UK_CHG_CNTL0] = PCA9420_NTC_EN_MASK | PCA9420_CHG_TIMER_EN_MASK | PCA9420_CHG_EN_MASK,
+	        [PCA9420UK_CHG_CNTL1] = kPCA9420_ICHG_CC_200,
+	        [PCA9420UK_CHG_CNTL2] = kPCA9420_ICHG_TOPOFF_8,
+	        [PCA9420UK_CHG_CNTL5] = (kPCA9420_VBAT_RESTART_140 << PCA9420_VBAT_RESTART_SHIFT) | kPCA9420_VBATREG_4_20,
+	        [PCA9420UK_CHG_CNTL7] = kPCA9420_THM_REG_100 << PCA9420_THM_REG_SHIFT,
+#endif
+	        [PCA9420UK_MODECFG_0_0] = 0x18,   [PCA9420UK_MODECFG_0_1] = 0x0C,   [PCA9420UK_MODECFG_0_2] = 0x4F,
+	        [PCA9420UK_MODECFG_0_3] = 0x38,   [PCA9420UK_MODECFG_1_0] = 0x18,   [PCA9420UK_MODECFG_1_1] = 0x0C,
+	        [PCA9420UK_MODECFG_1_2] = 0x4F,   [PCA9420UK_MODECFG_1_3] = 0x38,   [PCA9420UK_MODECFG_2_0] = 0x18,
+	        [PCA9420UK_MODECFG_2_1] = 0x0C,   [PCA9420UK_MODECFG_2_2] = 0x4F,   [PCA9420UK_MODECFG_2_3] = 0x38,
+	        [PCA9420UK_MODECFG_3_0] = 0x18,   [PCA9420UK_MODECFG_3_1] = 0x0C,   [PCA9420UK_MODECFG_3_2] = 0x4F,
+	        [PCA9420UK_MODECFG_3_3] = 0x38,
+	    },
+};
+
+/* Fields the boot profile owns. SHIP_EN, MODE_CTRL_SEL, ON_CFG, the PMIC watchdog timer and the
+ * charger fields not set above keep their live value. */
+#define DEMO_BOOT_MODECFG_CARE(mode)                                                                          \
+	[PCA9420UK_MODECFG_0_0 + 4 * (mode)] = PCA9420_MODECFG_0_SW1_OUT_MASK,                                    \
+	[PCA9420UK_MODECFG_0_1 + 4 * (mode)] = PCA9420_MODECFG_1_SW2_OUT_MASK,                                    \
+	[PCA9420UK_MODECFG_0_2 + 4 * (mode)] = PCA9420_MODECFG_2_LDO1_OUT_MASK | PCA9420_SW1_EN_MASK |              \
+	                                       PCA9420_SW2_EN_MASK | PCA9420_LDO1_EN_MASK | PCA9420_LDO2_EN_MASK, \
+	[PCA9420UK_MODECFG_0_3 + 4 * (mode)] = PCA9420_MODECFG_3_LDO2_OUT_MASK
+const uint8_t pca9420BootCare[PCA9420_CFG_REG_COUNT] = {
+	[PCA9420UK_SUB_INT0_MASK] = 0xFF,
+	[PCA9420UK_SUB_INT1_MASK] = 0xFF,
+	[PCA9420UK_SUB_INT2_MASK] = 0xFF,
+#if (!PCA9421UK_EVM_EN)
+	[PCA9420UK_CHG_CNTL0] = PCA9420_NTC_EN_MASK | PCA9420_CHG_TIMER_EN_MASK | PCA9420_CHG_EN_MASK,
+	[PCA9420UK_CHG_CNTL1] = PCA9420_MODE_ICHG_CC_MASK,
+	[PCA9420UK_CHG_CNTL2] = PCA9420_MODE_ICHG_TOPOFF_MASK,
+	[PCA9420UK_CHG_CNTL5] = PCA9420_VBAT_RESTART_MASK | PCA9420_VBAT_REG_MASK,
+	[PCA9420UK_CHG_CNTL7] = PCA9420_THM_REG_MASK,
+#endif
+	DEMO_BOOT_MODECFG_CARE(0),
+	DEMO_BOOT_MODECFG_CARE(1),
+	DEMO_BOOT_MODECFG_CARE(2),
+	DEMO_BOOT_MODECFG_CARE(3),
+};
+
+/* Operating points, FRO96M is the boot clock. SW1 follows the core LDO level with 100 mV per step. */
+const pca9420_dvfs_opp_t pca9420DvfsTable[] = {
+	{"12m", BOARD_BOOTCLOCKFRO12M_CORE_CLOCK, BOARD_BootClockFRO12M, kSPC_CoreLDO_MidDriveVoltage, DEMO_LP_SW1_OUT},
+	{"48m", BOARD_BOOTCLOCKFRO48M_CORE_CLOCK, BOARD_BootClockFRO48M, kSPC_CoreLDO_MidDriveVoltage, kPCA9420_Sw1OutVolt1V000},
+	{"64m", BOARD_BOOTCLOCKFRO64M_CORE_CLOCK, BOARD_BootClockFRO64M, kSPC_CoreLDO_NormalVoltage, kPCA9420_Sw1OutVolt1V100},
+	{"96m", BOARD_BOOTCLOCKFRO96M_CORE_CLOCK, BOARD_BootClockFRO96M, kSPC_CoreLDO_NormalVoltage, kPCA9420_Sw1OutVolt1V100},
+};
 
 //-----------------------------------------------------------------------
 // Functions
 //-----------------------------------------------------------------------
-void PCA9420_INT1_ISR(void)
+void pca9420_wdog_missed(uint32_t lateTicks, void *pUserData)
+{
+	TRACE_LOG("\r\n\033[31m Watchdog kick missed its deadline by %u ms!!! \033[37m", lateTicks * 1000u / SW_TIMER_TICK_HZ);
+	PCA9420_EVLOG_Record(kPCA9420_EvlogWdogMiss, 0, (uint16_t)(lateTicks * 1000u / SW_TIMER_TICK_HZ));
+}
+
+/* DVFS core regulator hook, the core runs from the LDO. */
+void pca9420_dvfs_core_level(uint8_t level)
+{
+	(void)SPC_SetActiveModeCoreLDORegulatorVoltageLevel(SPC0, (spc_core_ldo_voltage_level_t)level);
+}
+
+/* Read-back mismatch, one call per register and check until it is restored or acknowledged. The
+ * event log takes the start of each drift. */
+void pca9420_verify_mismatch(uint8_t address, uint8_t expected, uint8_t actual, void *pUserData)
+{
+	if (expected == actual)
+	{
+		TRACE_LOG("\r\n Register 0x%02X reads 0x%02X again.", address, actual);
+		return;
+	}
+	TRACE_LOG("\r\n\033[31m Register 0x%02X reads 0x%02X, configured 0x%02X!!! \033[37m", address, actual, expected);
+	if (!PCA9420_CFG_VERIFY_DRIFTING(&pca9420Verify, address))
+	{
+		PCA9420_EVLOG_Record(kPCA9420_EvlogConfigDrift, address, (uint16_t)((expected << 8) | actual));
+	}
+}
+
+/* Periodic integrity check. The demo's own writes move the reference, see pca9420_write_noted(). */
+void pca9420_verify_timer(void *pUserData)
+{
+	uint32_t mismatches;
+
+	(void)PCA9420_CFG_Verify(&pca9420Driver, &pca9420Verify, pca9420_verify_mismatch, NULL, &mismatches);
+}
+
+/* Driver write listener, thread context like every driver write, the watchdog kicks included: they run
+ * from SW_TIMER_Process() on the event loop. Never called from an interrupt, the brown-out part reads
+ * over the bus. */
+void pca9420_write_noted(uint8_t address, uint8_t length, void *pUserData)
+{
+	PCA9420_CFG_VerifyNoteWrite(&pca9420Verify, address, length);
+	/* Bulk rail writes bypass the event log, the energy model reads them back from the event loop. */
+	if (PCA9420_ENERGY_NoteWrite(&pca9420Energy, address, length))
+	{
+		SW_TIMER_Start(&pca9420EnergyTimer, 1u, 0u);
+	}
+	/* The shed command follows the mode bank and its enable register. */
+	PCA9420_BROWNOUT_NoteWrite(&pca9420Brownout, address, length);
+}
+
+/* Energy model refresh after a rail or mode write, see pca9420_write_noted(). */
+void pca9420_energy_timer(void *pUserData)
+{
+	(void)PCA9420_ENERGY_Refresh(&pca9420Energy, &pca9420Driver);
+}
+
+/* Last low-power step, the SPC low-power request output signals MCU deep sleep. The read-back
+ * check pauses meanwhile, the PMIC runs from a bank that differs from the reference. */
+int32_t pca9420_lp_mcu(bool entering, void *pUserData)
+{
+	static bool verifying;
+	const spc_lowpower_request_config_t config = {
+	    .enable = entering, .polarity = kSPC_HighTruePolarity, .override = kSPC_LowPowerRequestNotForced};
+
+	if (entering)
+	{
+		verifying = SW_TIMER_IsActive(&pca9420VerifyTimer);
+		SW_TIMER_Stop(&pca9420VerifyTimer);
+		/* The sequence cache holds the staged mode bank, no need to read it back. */
+		PCA9420_ENERGY_SetRails(&pca9420Energy, &pca9420LowPower.live);
+	}
+	SPC_SetLowPowerRequestConfig(SPC0, &config);
+	PCA9420_ENERGY_SetMcuState(&pca9420Energy, entering ? DEMO_MCU_DEEP_SLEEP : DEMO_MCU_RUN);
+	if (!entering && verifying)
+	{
+		SW_TIMER_Start(&pca9420VerifyTimer, SW_TIMER_MS_TO_TICKS(DEMO_VERIFY_PERIOD_MS), SW_TIMER_MS_TO_TICKS(DEMO_VERIFY_PERIOD_MS));
+	}
+	return SENSOR_ERROR_NONE;
+}
+
+/* Low-power sequence, run once DVFS is at its lowest point: mode 3 is staged with SW1 at that
+ * point's voltage and SW2 and LDO2 off, their bleed resistors discharge them, then the PMIC
+ * switches to mode 3 and the MCU arms its request. */
+const pca9420_lp_step_t pca9420LowPowerSteps[] = {
+	PCA9420_LP_REGISTER(PCA9420UK_MODECFG_3_0, PCA9420_MODECFG_0_SW1_OUT_MASK, DEMO_LP_SW1_OUT, 0U),
+	PCA9420_LP_REGISTER(PCA9420UK_MODECFG_3_2, PCA9420_SW2_EN_MASK | PCA9420_LDO2_EN_MASK, 0U, 0U),
+	PCA9420_LP_REGISTER(PCA9420UK_ACT_DIS_CNTL_1, kPCA9420_RegCtlSw2Bleed | kPCA9420_RegCtlLdo2Bleed, 0U, 0U),
+	PCA9420_LP_REGISTER(PCA9420UK_TOP_CNTL3, PCA9420_TOP_CNTL3_MODE_I2C_MASK, kPCA9420_ModeI2cMode3, DEMO_LP_MODE_SETTLE_US),
+	PCA9420_LP_HOOK(pca9420_lp_mcu, NULL, 0U),
+};
+
+/* Peripheral rails of the boot mode: SW2 feeds the I/O and must be good before LDO2 feeds the
+ * peripherals behind it, teardown runs the other way round and lets LDO2 discharge first. */
+const pca9420_seq_step_t pca9420RailUpSteps[] = {
+	PCA9420_SEQ_VOLTAGE(kPCA9420_Mode0, kPCA9420_SW2, 1800U),
+	PCA9420_SEQ_ON(kPCA9420_Mode0, kPCA9420_SW2),
+	PCA9420_SEQ_WAIT_GOOD(kPCA9420_RegStatusVoutSw2OK, DEMO_SEQ_GOOD_TIMEOUT_MS),
+	PCA9420_SEQ_VOLTAGE(kPCA9420_Mode0, kPCA9420_LDO2, 3300U),
+	PCA9420_SEQ_ON(kPCA9420_Mode0, kPCA9420_LDO2),
+	PCA9420_SEQ_WAIT_GOOD(kPCA9420_RegStatusVoutLdo2OK, DEMO_SEQ_GOOD_TIMEOUT_MS),
+};
+
+const pca9420_seq_step_t pca9420RailDownSteps[] = {
+	PCA9420_SEQ_OFF(kPCA9420_Mode0, kPCA9420_LDO2),
+	PCA9420_SEQ_DELAY(DEMO_SEQ_DISCHARGE_MS),
+	PCA9420_SEQ_OFF(kPCA9420_Mode0, kPCA9420_SW2),
+};
+
+const pca9420_seq_table_t pca9420RailSequences[] = {
+	{"up", pca9420RailUpSteps, ARRAY_SIZE(pca9420RailUpSteps)},
+	{"down", pca9420RailDownSteps, ARRAY_SIZE(pca9420RailDownSteps)},
+};
+
+/* Rail sequence end. Its writes reach the read-back reference and the shed command through pca9420_write_noted(). */
+void pca9420_seq_done(uint8_t sequence, int32_t status, uint8_t failedStep, void *pUserData)
+{
+	if (SENSOR_ERROR_NONE != status)
+	{
+		TRACE_LOG("\r\n\033[31m Rail sequence %u stopped at step %u (%d)!!! \033[37m", sequence, failedStep, (int)status);
+	}
+}
+
+/* Telemetry frame output, shares the debug UART with the console. */
+bool pca9420_telemetry_write(const uint8_t *pData, uint32_t length)
+{
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+	/* Drop the whole frame rather than block the sample timer on a full ring. */
+	return (DbgConsole_DmaWrite(pData, length) >= 0);
+#else
+	for (uint32_t i = 0u; i < length; i++)
+	{
+		(void)DbgConsole_Putchar((int)pData[i]);
+	}
+	return true;
+#endif
+}
+
+/* Core cycle counter, started by the GPIO driver for its dispatch latency figures. */
+uint32_t pca9420_cycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+/* Brown-out action, the report and the trace log flush follow in thread context. */
+void pca9420_brownout_shed(void *pUserData)
+{
+	pca9420BrownoutReport = true;
+}
+
+/* Called by the GPIO driver with the pin flag already cleared. An ASYS pre-warning sheds the
+ * loads right here, everything else goes on in thread context. */
+void pca9420_int_handler(void *pUserData)
+{
+	/* The driver measured ISR entry to here, which dates the pin edge. */
+	uint32_t entryCycles = (pca9420IntStats != NULL) ? pca9420IntStats->lastLatency : 0U;
+
+	PCA9420_BROWNOUT_OnEdge(&pca9420Brownout, pca9420_cycles() - entryCycles);
+	EVENT_LOOP_Post(DEMO_EVENT_PMIC_INT);
+}
+
+/* Event loop handler of the PMIC interrupt, thread context. */
+void pca9420_int_event(void *pUserData)
+{
+	TRACE_LOG("\r\n\033[35m Interrupt Occurred!!! Check Interrupt Status. \033[37m");
+
+	/*! Clear the flags so the next event brings a new edge, the handlers get the sources. */
+	(void)PCA9420_IRQ_Service(&pca9420Irq, NULL);
+
+	if (pca9420BrownoutReport)
+	{
+		pca9420BrownoutReport = false;
+		TRACE_LOG("\r\n\033[31m ASYS pre-warning, loads shed %u us after the INT edge!!! \033[37m",
+		          (unsigned)pca9420Brownout.lastUs);
+		/* Out on the console while there is still supply. */
+		TRACE_LOG_Process();
+	}
+}
+
+/* I2C completion callback, logs failed transfers before the register I/O layer sees the event. */
+void pca9420_i2c_event(uint32_t event)
+{
+	if (event != ARM_I2C_EVENT_TRANSFER_DONE)
+	{
+		PCA9420_EVLOG_Record(kPCA9420_EvlogI2cError, 0, (uint16_t)event);
+	}
+	I2C_S_SIGNAL_EVENT(event);
+}
+
+/* Boot fast path: bus up, reset cause latched and the boot profile applied, all before the console exists.
+ * Returns the failure text of the step that failed, NULL once the PMIC is reachable. */
+const char *pca9420_boot_fast_path(uint16_t *pResetMonitor, uint16_t *pSubInt0, int32_t *pProfileStatus)
+{
+	ARM_DRIVER_I2C *I2Cdrv = &I2C_S_DRIVER; // Now using the shield.h value!!!
+	const pca9420_config_t *pProfile = &pca9420BootProfile;
+	const uint8_t *pCare = pca9420BootCare;
+	pca9420_config_t storedProfile;
+
+	/*! Initialize the I2C driver. */
+	if (ARM_DRIVER_OK != I2Cdrv->Initialize(pca9420_i2c_event))
+	{
+		return "I2C Initialization Failed";
+	}
+
+	/*! Set the I2C Power mode. */
+	if (ARM_DRIVER_OK != I2Cdrv->PowerControl(ARM_POWER_FULL))
+	{
+		return "I2C Power Mode setting Failed";
+	}
+
+	/*! Set the I2C bus speed. */
+	if (ARM_DRIVER_OK != I2Cdrv->Control(ARM_I2C_BUS_SPEED, ARM_I2C_BUS_SPEED_FAST))
+	{
+		return "I2C Control Mode setting Failed";
+	}
+
+	/*! Initialize  driver. */
+	if (SENSOR_ERROR_NONE != PCA9420_I2C_Initialize(&pca9420Driver, &I2C_S_DRIVER, I2C_S_DEVICE_INDEX, PCA9420UK_I2C_ADDR))
+	{
+		return "Sensor Initialization Failed";
+	}
+
+	/*! Tell why the board went down, read before the profile touches the PMIC. */
+	(void)PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_RESET_MONITOR, pResetMonitor);
+	(void)PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_SUB_INT0, pSubInt0);
+
+	/*! A profile saved as "boot" takes the place of the built-in one. */
+	if ((SENSOR_ERROR_NONE == PCA9420_PROFILE_Init()) && (SENSOR_ERROR_NONE == PCA9420_PROFILE_Load("boot", &storedProfile)))
+	{
+		/*! A saved profile was captured whole, it owns every bit of its regions. */
+		pProfile = &storedProfile;
+		pCare = NULL;
+	}
+	*pProfileStatus = PCA9420_CFG_Reconcile(&pca9420Driver, pProfile, pCare, NULL, NULL);
+	(void)PCA9420_CFG_VerifyInit(&pca9420Verify, pProfile, pCare);
+
+	return NULL;
+}
+
+/* Debug console receive interrupt, only wakes the event loop. */
+void BOARD_UART_IRQ_HANDLER(void)
 {
-	/* Clear external interrupt flag. */
-	GPIO_GpioClearInterruptFlags(PCA9420_INT.base, 1U << PCA9420_INT.pinNumber);
-	PRINTF("\r\n\033[35m Interrupt Occurred!!! Check Interrupt Status. \033[37m\r\n");
+	LPUART_DisableInterrupts((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR, kLPUART_RxDataRegFullInterruptEnable);
+	EVENT_LOOP_Post(DEMO_EVENT_CONSOLE_RX);
 	SDK_ISR_EXIT_BARRIER;
 }
 
+/* Event loop handler of console input, show queued log records before the key is echoed. */
+void console_rx_event(void *pUserData)
+{
+	TRACE_LOG_Process();
+}
+
+/* Console wait hook, runs the event loop until a character has arrived. */
+void console_rx_wait(void)
+{
+	LPUART_Type *base = (LPUART_Type *)BOARD_DEBUG_UART_BASEADDR;
+
+	while (0U == (LPUART_GetStatusFlags(base) & kLPUART_RxDataRegFullFlag))
+	{
+		/* The receive interrupt masks itself again, so it fires once per wait. */
+		LPUART_EnableInterrupts(base, kLPUART_RxDataRegFullInterruptEnable);
+		EVENT_LOOP_Poll();
+		PCA9420_ENERGY_SetMcuState(&pca9420Energy, DEMO_MCU_RUN);
+	}
+}
+
+/* Event loop idle hook, the core sleeps right after it. */
+void demo_idle(void)
+{
+	TRACE_LOG_Process();
+	PCA9420_ENERGY_SetMcuState(&pca9420Energy, DEMO_MCU_SLEEP);
+}
+
 /*! -----------------------------------------------------------------------
  *  @brief       Initialize PCA9420UK Interrupt Pin and Enable IRQ
  *  @details     This function initializes PCA9420UK interrupt pin
@@ -99,8 +562,10 @@ void PCA9420_INT1_ISR(void)
  *  -----------------------------------------------------------------------*/
 void init_pca9420_wakeup_int(void)
 {
-	pGpioDriver->pin_init(&PCA9420_INT, GPIO_DIRECTION_IN, NULL, NULL, NULL);
-	EnableIRQ(PCA9420_INT1_IRQ);
+	pGpioDriver->pin_init(&PCA9420_INT, GPIO_DIRECTION_IN, NULL, pca9420_int_handler, NULL);
+	pca9420IntStats = ksdk_gpio_get_dispatch_stats(&PCA9420_INT);
+	/* The brown-out response waits in this interrupt for I2C transfers, their interrupt runs above it. */
+	NVIC_SetPriority(PCA9420_INT.irq, DEMO_PMIC_INT_PRIORITY);
 }
 
 //PCA9420_Functions
@@ -121,8 +586,8 @@ bool isMultipleof5 (int n)
 
 static void pmic_status()
 {
-	uint16_t character, data, vol_offset, offset;
-	float sw1_vol, sw2_vol, ldo1_vol, ldo2_vol;
+	uint16_t character, data, offset;
+	char text[FIXPT_STR_LEN];
 
 	PRINTF("\r\n**********\033[35m PMIC STATUS \033[37m**********\r\n");
 
@@ -154,74 +619,22 @@ static void pmic_status()
 		break;
 	}
 
+	//SW1 Regulator Status
 	PCA9420_DRV_Read(&pca9420Driver, offset, &data );
-	if(data >=0 && data <= 40)
-		PRINTF("\r\n\033[32m SW1: \033[37m  %f V \r\n",(float)((0.500)+(data * (0.025))));
-	else if(data >= 41 && data <= 62)
-	{
-		sw1_vol = 1.5;
-		PRINTF("\r\n\033[32m SW1: \033[37m  %f V \r\n",sw1_vol);
-	}
-	else
-	{
-		sw1_vol = 1.8;
-		PRINTF("\r\n\033[32m SW1: \033[37m  %f V \r\n",sw1_vol);
-	}
+	PRINTF("\r\n\033[32m SW1: \033[37m  %s V \r\n", FIXPT_FormatMilli(text, PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch1, data)));
 
 	//SW2 Regulator Status
 	PCA9420_DRV_Read(&pca9420Driver, offset+1, &data );
-	PCA9420_DRV_Read(&pca9420Driver, offset+1, &vol_offset );
-
-	vol_offset = (vol_offset & PCA9420_SW2_VOL_OFFSET_MASK) >> PCA9420_SW2_VOL_OFFSET_SHIFT;
-	data = (data & PCA9420_SW2_VOL_MASK);
-
-	if(vol_offset)
-	{
-		if(data >=0 && data <= 24)
-			PRINTF("\r\n\033[32m SW2: \033[37m  %f V \r\n",(float)(((1.500) + (data * .025)) + 1.2));
-		else
-			PRINTF("\r\n\033[32m SW2: \033[37m  %f V \r\n",(float)(2.1 + 1.2));
-	}
-	else
-	{
-		if(data >=0 && data <= 24)
-			PRINTF("\r\n\033[32m SW2: \033[37m  %f V \r\n",(float)((1.500) + (data * .025)));
-
-		else
-			PRINTF("\r\n\033[32m SW2: \033[37m  %f V \r\n", (float)(2.1));
-		sw2_vol = 2.1;
-	}
+	PRINTF("\r\n\033[32m SW2: \033[37m  %s V \r\n", FIXPT_FormatMilli(text, PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch2, data)));
 
 	//LDO1 Status
 	PCA9420_DRV_Read(&pca9420Driver, offset+2, &data );
 	data = (data & PCA9420_LDO1_VOL_MASK) >> PCA9420_LDO1_VOL_SHIFT ;
-
-	if(data >=0 && data <= 8)
-		PRINTF("\r\n\033[32m LDO1: \033[37m %f V \r\n",(float)((1.700) + (data * .025)));
-	else
-		PRINTF("\r\n\033[32m LDO1: \033[37m %f V \r\n",(float)(1.9));
+	PRINTF("\r\n\033[32m LDO1: \033[37m %s V \r\n", FIXPT_FormatMilli(text, PCA9420_Decode_regulator_mv(kPCA9420_RegulatorLdo1, data)));
 
 	//LDO2 Regulator Status
 	PCA9420_DRV_Read(&pca9420Driver, offset+3, &data );
-	PCA9420_DRV_Read(&pca9420Driver, offset+3, &vol_offset );
-
-	vol_offset = (vol_offset & PCA9420_LDO2_VOL_OFFSET_MASK) >> PCA9420_LDO2_VOL_OFFSET_SHIFT;
-	data = (data & PCA9420_LDO2_VOL_MASK);
-
-	if(vol_offset)
-	{
-		if(data >=0 && data <= 24)
-			PRINTF("\r\n\033[32m LDO2: \033[37m %f V \r\n",(float)(((1.500) + (data * .025)) + 1.2));
-		else
-			PRINTF("\r\n\033[32m LDO2: \033[37m %f V \r\n",(float)(2.1 + 1.2));
-	}
-	else
-	{
-		if(data >=0 && data <= 24)
-			PRINTF("\r\n\033[32m LDO2: \033[37m %f V \r\n",(float)((1.500) + (data * .025)));
-		else
-			PRINTF("\r\n\033[32m LDO2: \033[37m %f V \r\n",(float)(2.1));
-	}
+	PRINTF("\r\n\033[32m LDO2: \033[37m %s V \r\n", FIXPT_FormatMilli(text, PCA9420_Decode_regulator_mv(kPCA9420_RegulatorLdo2, data)));
 
 	PRINTF("\r\n********************************\r\n");
 }
@@ -282,11 +695,19 @@ static void get_regulator_status()
 
 static void top_level_interrupt_status()
 {
-	uint16_t character, data, int_status=1;
+	uint16_t character, data, sub, int_status=1;
+	uint32_t sources;
+	uint8_t topInt;
 	char dummy;
+	const gpio_dispatch_entry_t *pIntStats = ksdk_gpio_get_dispatch_stats(&PCA9420_INT);
+
+	if (pIntStats != NULL)
+		PRINTF("\r\n INT pin dispatches: %u, ISR entry to handler: last %u, max %u cycles\r\n",
+				pIntStats->calls, pIntStats->lastLatency, pIntStats->maxLatency);
 
-	PCA9420_clear_interrupt(&pca9420Driver);
-	PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_TOP_INT, &data );
+	/*! The dispatcher clears the flags as it services INT, show what it latched since the last check. */
+	sources = PCA9420_IRQ_TakeLatched(&pca9420Irq, &topInt);
+	data = topInt;
 
 	if((data & PCA9420_SYS_INT_MASK) >> PCA9420_SYS_INT_SHIFT || (data & PCA9420_BAT_INT_MASK) >> PCA9420_BAT_INT_SHIFT
 			|| ((data & PCA9420_BUCK_INT_MASK) >> PCA9420_BUCK_INT_SHIFT) || ((data & PCA9420_LDO_INT_MASK) >> PCA9420_LDO_INT_SHIFT))
@@ -336,16 +757,16 @@ static void top_level_interrupt_status()
 			case 1: //System level interrupt
 				if((data & PCA9420_SYS_INT_MASK) >> PCA9420_SYS_INT_SHIFT)
 				{
-					PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_SUB_INT0, &data );
-					if((data & PCA9420_TEMP_PREWARN_MASK) >> PCA9420_TEMP_PREWARN_SHIFT)
+					sub = sources & 0xFF;
+					if((sub & PCA9420_TEMP_PREWARN_MASK) >> PCA9420_TEMP_PREWARN_SHIFT)
 						PRINTF("\r\n\033[31m Die Temperature is greater than the pre-warning temperature. \033[37m\r\n");
-					if((data & PCA9420_THEM_SHDN_MASK) >> PCA9420_THEM_SHDN_SHIFT)
+					if((sub & PCA9420_THEM_SHDN_MASK) >> PCA9420_THEM_SHDN_SHIFT)
 						PRINTF("\r\n\033[31m Die Temperature is greater than the thermal shutdown threshold. \033[37m\r\n");
-					if((data & PCA9420_ASYS_PREWARN_MASK) >> PCA9420_ASYS_PREWARN_SHIFT)
+					if((sub & PCA9420_ASYS_PREWARN_MASK) >> PCA9420_ASYS_PREWARN_SHIFT)
 						PRINTF("\r\n\033[31m ASYS voltage falls below the threshold set in ASYS pre-warning voltage threshold. \033[37m\r\n");
-					if((data & PCA9420_WD_TMR_MASK) >> PCA9420_WD_TMR_SHIFT)
+					if((sub & PCA9420_WD_TMR_MASK) >> PCA9420_WD_TMR_SHIFT)
 						PRINTF("\r\n\033[31m Watchdog timer has expired \033[37m\r\n");
-					if((data & PCA9420_IN_PWR_MASK) >> PCA9420_IN_PWR_SHIFT)
+					if((sub & PCA9420_IN_PWR_MASK) >> PCA9420_IN_PWR_SHIFT)
 						PRINTF("\r\n\033[31m Invalid input power voltage. \033[37m\r\n");
 				}
 				else
@@ -357,20 +778,20 @@ static void top_level_interrupt_status()
 #if (!PCA9421UK_EVM_EN)
 				if((data & PCA9420_BAT_INT_MASK) >> PCA9420_BAT_INT_SHIFT)
 				{
-					PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_SUB_INT1, &data );
-					if((data & PCA9420_DEAD_TMR_MASK) >> PCA9420_DEAD_TMR_SHIFT)
+					sub = (sources >> 8) & 0xFF;
+					if((sub & PCA9420_DEAD_TMR_MASK) >> PCA9420_DEAD_TMR_SHIFT)
 						PRINTF("\r\n\033[31m Dead charge timer has expired. \033[37m\r\n");
-					if((data & PCA9420_VIN_ILIM_MASK) >> PCA9420_VIN_ILIM_SHIFT)
+					if((sub & PCA9420_VIN_ILIM_MASK) >> PCA9420_VIN_ILIM_SHIFT)
 						PRINTF("\r\n\033[31m Input current limit interrupt occurred. \033[37m\r\n");
-					if((data & PCA9420_FAST_TMR_MASK) >> PCA9420_FAST_TMR_SHIFT)
+					if((sub & PCA9420_FAST_TMR_MASK) >> PCA9420_FAST_TMR_SHIFT)
 						PRINTF("\r\n\033[31m Fast charging timer has expired. \033[37m\r\n");
-					if((data & PCA9420_PREQ_TMR_MASK) >> PCA9420_PREQ_TMR_SHIFT)
+					if((sub & PCA9420_PREQ_TMR_MASK) >> PCA9420_PREQ_TMR_SHIFT)
 						PRINTF("\r\n\033[31m Pre-qualification charging timer has expired. \033[37m\r\n");
-					if((data & PCA9420_VBAT_DET_MASK) >> PCA9420_VBAT_DET_SHIFT)
+					if((sub & PCA9420_VBAT_DET_MASK) >> PCA9420_VBAT_DET_SHIFT)
 						PRINTF("\r\n\033[31m Battery presence status is changed. \033[37m\r\n");
-					if((data & PCA9420_VBAT_OK_MASK) >> PCA9420_VBAT_OK_SHIFT)
+					if((sub & PCA9420_VBAT_OK_MASK) >> PCA9420_VBAT_OK_SHIFT)
 						PRINTF("\r\n\033[31m Battery status is changed. \033[37m\r\n");
-					if((data & PCA9420_CHG_OK_MASK) >> PCA9420_CHG_OK_SHIFT)
+					if((sub & PCA9420_CHG_OK_MASK) >> PCA9420_CHG_OK_SHIFT)
 						PRINTF("\r\n\033[31m Charger status has changed. \033[37m\r\n");
 				}
 				else
@@ -380,8 +801,8 @@ static void top_level_interrupt_status()
 #else //PCA9421UK-EVM
 				if((data & PCA9421_VIN_INT_MASK) >> PCA9421_VIN_INT_SHIFT)
 				{
-					PCA9420_DRV_Read(&pca9420Driver, PCA9420UK_SUB_INT1, &data );
-					if((data & PCA9420_VIN_ILIM_MASK) >> PCA9420_VIN_ILIM_SHIFT)
+					sub = (sources >> 8) & 0xFF;
+					if((sub & PCA9420_VIN_ILIM_MASK) >> PCA9420_VIN_ILIM_SHIFT)
 						PRINTF("\r\n\033[31m Input current limit interrupt occurred. \033[37m\r\n");
 				}
 				else
@@ -393,13 +814,14 @@ static void top_level_interrupt_status()
 			case 3: //Voltage regulator interrupt
 				if(((data & PCA9420_BUCK_INT_MASK) >> PCA9420_BUCK_INT_SHIFT) || ((data & PCA9420_LDO_INT_MASK) >> PCA9420_LDO_INT_SHIFT))
 				{
-					if((data & PCA9420_VOUTSW1_MASK) >> PCA9420_VOUTSW1_SHIFT)
+					sub = (sources >> 16) & 0xFF;
+					if((sub & PCA9420_VOUTSW1_MASK) >> PCA9420_VOUTSW1_SHIFT)
 						PRINTF("\r\n\033[31m SW1 output voltage status has changed. \033[37m\r\n");
-					if((data & PCA9420_VOUTSW2_MASK) >> PCA9420_VOUTSW2_SHIFT)
+					if((sub & PCA9420_VOUTSW2_MASK) >> PCA9420_VOUTSW2_SHIFT)
 						PRINTF("\r\n\033[31m SW2 output voltage status has changed. \033[37m\r\n");
-					if((data & PCA9420_VOUTLDO1_MASK) >> PCA9420_VOUTLDO1_SHIFT)
+					if((sub & PCA9420_VOUTLDO1_MASK) >> PCA9420_VOUTLDO1_SHIFT)
 						PRINTF("\r\n\033[31m LDO1 output voltage status has changed. \033[37m\r\n");
-					if((data & PCA9420_VOUTLDO2_MASK) >> PCA9420_VOUTLDO2_SHIFT)
+					if((sub & PCA9420_VOUTLDO2_MASK) >> PCA9420_VOUTLDO2_SHIFT)
 						PRINTF("\r\n\033[31m LDO2 output voltage status has changed. \033[37m\r\n");
 				}
 				else
@@ -409,8 +831,6 @@ static void top_level_interrupt_status()
 				break;
 			case 4:
 				int_status = 0;
-				//Clearing the interrupt
-				PCA9420_clear_interrupt(&pca9420Driver);
 				break;
 			default:
 				PRINTF("\r\nInvalid option selected\r\n");
@@ -424,7 +844,7 @@ static void top_level_interrupt_status()
 	}
 	else
 	{
-		PRINTF("\r\n\033[32m No interrupt occurred \033[37m\r\n");
+		PRINTF("\r\n\033[32m No interrupt since the last check \033[37m\r\n");
 	}
 	PRINTF("\r\n*******************************\r\n");
 }
@@ -1118,6 +1538,7 @@ static void device_settings()
 				break;
 			}
 			PCA9420_Set_mode_control(&pca9420Driver, epca9420_mode);
+			PCA9420_WDOG_Refresh(&pca9420Wdog);
 			PCA9420_Get_mode_control(&pca9420Driver, &pBuffer);
 
 			switch(pBuffer)
@@ -1229,6 +1650,7 @@ static void device_settings()
 			break;
 		case 12: //Reset PCA9420UK-EVB
 			PCA9420_SW_reset(&pca9420Driver);
+			PCA9420_WDOG_Refresh(&pca9420Wdog);
 			PRINTF("\r\n********************************\r\n");
 			PRINTF("\r\n\033[93m Device reset is done successfully. \033[37m \r\n\r\n");
 #if (!PCA9421UK_EVM_EN)
@@ -1254,7 +1676,6 @@ static void charging_control()
 {
 	uint16_t character, offset;
 	uint16_t data, echrg_ctrl=1;
-	float sw1_vol;
 
 	PCA9420_enable_chg_lock(&pca9420Driver);
 
@@ -2091,397 +2512,100 @@ static int find_operation()
 
 static void set_sw1_vol(enum _pca9420_mode epca9420_mode)
 {
-	float voltage;
-	uint32_t data;
+	char text[FIXPT_STR_LEN];
+	int32_t milliVolt;
+	uint8_t code;
 
 	do
 	{
 		PRINTF("\r\nEnter SW1 output voltage from (0.5 V to 1.5 V with 25 mV/step) or fixed 1.8V ---------\r\n");
-		SCANF("%f",&voltage);
-		PRINTF("%f\r\n",voltage);
+		SCANF("%13s",text);
+		PRINTF("%s\r\n",text);
 		GETCHAR();
 
-		data = voltage * 1000;
-
-		if((voltage == 1.8f) || ((data % 25 == 0) && voltage <= 1.5f && voltage >= 0.500f))
+		if(FIXPT_ParseMilli(text, &milliVolt) && (milliVolt > 0) &&
+				(SENSOR_ERROR_NONE == PCA9420_Encode_regulator_mv(kPCA9420_RegulatorSwitch1, (uint32_t)milliVolt, &code)))
 			break;
 		else
 			PRINTF("\r\nInvalid Value, Please enter correct value\r\n");
-	}while(!((voltage == 1.8f) || ((data % 25 == 0) && voltage <= 1.5f && voltage >= 0.500f)));
-
-	if(voltage == 0.500f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V500;
-	else if(voltage == 0.525f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V525;
-	else if(voltage == 0.550f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V550;
-	else if(voltage == 0.575f)
-		epca9420_sw1_out = 	kPCA9420_Sw1OutVolt0V575;
-	else if(voltage == 0.600f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V600;
-	else if(voltage == 0.625f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V625;
-	else if(voltage == 0.650f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V650;
-	else if(voltage == 0.675f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V675;
-	else if(voltage == 0.700f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V700;
-	else if(voltage == 0.725f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V725;
-	else if(voltage == 0.750f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V750;
-	else if(voltage == 0.775f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V775;
-	else if(voltage == 0.800f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V800;
-	else if(voltage == 0.825f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V825;
-	else if(voltage == 0.850f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V850;
-	else if(voltage == 0.875f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V875;
-	else if(voltage == 0.900f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V900;
-	else if(voltage == 0.925f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V925;
-	else if(voltage == 0.950f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V950;
-	else if(voltage == 0.975f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt0V975;
-	else if(voltage == 1.000f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V000;
-	else if(voltage == 1.025f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V025;
-	else if(voltage == 1.050f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V050;
-	else if(voltage == 1.075f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V075;
-	else if(voltage == 1.100f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V100;
-	else if(voltage == 1.125f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V125;
-	else if(voltage == 1.150f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V150;
-	else if(voltage == 1.175f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V175;
-	else if(voltage == 1.200f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V200;
-	else if(voltage == 1.225f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V225;
-	else if(voltage == 1.250f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V250;
-	else if(voltage == 1.275f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V275;
-	else if(voltage == 1.300f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V300;
-	else if(voltage == 1.325f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V325;
-	else if(voltage == 1.350f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V350;
-	else if(voltage == 1.375f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V375;
-	else if(voltage == 1.400f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V400;
-	else if(voltage == 1.425f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V425;
-	else if(voltage == 1.450f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V450;
-	else if(voltage == 1.475f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V475;
-	else if(voltage == 1.500f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V500;
-	else if(voltage == 1.8f)
-		epca9420_sw1_out = kPCA9420_Sw1OutVolt1V800;
+	}while(1);
+
+	epca9420_sw1_out = (enum _pca9420_sw1_out)code;
 
 	PCA9420_Set_sw1_out_vol(&pca9420Driver, epca9420_mode, epca9420_sw1_out);
 }
 
 static void set_sw2_vol(enum _pca9420_mode epca9420_mode)
 {
-	float voltage;
-	uint32_t data;
+	char text[FIXPT_STR_LEN];
+	int32_t milliVolt;
+	uint8_t code;
 
 	do
 	{
 		PRINTF("\r\nEnter SW2 output voltage from (1.5 V to 2.1 V or 2.7 V to 3.3 V) with 25 mV/step Adjustable resolution ---------\r\n");
-		SCANF("%f",&voltage);
-		PRINTF("%f\r\n",voltage);
+		SCANF("%13s",text);
+		PRINTF("%s\r\n",text);
 		GETCHAR();
 
-		data = voltage * 1000;
-
-		if((data % 25 == 0) && ((voltage <= 2.1f && voltage >= 1.5f) || (voltage <= 3.3f && voltage >= 2.7f)))
+		if(FIXPT_ParseMilli(text, &milliVolt) && (milliVolt > 0) &&
+				(SENSOR_ERROR_NONE == PCA9420_Encode_regulator_mv(kPCA9420_RegulatorSwitch2, (uint32_t)milliVolt, &code)))
 			break;
 		else
 			PRINTF("\r\nInvalid Value, Please enter correct value\r\n");
-	}while(!((data % 25 == 0) && ((voltage <= 2.1f && voltage >= 1.5f) || (voltage <= 3.3f && voltage >= 2.7f))));
-
-	if(voltage == 1.500f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V500;
-	else if(voltage == 1.525f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V525;
-	else if(voltage == 1.550f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V550;
-	else if(voltage == 1.575f)
-		epca9420_sw2_out = 	kPCA9420_Sw2OutVolt1V575;
-	else if(voltage == 1.600f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V600;
-	else if(voltage == 1.625f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V625;
-	else if(voltage == 1.650f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V650;
-	else if(voltage == 1.675f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V675;
-	else if(voltage == 1.700f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V700;
-	else if(voltage == 1.725f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V725;
-	else if(voltage == 1.750f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V750;
-	else if(voltage == 1.775f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V775;
-	else if(voltage == 1.800f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V800;
-	else if(voltage == 1.825f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V825;
-	else if(voltage == 1.850f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V850;
-	else if(voltage == 1.875f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V875;
-	else if(voltage == 1.900f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V900;
-	else if(voltage == 1.925f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V925;
-	else if(voltage == 1.950f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V950;
-	else if(voltage == 1.975f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt1V975;
-	else if(voltage == 2.000f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V000;
-	else if(voltage == 2.025f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V025;
-	else if(voltage == 2.050f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V050;
-	else if(voltage == 2.075f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V075;
-	else if(voltage == 2.100f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V100;
-	else if(voltage == 2.700f) // Extended range input for SW2
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V700;
-	else if(voltage == 2.725f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V725;
-	else if(voltage == 2.750f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V750;
-	else if(voltage == 2.775f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V775;
-	else if(voltage == 2.800f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V800;
-	else if(voltage == 2.825f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V825;
-	else if(voltage == 2.850f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V850;
-	else if(voltage == 2.875f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V875;
-	else if(voltage == 2.900f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V900;
-	else if(voltage == 2.925f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V925;
-	else if(voltage == 2.950f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V950;
-	else if(voltage == 2.975f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt2V975;
-	else if(voltage == 3.000f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V000;
-	else if(voltage == 3.025f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V025;
-	else if(voltage == 3.050f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V050;
-	else if(voltage == 3.075f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V075;
-	else if(voltage == 3.100f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V100;
-	else if(voltage == 3.125f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V125;
-	else if(voltage == 3.150f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V150;
-	else if(voltage == 3.175f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V175;
-	else if(voltage == 3.200f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V200;
-	else if(voltage == 3.225f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V225;
-	else if(voltage == 3.250f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V250;
-	else if(voltage == 3.275f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V275;
-	else if(voltage == 3.300f)
-		epca9420_sw2_out = kPCA9420_Sw2OutVolt3V300;
+	}while(1);
+
+	epca9420_sw2_out = (enum _pca9420_sw2_out)code;
 
 	PCA9420_Set_sw2_out_vol(&pca9420Driver, epca9420_mode, epca9420_sw2_out);
 }
 
 static void set_ldo1_vol(enum _pca9420_mode epca9420_mode)
 {
-	float voltage;
-	uint32_t data;
+	char text[FIXPT_STR_LEN];
+	int32_t milliVolt;
+	uint8_t code;
 
 	do
 	{
 		PRINTF("\r\nEnter LDO1 output voltage from (1.7 V to 1.9 V with 25 mV/step) ---------\r\n");
-		SCANF("%f",&voltage);
-		PRINTF("%f\r\n",voltage);
+		SCANF("%13s",text);
+		PRINTF("%s\r\n",text);
 		GETCHAR();
 
-		data = voltage * 1000;
-		if(((data % 25 == 0) && voltage <= 1.9f && voltage >= 1.7f))
+		if(FIXPT_ParseMilli(text, &milliVolt) && (milliVolt > 0) &&
+				(SENSOR_ERROR_NONE == PCA9420_Encode_regulator_mv(kPCA9420_RegulatorLdo1, (uint32_t)milliVolt, &code)))
 			break;
 		else
 			PRINTF("\r\nInvalid Value, Please enter correct value\r\n");
-	}while(!(((data % 25 == 0) && voltage <= 1.9f && voltage >= 1.7f)));
-
-	if(voltage == 1.700f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V700;
-	else if(voltage == 1.725f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V725;
-	else if(voltage == 1.750f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V750;
-	else if(voltage == 1.775f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V775;
-	else if(voltage == 1.800f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V800;
-	else if(voltage == 1.825f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V825;
-	else if(voltage == 1.850f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V850;
-	else if(voltage == 1.875f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V875;
-	else if(voltage == 1.900f)
-		epca9420_ldo1_out = kPCA9420_Ldo1OutVolt1V900;
+	}while(1);
+
+	epca9420_ldo1_out = (enum _pca9420_ldo1_out)code;
 
 	PCA9420_Set_ldo1_out_vol(&pca9420Driver, epca9420_mode, epca9420_ldo1_out);
 }
 
 static void set_ldo2_vol(enum _pca9420_mode epca9420_mode)
 {
-	float voltage;
-	uint32_t data;
+	char text[FIXPT_STR_LEN];
+	int32_t milliVolt;
+	uint8_t code;
 
 	do
 	{
 		PRINTF("\r\nEnter LDO2 output voltage from (1.5 V to 2.1 V or 2.7 V to 3.3 V) with 25 mV/step Adjustable resolution ---------\r\n");
-		SCANF("%f",&voltage);
-		PRINTF("%f\r\n",voltage);
+		SCANF("%13s",text);
+		PRINTF("%s\r\n",text);
 		GETCHAR();
 
-		data = voltage * 1000;
-
-		if((data % 25 == 0) && ((voltage <= 2.1f && voltage >= 1.5f) || (voltage <= 3.3f && voltage >= 2.7f)))
+		if(FIXPT_ParseMilli(text, &milliVolt) && (milliVolt > 0) &&
+				(SENSOR_ERROR_NONE == PCA9420_Encode_regulator_mv(kPCA9420_RegulatorLdo2, (uint32_t)milliVolt, &code)))
 			break;
 		else
 			PRINTF("\r\nInvalid Value, Please enter correct value\r\n");
-	}while(!((data % 25 == 0) && ((voltage <= 2.1f && voltage >= 1.5f) || (voltage <= 3.3f && voltage >= 2.7f))));
-
-	if(voltage == 1.500f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V500;
-	else if(voltage == 1.525f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V500;
-	else if(voltage == 1.550f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V550;
-	else if(voltage == 1.575f)
-		epca9420_ldo2_out = 	kPCA9420_Ldo2OutVolt1V550;
-	else if(voltage == 1.600f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V600;
-	else if(voltage == 1.625f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V625;
-	else if(voltage == 1.650f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V650;
-	else if(voltage == 1.675f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V675;
-	else if(voltage == 1.700f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V700;
-	else if(voltage == 1.725f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V725;
-	else if(voltage == 1.750f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V750;
-	else if(voltage == 1.775f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V775;
-	else if(voltage == 1.800f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V800;
-	else if(voltage == 1.825f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V825;
-	else if(voltage == 1.850f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V850;
-	else if(voltage == 1.875f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V875;
-	else if(voltage == 1.900f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V900;
-	else if(voltage == 1.925f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V925;
-	else if(voltage == 1.950f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V950;
-	else if(voltage == 1.975f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt1V975;
-	else if(voltage == 2.000f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V000;
-	else if(voltage == 2.025f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V025;
-	else if(voltage == 2.050f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V050;
-	else if(voltage == 2.075f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V075;
-	else if(voltage == 2.100f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V100;
-	else if(voltage == 2.700f) // Extended range input for LDO2
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V700;
-	else if(voltage == 2.725f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V725;
-	else if(voltage == 2.750f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V750;
-	else if(voltage == 2.775f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V775;
-	else if(voltage == 2.800f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V800;
-	else if(voltage == 2.825f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V825;
-	else if(voltage == 2.850f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V850;
-	else if(voltage == 2.875f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V875;
-	else if(voltage == 2.900f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V900;
-	else if(voltage == 2.925f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V925;
-	else if(voltage == 2.950f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V950;
-	else if(voltage == 2.975f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt2V975;
-	else if(voltage == 3.000f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V000;
-	else if(voltage == 3.025f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V025;
-	else if(voltage == 3.050f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V050;
-	else if(voltage == 3.075f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V075;
-	else if(voltage == 3.100f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V100;
-	else if(voltage == 3.125f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V125;
-	else if(voltage == 3.150f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V150;
-	else if(voltage == 3.175f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V175;
-	else if(voltage == 3.200f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V200;
-	else if(voltage == 3.225f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V225;
-	else if(voltage == 3.250f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V250;
-	else if(voltage == 3.275f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V275;
-	else if(voltage == 3.300f)
-		epca9420_ldo2_out = kPCA9420_Ldo2OutVolt3V300;
+	}while(1);
+
+	epca9420_ldo2_out = (enum _pca9420_ldo2_out)code;
 
 	PCA9420_Set_ldo2_out_vol(&pca9420Driver, epca9420_mode, epca9420_ldo2_out);
 }
@@ -2489,7 +2613,6 @@ static void set_ldo2_vol(enum _pca9420_mode epca9420_mode)
 static void regulator_settings(enum _pca9420_mode epca9420_mode)
 {
 	uint32_t character, data, operation, grp_setting=1;
-	double voltage;
 
 	do{
 		PRINTF("\r\n********************************\r\n");
@@ -2563,18 +2686,22 @@ static void regulator_settings(enum _pca9420_mode epca9420_mode)
 				{
 				case 1:
 					PCA9420_Set_wtchdg_timer(&pca9420Driver, epca9420_mode, kPCA9420_WdTimerDisabled);
+					PCA9420_WDOG_Refresh(&pca9420Wdog);
 					PRINTF("\r\n\033[33m Watchdog timer Disabled!!! \033[37m");
 					break;
 				case 2:
 					PCA9420_Set_wtchdg_timer(&pca9420Driver, epca9420_mode, kPCA9420_WdTimer16s);
+					PCA9420_WDOG_Refresh(&pca9420Wdog);
 					PRINTF("\r\n\033[33m Watchdog timer is set to 16 sec. \033[37m");
 					break;
 				case 3:
 					PCA9420_Set_wtchdg_timer(&pca9420Driver, epca9420_mode, kPCA9420_WdTimer32s);
+					PCA9420_WDOG_Refresh(&pca9420Wdog);
 					PRINTF("\r\n\033[33m Watchdog timer is set to 32 sec. \033[37m");
 					break;
 				case 4:
 					PCA9420_Set_wtchdg_timer(&pca9420Driver, epca9420_mode, kPCA9420_WdTimer64s);
+					PCA9420_WDOG_Refresh(&pca9420Wdog);
 					PRINTF("\r\n\033[33m Watchdog timer is set to 64 sec. \033[37m");
 					break;
 				}
@@ -3235,7 +3362,6 @@ static void charging_status()
 static void battery_charging_settings()
 {
 	uint16_t character, data, offset;
-	float sw1_vol;
 
 	PRINTF("\r\n********************************\r\n");
 	PRINTF("\r\n1. Charge Control\r\n");
@@ -3278,10 +3404,24 @@ static void battery_charging_settings()
  *  -----------------------------------------------------------------------*/
 int main(void)
 {
-	int32_t status;
 	uint32_t input;
 	char dummy;
 	uint16_t Data;
+	uint16_t resetMonitor = 0, subInt0 = 0;
+	int32_t profileStatus = SENSOR_ERROR_NONE;
+	const char *bootFailure;
+	int32_t bootStart;
+	uint32_t bootTimeUs, resetClockHz;
+	pca9420_thermal_t *pThermal = NULL;
+	pca9420_jeita_t *pJeita = NULL;
+	pca9420_ilim_t *pIlim = NULL;
+	pca9420_chgprof_t *pChgProf = NULL;
+	pca9420_brownout_t *pBrownout = NULL;
+
+	/*! Boot timing starts here, counted at the reset clock up to the clock setup. */
+	BOARD_SystickEnable();
+	BOARD_SystickStart(&bootStart);
+	resetClockHz = CLOCK_GetFreq(kCLOCK_CoreSysClk);
 
 #if RTE_I2C0_DMA_EN
 	/*  Enable DMA clock. */
@@ -3292,58 +3432,117 @@ int main(void)
 #endif
 
 	RESET_PeripheralReset(kDMA_RST_SHIFT_RSTn);
-	ARM_DRIVER_I2C *I2Cdrv = &I2C_S_DRIVER; // Now using the shield.h value!!!
 
 	RESET_PeripheralReset(kLPI2C0_RST_SHIFT_RSTn);
 
 	/*! Initialize the MCU hardware. */
 	BOARD_InitPins();
 	BOARD_InitBootClocks();
-	BOARD_SystickEnable();
+	/*! The last ticks of the clock setup run faster than counted, the figure errs high. */
+	bootTimeUs = (uint32_t)COUNT_TO_USEC(BOARD_SystickElapsedTicks(&bootStart), resetClockHz);
+	SW_TIMER_Init();
+	BOARD_SystickStart(&bootStart);
+	PCA9420_EVLOG_Init();
+
+	/*! Rails first, console and menus afterwards. */
+	bootFailure = pca9420_boot_fast_path(&resetMonitor, &subInt0, &profileStatus);
+	bootTimeUs += BOARD_SystickElapsedTime_us(&bootStart);
+
 	BOARD_InitDebugConsole();
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+	DbgConsole_DmaInit();
+#endif
 	init_pca9420_wakeup_int();
 
+	/*! Serve interrupts, timers and logging while the menus wait for input. */
+	(void)PCA9420_IRQ_Init(&pca9420Irq, &pca9420Driver);
+	EVENT_LOOP_Init(demo_idle);
+	EVENT_LOOP_Register(DEMO_EVENT_PMIC_INT, pca9420_int_event, NULL);
+	EVENT_LOOP_Register(DEMO_EVENT_CONSOLE_RX, console_rx_event, NULL);
+	DbgConsole_SetRxWaitHook(console_rx_wait);
+	EnableIRQ(BOARD_UART_IRQ);
+
 #if (!PCA9421UK_EVM_EN)
 	PRINTF("\r\nISSDK PCA9420UK-EVM PMIC driver example demonstration.\r\n");
 #else
 	PRINTF("\r\nISSDK PCA9421UK-EVM PMIC driver example demonstration.\r\n");
 #endif
 
-	/*! Initialize the I2C driver. */
-	status = I2Cdrv->Initialize(I2C_S_SIGNAL_EVENT);
-	if (ARM_DRIVER_OK != status)
+	if (bootFailure != NULL)
 	{
-		PRINTF("\r\n I2C Initialization Failed\r\n");
+		PRINTF("\r\n %s\r\n", bootFailure);
 		return -1;
 	}
-
-	/*! Set the I2C Power mode. */
-	status = I2Cdrv->PowerControl(ARM_POWER_FULL);
-	if (ARM_DRIVER_OK != status)
+	/*! The brown-out response and the energy model need the writes also without a read-back reference. */
+	SW_TIMER_Setup(&pca9420EnergyTimer, pca9420_energy_timer, NULL);
+	PCA9420_DRV_SetWriteListener(&pca9420Driver, pca9420_write_noted, NULL);
+	if (SENSOR_ERROR_NONE != profileStatus)
 	{
-		PRINTF("\r\n I2C Power Mode setting Failed\r\n");
-		return -1;
+		PRINTF("\r\n\033[31m Boot profile could not be applied (%d). \033[37m\r\n", (int)profileStatus);
+	}
+	else
+	{
+		/*! Read the profile back now and every DEMO_VERIFY_PERIOD_MS from then on. */
+		pca9420_verify_timer(NULL);
+		SW_TIMER_Setup(&pca9420VerifyTimer, pca9420_verify_timer, NULL);
+		SW_TIMER_Start(&pca9420VerifyTimer, SW_TIMER_MS_TO_TICKS(DEMO_VERIFY_PERIOD_MS), SW_TIMER_MS_TO_TICKS(DEMO_VERIFY_PERIOD_MS));
 	}
+	PRINTF("\r\n Rails configured %u us after reset%s\r\n", (unsigned)bootTimeUs,
+	       (bootTimeUs > DEMO_BOOT_RAILS_TARGET_US) ? ", above the target." : ".");
 
-	/*! Set the I2C bus speed. */
-	status = I2Cdrv->Control(ARM_I2C_BUS_SPEED, ARM_I2C_BUS_SPEED_FAST);
-	if (ARM_DRIVER_OK != status)
+	PCA9420_EVLOG_Print((uint8_t)resetMonitor, (uint8_t)subInt0);
+	PCA9420_EVLOG_Record(kPCA9420_EvlogBoot, (uint8_t)resetMonitor, subInt0);
+	if ((resetMonitor & PCA9420_RESET_MONITOR_ALL_MASK) != 0u)
 	{
-		PRINTF("\r\n I2C Control Mode setting Failed\r\n");
-		return -1;
+		/*! Clear the latched causes once logged, so the next boot only reports its own. */
+		(void)PCA9420_DRV_Write(&pca9420Driver, PCA9420UK_RESET_MONITOR, resetMonitor & PCA9420_RESET_MONITOR_ALL_MASK);
 	}
 
-	/*! Initialize  driver. */
-	status = PCA9420_I2C_Initialize(&pca9420Driver, &I2C_S_DRIVER, I2C_S_DEVICE_INDEX, PCA9420UK_I2C_ADDR);
-	if (SENSOR_ERROR_NONE != status)
+	/*! Keep the PMIC watchdog serviced in the background. */
+	PCA9420_WDOG_Init(&pca9420Wdog, &pca9420Driver, PCA9420_WDOG_DEFAULT_KICK_PERCENT, pca9420_wdog_missed, NULL);
+	PCA9420_TLM_Init(&pca9420Telemetry, &pca9420Driver, pca9420_telemetry_write);
+	(void)PCA9420_DVFS_Init(&pca9420Dvfs, &pca9420Driver, pca9420DvfsTable, ARRAY_SIZE(pca9420DvfsTable), pca9420_dvfs_core_level,
+	                        ARRAY_SIZE(pca9420DvfsTable) - 1u);
+	(void)PCA9420_LP_Init(&pca9420LowPower, &pca9420Driver, &pca9420Dvfs, pca9420LowPowerSteps,
+	                      ARRAY_SIZE(pca9420LowPowerSteps));
+	(void)PCA9420_ENERGY_Init(&pca9420Energy, &pca9420EnergyModel, DEMO_MCU_RUN);
+	(void)PCA9420_ENERGY_Refresh(&pca9420Energy, &pca9420Driver);
+	(void)PCA9420_SEQ_Init(&pca9420Sequence, &pca9420Driver, pca9420RailSequences, ARRAY_SIZE(pca9420RailSequences),
+	                       pca9420_seq_done, NULL);
+#if (!PCA9421UK_EVM_EN)
+	if (SENSOR_ERROR_NONE == PCA9420_CHGPROF_Init(&pca9420ChgProf, &pca9420Irq, DEMO_BATTERY_MAH))
 	{
-		PRINTF("\r\n Sensor Initialization Failed\r\n");
-		return -1;
+		pChgProf = &pca9420ChgProf;
+	}
+	if (SENSOR_ERROR_NONE == PCA9420_THERMAL_Init(&pca9420Thermal, &pca9420Irq, &pca9420ThermalConfig))
+	{
+		pThermal = &pca9420Thermal;
+	}
+	if (SENSOR_ERROR_NONE == PCA9420_JEITA_Init(&pca9420Jeita, &pca9420Irq, &pca9420JeitaProfile, pThermal))
+	{
+		pJeita = &pca9420Jeita;
+	}
+	if (SENSOR_ERROR_NONE == PCA9420_ILIM_Init(&pca9420Ilim, &pca9420Irq, &pca9420IlimConfig))
+	{
+		pIlim = &pca9420Ilim;
+	}
+#endif
+	/*! Shed the peripheral loads from the INT pin interrupt on an ASYS pre-warning. */
+	if ((SENSOR_ERROR_NONE == PCA9420_BROWNOUT_Init(&pca9420Brownout, &pca9420Irq, &pca9420BrownoutConfig, pca9420_cycles)) &&
+	    (SENSOR_ERROR_NONE == PCA9420_BROWNOUT_AddAction(&pca9420Brownout, pca9420_brownout_shed, NULL)))
+	{
+		pBrownout = &pca9420Brownout;
 	}
-	PCA9420_SW_reset(&pca9420Driver);
+	PCA9420_CLI_Init(&pca9420Cli, &pca9420Driver, &pca9420Wdog, &pca9420Telemetry, &pca9420Dvfs, &pca9420LowPower,
+	                 &pca9420Energy, &pca9420Sequence, pThermal, pJeita, pIlim, pChgProf, pBrownout,
+	                 &pca9420Verify);
 
 	while (1)/* Forever loop */
 	{
+		/* Serve what was posted while the last menu was busy on the bus. */
+		EVENT_LOOP_RunOnce();
+		TRACE_LOG_Process();
+
 		PRINTF("\r\n**********\033[35m MAIN MENU \033[37m**********\r\n");
 		PRINTF("1. Device Information\r\n");
 		PRINTF("2. PMIC Status\r\n");
@@ -3353,6 +3552,7 @@ int main(void)
 		PRINTF("6. Battery Charging Settings\r\n");
 		PRINTF("7. Voltage Regulator Group Settings\r\n");
 		PRINTF("8. Enable/Disable Interrupt\r\n");
+		PRINTF("9. Command Line Interface\r\n");
 		PRINTF("******************************\r\n");
 		SCANF("%d", &input);
 		switch (input)
@@ -3385,9 +3585,14 @@ int main(void)
 		case 8:
 			enable_disable_interrupt();
 			break;
+		case 9:
+			PCA9420_CLI_Run(&pca9420Cli);
+			break;
 		default:
 			PRINTF("Invalid input, Continuing reading temperature\r\n");
 		}
+		/* The menu just talked to the PMIC, let a due watchdog kick ride along. */
+		PCA9420_WDOG_Coalesce(&pca9420Wdog);
 		PRINTF("\r\nPress Enter to goto Main Menu\r\n");
 		do
 		{
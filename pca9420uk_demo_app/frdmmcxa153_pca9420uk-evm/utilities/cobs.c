@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file cobs.c
+ * @brief Consistent Overhead Byte Stuffing.
+ */
+
+#include "cobs.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+uint32_t COBS_Encode(const uint8_t *pSrc, uint32_t length, uint8_t *pDst)
+{
+    uint32_t code = 0U, out = 1U, i;
+    uint8_t run = 1U;
+
+    for (i = 0U; i < length; i++)
+    {
+        if (pSrc[i] != 0U)
+        {
+            pDst[out++] = pSrc[i];
+            run++;
+        }
+        if ((pSrc[i] == 0U) || (run == 0xFFU))
+        {
+            /* Close the group, its code byte holds the distance to the next zero. */
+            pDst[code] = run;
+            code = out++;
+            run = 1U;
+        }
+    }
+    pDst[code] = run;
+
+    return out;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file cobs.h
+ * @brief Consistent Overhead Byte Stuffing.
+
+    COBS removes every zero byte from a block at a cost of one byte per 254, so a zero
+    byte can delimit frames in a stream that also carries plain text. A receiver that
+    joins in the middle of a frame resynchronizes at the next zero.
+*/
+
+#ifndef __COBS_H__
+#define __COBS_H__
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Frame delimiter. */
+#define COBS_DELIMITER (0x00U)
+
+/*! @brief Largest encoding of length bytes, without the delimiter. */
+#define COBS_MAX_ENCODED_LEN(length) ((length) + ((length) / 254U) + 1U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to encode a block.
+ *  @param[in]   pSrc   Data to encode.
+ *  @param[in]   length Number of bytes.
+ *  @param[out]  pDst   Destination, at least COBS_MAX_ENCODED_LEN(length) bytes, must not overlap pSrc.
+ *  @return      uint32_t Number of encoded bytes, the delimiter is not appended.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint32_t COBS_Encode(const uint8_t *pSrc, uint32_t length, uint8_t *pDst);
+
+#endif // __COBS_H__
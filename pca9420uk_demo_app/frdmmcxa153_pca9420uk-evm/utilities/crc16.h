@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file crc16.h
+ * @brief CRC-16/CCITT-FALSE checksum, polynomial 0x1021, initial value 0xFFFF, no reflection.
+ */
+
+#ifndef __CRC16_H__
+#define __CRC16_H__
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Initial value of a running checksum. */
+#define CRC16_INIT (0xFFFFU)
+
+/*! @brief Checksum of a single buffer. */
+#define CRC16_Compute(pData, length) CRC16_Update(CRC16_INIT, (pData), (length))
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to continue a checksum over more data.
+ *  @details     This function works a nibble at a time from a 16 entry table.
+ *  @param[in]   crc    Checksum so far, CRC16_INIT for the first block.
+ *  @param[in]   pData  Data to add.
+ *  @param[in]   length Number of bytes.
+ *  @return      uint16_t The updated checksum.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *pData, uint32_t length);
+
+#endif // __CRC16_H__
@@ -0,0 +1,404 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  debug_console_dma.c
+ * @brief Lock-free multi-producer transmit ring for the debug console, drained by LPUART eDMA.
+ *        Producers reserve space with LDREX/STREX, copy, and the last producer to leave publishes
+ *        everything reserved so far, so an interrupt preempting a thread-level PRINTF never waits
+ *        for it. Ring positions are free running and only masked when indexing the buffer.
+ *        A message is reserved as a whole or dropped as a whole.
+ */
+
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+
+#include "board.h"
+#include "RTE_Device.h"
+#include "fsl_debug_console.h"
+#include "fsl_edma.h"
+#include "fsl_lpuart_edma.h"
+#include "fsl_str.h"
+#include "debug_console_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if ((DEBUG_CONSOLE_DMA_TX_BUFFER_LEN & (DEBUG_CONSOLE_DMA_TX_BUFFER_LEN - 1U)) != 0U)
+#error "DEBUG_CONSOLE_DMA_TX_BUFFER_LEN must be a power of two"
+#endif
+
+#define DEBUG_CONSOLE_DMA_RING_MASK (DEBUG_CONSOLE_DMA_TX_BUFFER_LEN - 1U)
+
+// eDMA channel of the debug UART, taken from the RTE USART settings of the board.
+#ifndef DEBUG_CONSOLE_DMA_TX_CHANNEL
+#if (BOARD_DEBUG_UART_INSTANCE == 0U)
+#define DEBUG_CONSOLE_DMA_TX_CHANNEL RTE_USART0_DMA_TX_CH
+#define DEBUG_CONSOLE_DMA_TX_REQUEST RTE_USART0_DMA_TX_PERI_SEL
+#define DEBUG_CONSOLE_DMA_BASE       RTE_USART0_DMA_TX_DMA_BASE
+#elif (BOARD_DEBUG_UART_INSTANCE == 4U)
+#define DEBUG_CONSOLE_DMA_TX_CHANNEL RTE_USART4_DMA_TX_CH
+#define DEBUG_CONSOLE_DMA_TX_REQUEST RTE_USART4_DMA_TX_PERI_SEL
+#define DEBUG_CONSOLE_DMA_BASE       RTE_USART4_DMA_TX_DMA_BASE
+#else
+#error "Define DEBUG_CONSOLE_DMA_TX_CHANNEL, DEBUG_CONSOLE_DMA_TX_REQUEST and DEBUG_CONSOLE_DMA_BASE"
+#endif
+#endif
+
+// Line buffer handed to StrFormatPrintf() through its buf argument. A longer message is only counted.
+typedef struct
+{
+    uint32_t length;
+    char data[DEBUG_CONSOLE_DMA_LINE_LEN];
+} debug_console_dma_line_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t s_txRing[DEBUG_CONSOLE_DMA_TX_BUFFER_LEN];
+static volatile uint32_t s_reserve; // End of the space handed out to producers.
+static volatile uint32_t s_commit;  // End of the data visible to the DMA.
+static volatile uint32_t s_tail;    // Start of the data not yet sent.
+static volatile uint32_t s_writers; // Producers between reserve and publish.
+static volatile uint32_t s_dmaBusy;
+static uint32_t s_dmaLength;
+static bool s_initialized = false;
+
+static edma_handle_t s_txEdmaHandle;
+static lpuart_edma_handle_t s_lpuartEdmaHandle;
+static debug_console_dma_stats_t s_stats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t DbgConsole_DmaAtomicAdd(volatile uint32_t *pValue, uint32_t delta)
+{
+    uint32_t value;
+
+    do
+    {
+        value = __LDREXW(pValue) + delta;
+    } while (__STREXW(value, pValue) != 0U);
+
+    return value;
+}
+
+static bool DbgConsole_DmaAtomicCas(volatile uint32_t *pValue, uint32_t expected, uint32_t desired)
+{
+    do
+    {
+        if (__LDREXW(pValue) != expected)
+        {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(desired, pValue) != 0U);
+
+    return true;
+}
+
+static void DbgConsole_DmaTrackHighWater(uint32_t used)
+{
+    uint32_t mark;
+
+    do
+    {
+        mark = __LDREXW(&s_stats.highWaterMark);
+        if (used <= mark)
+        {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(used, &s_stats.highWaterMark) != 0U);
+}
+
+// Starts a DMA transfer of the longest contiguous committed block when the DMA is idle.
+static void DbgConsole_DmaKick(void)
+{
+    lpuart_transfer_t xfer;
+    uint32_t tail, pending, index;
+
+    if (!s_initialized)
+    {
+        return; // DbgConsole_DmaInit() starts on what was queued before it.
+    }
+
+    for (;;)
+    {
+        if (!DbgConsole_DmaAtomicCas(&s_dmaBusy, 0U, 1U))
+        {
+            return; // The completion callback picks up the new data.
+        }
+        tail = s_tail;
+        pending = s_commit - tail;
+        if (pending != 0U)
+        {
+            break;
+        }
+        s_dmaBusy = 0U;
+        // A commit that raced with the busy flag saw the DMA busy and did not kick.
+        if (s_commit == tail)
+        {
+            return;
+        }
+    }
+
+    index = tail & DEBUG_CONSOLE_DMA_RING_MASK;
+    if (pending > (DEBUG_CONSOLE_DMA_TX_BUFFER_LEN - index))
+    {
+        pending = DEBUG_CONSOLE_DMA_TX_BUFFER_LEN - index;
+    }
+
+    s_dmaLength = pending;
+    xfer.txData = &s_txRing[index];
+    xfer.dataSize = pending;
+    if (kStatus_Success != LPUART_SendEDMA((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR, &s_lpuartEdmaHandle, &xfer))
+    {
+        s_dmaBusy = 0U;
+        return;
+    }
+    (void)DbgConsole_DmaAtomicAdd(&s_stats.dmaTransfers, 1U);
+}
+
+static void DbgConsole_DmaTxCallback(LPUART_Type *base, lpuart_edma_handle_t *handle, status_t status, void *userData)
+{
+    if (kStatus_LPUART_TxIdle == status)
+    {
+        s_tail += s_dmaLength;
+        s_dmaBusy = 0U;
+        DbgConsole_DmaKick();
+    }
+}
+
+static bool DbgConsole_DmaReserve(uint32_t length, uint32_t *pStart)
+{
+    uint32_t start, used;
+
+    do
+    {
+        start = __LDREXW(&s_reserve);
+        used = start + length - s_tail;
+        if (used > DEBUG_CONSOLE_DMA_TX_BUFFER_LEN)
+        {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(start + length, &s_reserve) != 0U);
+
+    DbgConsole_DmaTrackHighWater(used);
+    *pStart = start;
+
+    return true;
+}
+
+// Leaves the producer section. The last producer out publishes all reserved space: any producer
+// that preempted it has finished copying, and a preempted one would still be counted in s_writers.
+static void DbgConsole_DmaRelease(void)
+{
+    uint32_t end, commit;
+
+    if (DbgConsole_DmaAtomicAdd(&s_writers, (uint32_t)-1) != 0U)
+    {
+        return;
+    }
+
+    end = s_reserve;
+    do
+    {
+        commit = __LDREXW(&s_commit);
+        if ((int32_t)(end - commit) <= 0)
+        {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(end, &s_commit) != 0U);
+}
+
+status_t DbgConsole_DmaInit(void)
+{
+    edma_config_t edmaConfig;
+
+    EDMA_GetDefaultConfig(&edmaConfig);
+    EDMA_Init(DEBUG_CONSOLE_DMA_BASE, &edmaConfig);
+#if defined(FSL_FEATURE_EDMA_HAS_CHANNEL_MUX) && FSL_FEATURE_EDMA_HAS_CHANNEL_MUX
+    EDMA_SetChannelMux(DEBUG_CONSOLE_DMA_BASE, DEBUG_CONSOLE_DMA_TX_CHANNEL, DEBUG_CONSOLE_DMA_TX_REQUEST);
+#endif
+    EDMA_CreateHandle(&s_txEdmaHandle, DEBUG_CONSOLE_DMA_BASE, DEBUG_CONSOLE_DMA_TX_CHANNEL);
+    LPUART_TransferCreateHandleEDMA((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR, &s_lpuartEdmaHandle,
+                                    DbgConsole_DmaTxCallback, NULL, &s_txEdmaHandle, NULL);
+
+    DbgConsole_DmaResetStats();
+    s_initialized = true;
+    DbgConsole_DmaKick();
+
+    return kStatus_Success;
+}
+
+// Enters the producer section with length bytes reserved, or drops the message on overflow.
+static bool DbgConsole_DmaBegin(uint32_t length, uint32_t *pStart)
+{
+    for (;;)
+    {
+        (void)DbgConsole_DmaAtomicAdd(&s_writers, 1U);
+        if ((length <= DEBUG_CONSOLE_DMA_TX_BUFFER_LEN) && DbgConsole_DmaReserve(length, pStart))
+        {
+            return true;
+        }
+        DbgConsole_DmaRelease();
+
+#if (DEBUG_CONSOLE_DMA_OVERFLOW_POLICY == DEBUG_CONSOLE_DMA_OVERFLOW_BLOCK)
+        // Only thread context may wait, the DMA completion interrupt has to be able to run.
+        if (s_initialized && (length <= DEBUG_CONSOLE_DMA_TX_BUFFER_LEN) && (0U == __get_IPSR()))
+        {
+            (void)DbgConsole_DmaAtomicAdd(&s_stats.blockedWaits, 1U);
+            DbgConsole_DmaKick();
+            while ((s_reserve + length - s_tail) > DEBUG_CONSOLE_DMA_TX_BUFFER_LEN)
+            {
+            }
+            continue;
+        }
+#endif
+        (void)DbgConsole_DmaAtomicAdd(&s_stats.messagesDropped, 1U);
+        (void)DbgConsole_DmaAtomicAdd(&s_stats.bytesDropped, length);
+        return false;
+    }
+}
+
+// Leaves the producer section and hands the message to the DMA.
+static void DbgConsole_DmaEnd(uint32_t length)
+{
+    DbgConsole_DmaRelease();
+    DbgConsole_DmaKick();
+    (void)DbgConsole_DmaAtomicAdd(&s_stats.bytesQueued, length);
+}
+
+int DbgConsole_DmaWrite(const uint8_t *pData, size_t length)
+{
+    uint32_t start, index, first;
+
+    if (0U == length)
+    {
+        return 0;
+    }
+
+    if (!DbgConsole_DmaBegin((uint32_t)length, &start))
+    {
+        return -1;
+    }
+
+    index = start & DEBUG_CONSOLE_DMA_RING_MASK;
+    first = DEBUG_CONSOLE_DMA_TX_BUFFER_LEN - index;
+    if (first >= length)
+    {
+        (void)memcpy(&s_txRing[index], pData, length);
+    }
+    else
+    {
+        (void)memcpy(&s_txRing[index], pData, first);
+        (void)memcpy(&s_txRing[0], &pData[first], length - first);
+    }
+    DbgConsole_DmaEnd((uint32_t)length);
+
+    return (int)length;
+}
+
+static void DbgConsole_DmaLineCallback(char *buf, int32_t *indicator, char val, int len)
+{
+    debug_console_dma_line_t *pLine = (debug_console_dma_line_t *)(void *)buf;
+
+    while (len-- > 0)
+    {
+        if (pLine->length < DEBUG_CONSOLE_DMA_LINE_LEN)
+        {
+            pLine->data[pLine->length] = val;
+        }
+        pLine->length++;
+        (*indicator)++;
+    }
+}
+
+// Formats straight into a ring reservation, buf points to the free running write position.
+static void DbgConsole_DmaRingCallback(char *buf, int32_t *indicator, char val, int len)
+{
+    uint32_t *pPosition = (uint32_t *)(void *)buf;
+
+    while (len-- > 0)
+    {
+        s_txRing[(*pPosition)++ & DEBUG_CONSOLE_DMA_RING_MASK] = (uint8_t)val;
+        (*indicator)++;
+    }
+}
+
+int DbgConsole_DmaVprintf(const char *fmt_s, va_list ap)
+{
+    debug_console_dma_line_t line;
+    uint32_t position;
+    va_list again;
+    int count, result;
+
+    // The common short message takes one formatting pass into the line buffer. A longer one is
+    // formatted again into its reservation, so it is never split and never half dropped.
+    va_copy(again, ap);
+    line.length = 0U;
+    count = StrFormatPrintf(fmt_s, ap, (char *)&line, DbgConsole_DmaLineCallback);
+    if (line.length <= DEBUG_CONSOLE_DMA_LINE_LEN)
+    {
+        result = DbgConsole_DmaWrite((const uint8_t *)line.data, line.length);
+    }
+    else if (DbgConsole_DmaBegin(line.length, &position))
+    {
+        (void)StrFormatPrintf(fmt_s, again, (char *)&position, DbgConsole_DmaRingCallback);
+        DbgConsole_DmaEnd(line.length);
+        result = 0;
+    }
+    else
+    {
+        result = -1;
+    }
+    va_end(again);
+
+    return (result < 0) ? -1 : count;
+}
+
+int DbgConsole_DmaPrintf(const char *fmt_s, ...)
+{
+    va_list ap;
+    int result;
+
+    va_start(ap, fmt_s);
+    result = DbgConsole_DmaVprintf(fmt_s, ap);
+    va_end(ap);
+
+    return result;
+}
+
+void DbgConsole_DmaFlush(void)
+{
+    if (!s_initialized)
+    {
+        return;
+    }
+
+    DbgConsole_DmaKick();
+    while ((s_tail != s_reserve) || (s_dmaBusy != 0U))
+    {
+    }
+}
+
+void DbgConsole_DmaGetStats(debug_console_dma_stats_t *pStats)
+{
+    *pStats = s_stats;
+}
+
+void DbgConsole_DmaResetStats(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    (void)memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.highWaterMark = s_reserve - s_tail;
+    EnableGlobalIRQ(primask);
+}
+
+#endif /* DEBUG_CONSOLE_TRANSFER_DMA_RING */
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file debug_console_dma.h
+ * @brief Non-blocking debug console transmit through a ring buffer drained by LPUART eDMA.
+
+    PRINTF formats into a local line buffer, the line is committed into a lock-free
+    ring and the LPUART eDMA transfer drains the ring in the background. Define
+    DEBUG_CONSOLE_TRANSFER_DMA_RING=1 in the project settings to route all console
+    output here, PRINTF, PUTCHAR and the input echo, so nothing bypasses the ring;
+    without it this file compiles to nothing. A message is reserved in the ring as a
+    whole or dropped as a whole, one longer than DEBUG_CONSOLE_DMA_LINE_LEN is
+    formatted a second time straight into its reservation. Output queued before
+    DbgConsole_DmaInit() waits in the ring until it.
+*/
+
+#ifndef __DEBUG_CONSOLE_DMA_H__
+#define __DEBUG_CONSOLE_DMA_H__
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Overflow policies of the transmit ring. */
+#define DEBUG_CONSOLE_DMA_OVERFLOW_DROP  0U /*!< Drop the whole message and count it. */
+#define DEBUG_CONSOLE_DMA_OVERFLOW_BLOCK 1U /*!< Wait for the DMA to free space, drop in interrupt context. */
+
+/*! @brief Size of the transmit ring in bytes, must be a power of two. */
+#ifndef DEBUG_CONSOLE_DMA_TX_BUFFER_LEN
+#define DEBUG_CONSOLE_DMA_TX_BUFFER_LEN (1024U)
+#endif
+
+/*! @brief Selected overflow policy. */
+#ifndef DEBUG_CONSOLE_DMA_OVERFLOW_POLICY
+#define DEBUG_CONSOLE_DMA_OVERFLOW_POLICY DEBUG_CONSOLE_DMA_OVERFLOW_DROP
+#endif
+
+/*! @brief Size of the on-stack buffer a message is formatted into before it is committed, longer ones take two passes. */
+#ifndef DEBUG_CONSOLE_DMA_LINE_LEN
+#define DEBUG_CONSOLE_DMA_LINE_LEN (128U)
+#endif
+
+/*!
+ * @brief Transmit ring statistics.
+ */
+typedef struct
+{
+    uint32_t bytesQueued;      /*!< Bytes accepted into the ring. */
+    uint32_t bytesDropped;     /*!< Bytes discarded on overflow. */
+    uint32_t messagesDropped;  /*!< Messages discarded on overflow. */
+    uint32_t blockedWaits;     /*!< Messages which had to wait for ring space. */
+    uint32_t dmaTransfers;     /*!< DMA transfers started. */
+    uint32_t highWaterMark;    /*!< Largest ring fill level in bytes. */
+} debug_console_dma_stats_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to attach the DMA transmit path to the debug UART.
+ *  @details     This function creates the eDMA and LPUART eDMA handles for the debug UART and
+ *               starts sending what was queued before. The UART itself stays configured by
+ *               BOARD_InitDebugConsole().
+ *  @param[in]   void.
+ *  @return      status_t kStatus_Success.
+ *  @constraints Call after BOARD_InitDebugConsole().
+ *  @reeentrant  No
+ */
+status_t DbgConsole_DmaInit(void);
+
+/*! @brief       Function to queue raw bytes for transmission.
+ *  @details     This function copies the bytes into the ring and starts the DMA if it is idle.
+ *  @param[in]   pData  Bytes to send.
+ *  @param[in]   length Number of bytes.
+ *  @return      int Number of bytes queued, -1 when the message was dropped.
+ *  @constraints None, callable from thread and interrupt context.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_DmaWrite(const uint8_t *pData, size_t length);
+
+/*! @brief       Function to format and queue a message.
+ *  @details     printf compatible replacement of DbgConsole_Printf() which never waits for the UART.
+ *  @param[in]   fmt_s Format string.
+ *  @return      int Number of characters formatted, -1 when the message was dropped.
+ *  @constraints None, callable from thread and interrupt context.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_DmaPrintf(const char *fmt_s, ...);
+
+/*! @brief       Function to format and queue a message from a va_list.
+ *  @param[in]   fmt_s Format string.
+ *  @param[in]   ap    Argument list.
+ *  @return      int Number of characters formatted, -1 when the message was dropped.
+ *  @constraints None, callable from thread and interrupt context.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_DmaVprintf(const char *fmt_s, va_list ap);
+
+/*! @brief       Function to wait until the ring is drained.
+ *  @details     Use before blocking console I/O, low power entry or a reset so no output is lost.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ */
+void DbgConsole_DmaFlush(void);
+
+/*! @brief       Function to read the ring statistics.
+ *  @param[out]  pStats Destination of the statistics.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+void DbgConsole_DmaGetStats(debug_console_dma_stats_t *pStats);
+
+/*! @brief       Function to clear the ring statistics, the high-water mark restarts at the current fill level.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+void DbgConsole_DmaResetStats(void);
+
+#endif // __DEBUG_CONSOLE_DMA_H__
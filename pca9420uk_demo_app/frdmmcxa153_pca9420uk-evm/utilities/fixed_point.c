@@ -0,0 +1,178 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fixed_point.c
+ * @brief Integer only formatting and parsing of fixed-point quantities.
+ */
+
+#include <stddef.h>
+#include "fixed_point.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define FIXPT_MAX_FRAC_DIGITS (9U)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+char *FIXPT_Format(char *pBuffer, int32_t value, uint8_t fracDigits)
+{
+    char digits[FIXPT_STR_LEN];
+    uint32_t magnitude, count = 0U, index = 0U;
+
+    if (fracDigits > FIXPT_MAX_FRAC_DIGITS)
+    {
+        fracDigits = FIXPT_MAX_FRAC_DIGITS;
+    }
+
+    magnitude = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+
+    /* Least significant digit first, at least one digit in front of the point. */
+    do
+    {
+        digits[count++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while ((magnitude != 0U) || (count <= fracDigits));
+
+    if (value < 0)
+    {
+        pBuffer[index++] = '-';
+    }
+    while (count > 0U)
+    {
+        if (count == fracDigits)
+        {
+            pBuffer[index++] = '.';
+        }
+        pBuffer[index++] = digits[--count];
+    }
+    pBuffer[index] = '\0';
+
+    return pBuffer;
+}
+
+bool FIXPT_Parse(const char *pString, uint8_t fracDigits, int32_t *pValue, const char **ppEnd)
+{
+    const char *p = pString;
+    uint64_t magnitude = 0U;
+    uint8_t decimals = 0U;
+    bool negative = false, digits = false;
+
+    if ((pString == NULL) || (pValue == NULL) || (fracDigits > FIXPT_MAX_FRAC_DIGITS))
+    {
+        return false;
+    }
+
+    while ((*p == ' ') || (*p == '\t'))
+    {
+        p++;
+    }
+    if ((*p == '-') || (*p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    for (; (*p >= '0') && (*p <= '9'); p++)
+    {
+        magnitude = magnitude * 10U + (uint32_t)(*p - '0');
+        digits = true;
+        if (magnitude > 0x80000000U)
+        {
+            return false;
+        }
+    }
+
+    if (*p == '.')
+    {
+        for (p++; (*p >= '0') && (*p <= '9'); p++)
+        {
+            digits = true;
+            if (decimals < fracDigits)
+            {
+                magnitude = magnitude * 10U + (uint32_t)(*p - '0');
+                decimals++;
+            }
+            else if (*p != '0')
+            {
+                /* More resolution than the result can hold. */
+                return false;
+            }
+        }
+    }
+
+    if (!digits)
+    {
+        return false;
+    }
+
+    for (; decimals < fracDigits; decimals++)
+    {
+        magnitude *= 10U;
+        if (magnitude > 0x80000000U)
+        {
+            return false;
+        }
+    }
+
+    if ((magnitude > 0x80000000U) || (!negative && (magnitude == 0x80000000U)))
+    {
+        return false;
+    }
+
+    *pValue = negative ? (int32_t)(0U - (uint32_t)magnitude) : (int32_t)magnitude;
+    if (ppEnd != NULL)
+    {
+        *ppEnd = p;
+    }
+
+    return true;
+}
+
+bool FIXPT_ParseMilli(const char *pString, int32_t *pMilli)
+{
+    const char *pEnd;
+    int32_t value;
+
+    if (!FIXPT_Parse(pString, 3U, &value, &pEnd))
+    {
+        return false;
+    }
+
+    while ((*pEnd == ' ') || (*pEnd == '\t'))
+    {
+        pEnd++;
+    }
+    if (*pEnd == 'm')
+    {
+        /* Already in milli units, fractions of a milli unit are not representable. */
+        if ((value % 1000) != 0)
+        {
+            return false;
+        }
+        value /= 1000;
+        pEnd++;
+    }
+
+    while (((*pEnd >= 'a') && (*pEnd <= 'z')) || ((*pEnd >= 'A') && (*pEnd <= 'Z')))
+    {
+        pEnd++;
+    }
+    while ((*pEnd == ' ') || (*pEnd == '\t'))
+    {
+        pEnd++;
+    }
+    if (*pEnd != '\0')
+    {
+        return false;
+    }
+
+    *pMilli = value;
+
+    return true;
+}
@@ -55,6 +55,8 @@ typedef int (*PUTCHAR_FUNC)(int a);
 #if ((SDK_DEBUGCONSOLE == DEBUGCONSOLE_REDIRECT_TO_SDK) || defined(SDK_DEBUGCONSOLE_UART))
 /*! @brief Debug UART state information. */
 static debug_console_state_t s_debugConsole;
+/*! @brief Receive wait hook, NULL for a plain blocking read. */
+static void (*s_debugConsoleRxWait)(void);
 #endif
 
 /*******************************************************************************
@@ -169,7 +171,12 @@ int DbgConsole_Vprintf(const char *fmt_s, va_list formatStringArg)
         return -1;
     }
 
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+    /* Blocking output would interleave with the DMA transmit ring. */
+    result = DbgConsole_DmaVprintf(fmt_s, formatStringArg);
+#else
     result = DbgConsole_PrintfFormattedData(DbgConsole_Putchar, fmt_s, formatStringArg);
+#endif
 
     return result;
 }
@@ -182,9 +189,15 @@ int DbgConsole_Putchar(int ch)
     {
         return -1;
     }
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+    uint8_t c = (uint8_t)ch;
+
+    return (DbgConsole_DmaWrite(&c, 1U) < 0) ? -1 : 1;
+#else
     (void)s_debugConsole.putChar((hal_uart_handle_t)&s_debugConsole.uartHandleBuffer[0], (uint8_t *)(&ch), 1);
 
     return 1;
+#endif
 }
 
 /* See fsl_debug_console.h for documentation of this function. */
@@ -246,6 +259,12 @@ int DbgConsole_Scanf(char *fmt_s, ...)
     return (int)result;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetRxWaitHook(void (*hook)(void))
+{
+    s_debugConsoleRxWait = hook;
+}
+
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Getchar(void)
 {
@@ -255,6 +274,10 @@ int DbgConsole_Getchar(void)
     {
         return -1;
     }
+    if (NULL != s_debugConsoleRxWait)
+    {
+        s_debugConsoleRxWait();
+    }
     while (kStatus_HAL_UartSuccess !=
            s_debugConsole.getChar((hal_uart_handle_t)&s_debugConsole.uartHandleBuffer[0], (uint8_t *)(&ch), 1))
     {
@@ -264,6 +287,52 @@ int DbgConsole_Getchar(void)
     return (int)ch;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_ReadLine(uint8_t *buf, size_t size)
+{
+    int i = 0;
+    int ch;
+
+    while (i < (int)size)
+    {
+        ch = DbgConsole_Getchar();
+        if (ch < 0)
+        {
+            return -1;
+        }
+
+        if ((ch == '\r') || (ch == '\n'))
+        {
+            /* End of Line, empty lines are skipped. */
+            if (i == 0)
+            {
+                continue;
+            }
+            (void)DbgConsole_Putchar('\r');
+            (void)DbgConsole_Putchar('\n');
+            break;
+        }
+
+        if ((ch == 0x7F) || (ch == '\b'))
+        {
+            if (i > 0)
+            {
+                i--;
+                (void)DbgConsole_Putchar('\b');
+                (void)DbgConsole_Putchar(' ');
+                (void)DbgConsole_Putchar('\b');
+            }
+            continue;
+        }
+
+        (void)DbgConsole_Putchar(ch);
+        buf[i++] = (uint8_t)ch;
+    }
+    buf[i] = (uint8_t)'\0';
+
+    return i;
+}
+
 /*************Code for process formatted data*******************************/
 /*!
  * @brief This function puts padding character.
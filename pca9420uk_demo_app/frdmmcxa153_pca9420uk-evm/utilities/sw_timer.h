@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file sw_timer.h
+ * @brief Software timers on a hierarchical timer wheel.
+
+    This file provides one-shot and periodic software timers driven by the systick
+    interrupt. The interrupt only counts ticks, expired timers are run from
+    SW_TIMER_Process() in thread context so callbacks may use the blocking drivers.
+*/
+
+#ifndef __SW_TIMER_H__
+#define __SW_TIMER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Tick rate of the timer wheel in Hz. */
+#ifndef SW_TIMER_TICK_HZ
+#define SW_TIMER_TICK_HZ 1000u
+#endif
+
+/*! @brief Converts milli seconds into timer ticks, rounding up. */
+#define SW_TIMER_MS_TO_TICKS(ms) ((uint32_t)(((uint64_t)(ms) * SW_TIMER_TICK_HZ + 999u) / 1000u))
+
+/*! @brief Largest timeout or period in ticks, longer values are clamped. */
+#define SW_TIMER_MAX_TICKS 0x01FFFFFFu
+
+/*! @brief Returned by SW_TIMER_GetTicksToNextExpiry() when no timer is armed. */
+#define SW_TIMER_NO_EXPIRY 0xFFFFFFFFu
+
+/*! @brief Timer expiry callback, called from SW_TIMER_Process(). */
+typedef void (*sw_timer_callback_t)(void *pUserData);
+
+/*! @brief Software timer object. Owned by the caller, linked into the wheel while armed. */
+typedef struct _sw_timer
+{
+    struct _sw_timer *next;       /*!< Next timer in the same slot. */
+    struct _sw_timer **pprev;     /*!< Link pointing at this timer, NULL when not armed. */
+    uint32_t expires;             /*!< Absolute expiry tick. */
+    uint32_t period;              /*!< Reload in ticks, 0 for a one-shot timer. */
+    sw_timer_callback_t callback; /*!< Expiry callback. */
+    void *pUserData;              /*!< Argument passed to the callback. */
+    uint8_t level;                /*!< Wheel level the timer is linked into. */
+    uint8_t slot;                 /*!< Slot within that level. */
+} sw_timer_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to initialize the timer wheel.
+ *  @details     This function empties the wheel and starts the systick as a SW_TIMER_TICK_HZ tick source.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints BOARD_SystickEnable() and the clock setup must have been done before.
+ *  @reeentrant  No
+ */
+void SW_TIMER_Init(void);
+
+/*! @brief       Function to prepare a timer object.
+ *  @details     This function binds the callback to the timer, the timer is left stopped.
+ *  @param[in]   pTimer    Pointer to the timer object.
+ *  @param[in]   callback  Function called when the timer expires.
+ *  @param[in]   pUserData Argument passed to the callback.
+ *  @return      void.
+ *  @constraints Must not be called on an armed timer.
+ *  @reeentrant  Yes
+ */
+void SW_TIMER_Setup(sw_timer_t *pTimer, sw_timer_callback_t callback, void *pUserData);
+
+/*! @brief       Function to arm a timer.
+ *  @details     This function (re)starts the timer in O(1). An armed timer is stopped first.
+ *  @param[in]   pTimer  Pointer to the timer object.
+ *  @param[in]   timeout Ticks until the first expiry, 0 is treated as 1.
+ *  @param[in]   period  Ticks between subsequent expiries, 0 for a one-shot timer.
+ *  @return      void.
+ *  @constraints Thread context only, it may be called from a timer callback.
+ *  @reeentrant  No
+ */
+void SW_TIMER_Start(sw_timer_t *pTimer, uint32_t timeout, uint32_t period);
+
+/*! @brief       Function to cancel a timer.
+ *  @details     This function unlinks the timer from the wheel in O(1). Stopping a stopped timer is a no-op.
+ *  @param[in]   pTimer Pointer to the timer object.
+ *  @return      void.
+ *  @constraints Thread context only, it may be called from a timer callback.
+ *  @reeentrant  No
+ */
+void SW_TIMER_Stop(sw_timer_t *pTimer);
+
+/*! @brief       Function to check whether a timer is armed.
+ *  @param[in]   pTimer Pointer to the timer object.
+ *  @return      bool true when the timer is armed.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+bool SW_TIMER_IsActive(const sw_timer_t *pTimer);
+
+/*! @brief       Function to read the tick counter.
+ *  @details     This function returns the number of ticks since SW_TIMER_Init(), including ticks
+ *               which were counted by the interrupt but not yet processed. It wraps at 2^32.
+ *  @param[in]   void.
+ *  @return      uint32_t The current tick.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint32_t SW_TIMER_GetTicks(void);
+
+/*! @brief       Function to run expired timers.
+ *  @details     This function advances the wheel over all ticks counted since the last call
+ *               and invokes the callbacks of the timers that expired on the way.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Call periodically from the main loop (deferred context), never from an interrupt.
+ *  @reeentrant  No
+ */
+void SW_TIMER_Process(void);
+
+/*! @brief       Function to query the next due timer.
+ *  @details     This function returns the number of ticks until the wheel next needs servicing.
+ *               The value may be earlier than the actual expiry when a higher wheel level has to be
+ *               cascaded first, it is never later.
+ *  @param[in]   void.
+ *  @return      uint32_t Ticks until the next due timer, 0 if SW_TIMER_Process() is due now
+ *               or ::SW_TIMER_NO_EXPIRY when no timer is armed.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+uint32_t SW_TIMER_GetTicksToNextExpiry(void);
+
+/*! @brief       Function to sleep until the next due timer.
+ *  @details     This function suppresses the periodic tick and executes WFI until the next due timer
+ *               or any other interrupt. Ticks spent asleep are credited to the wheel.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Thread context only. Call SW_TIMER_Process() after it returns.
+ *  @reeentrant  No
+ */
+void SW_TIMER_Idle(void);
+
+#endif // __SW_TIMER_H__
@@ -13,6 +13,7 @@
 */
 
 #include "issdk_hal.h"
+#include "systick_utils.h"
 
 // SysTick register definitions based on CMSIS definitions.
 #define SYST_CSR SysTick->CTRL // SysTick Control & Status Register
@@ -22,14 +23,54 @@
 uint32_t g_ovf_stamp;
 volatile uint32_t g_ovf_counter = 0;
 
+// Reload value of the periodic tick, 0 when systick free runs over the full 24 bit range.
+static uint32_t g_tick_reload = 0;
+// Rate of the periodic tick, 0 when systick free runs.
+static uint32_t g_tick_hz = 0;
+static systick_tick_callback_t g_tick_callback = NULL;
+
+// Accounts one counter wrap.
+static void BOARD_SystickWrap(void)
+{
+    g_ovf_counter += 1;
+    if (g_tick_callback != NULL)
+    {
+        g_tick_callback();
+    }
+}
+
 #ifndef SDK_OS_FREE_RTOS
 // SDK specific SysTick Interrupt Handler
 void SysTick_Handler(void)
 {
-    g_ovf_counter += 1;
+    BOARD_SystickWrap();
 }
 #endif
 
+// Reads the overflow count and the 24 bit counter as one snapshot. A wrap the SysTick interrupt could not
+// service yet, interrupts masked or a higher priority handler running, is accounted here instead, so the
+// elapsed time keeps counting.
+static void BOARD_SystickRead(uint32_t *pOvf, int32_t *pCount)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        BOARD_SystickWrap();
+    }
+    *pCount = SYST_CVR & 0x00FFFFFF;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        // Wrapped right after the check, the count read may belong to either side of it.
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        BOARD_SystickWrap();
+        *pCount = SYST_CVR & 0x00FFFFFF;
+    }
+    *pOvf = g_ovf_counter;
+    EnableGlobalIRQ(primask);
+}
+
 // ARM-core specific function to enable systicks.
 void BOARD_SystickEnable(void)
 {
@@ -43,18 +84,19 @@ void BOARD_SystickEnable(void)
 void BOARD_SystickStart(int32_t *pStart)
 {
     // Store the 24 bit systick timer.
-    g_ovf_stamp = g_ovf_counter;
-    *pStart = SYST_CVR & 0x00FFFFFF;
+    BOARD_SystickRead(&g_ovf_stamp, pStart);
 }
 
 // ARM-core specific function to compute the elapsed systick timer ticks.
 int32_t BOARD_SystickElapsedTicks(int32_t *pStart)
 {
-    int32_t elapsed;
+    int32_t elapsed, count;
+    uint32_t ovf;
 
     // Subtract the stored start ticks and check for wraparound down through zero.
-    elapsed = *pStart - (SYST_CVR & 0x00FFFFFF);
-    elapsed += SYST_RVR * (g_ovf_counter - g_ovf_stamp);
+    BOARD_SystickRead(&ovf, &count);
+    elapsed = *pStart - count;
+    elapsed += (SYST_RVR + 1u) * (ovf - g_ovf_stamp);
 
     return elapsed;
 }
@@ -88,3 +130,103 @@ void BOARD_DELAY_ms(uint32_t delay_ms)
         elapsed = BOARD_SystickElapsedTicks(&start);
     } while(COUNT_TO_MSEC(elapsed, systemCoreClock) < delay_ms);
 }
+
+// ARM-core specific function to run systick as a periodic tick source.
+void BOARD_SystickEnableTick(uint32_t tickHz, systick_tick_callback_t callback)
+{
+    uint32_t reload = CLOCK_GetFreq(kCLOCK_CoreSysClk) / tickHz - 1u;
+
+    if (reload > 0x00FFFFFFu)
+    {
+        reload = 0x00FFFFFFu;
+    }
+
+    SYST_CSR &= ~SysTick_CTRL_ENABLE_Msk;
+    g_tick_callback = callback;
+    g_tick_reload = reload;
+    g_tick_hz = tickHz;
+    SYST_RVR = reload;
+    SYST_CVR = 0u; // Restart the count from the new reload value.
+    SYST_CSR = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+// ARM-core specific function to keep the periodic tick rate over a core clock change.
+void BOARD_SystickUpdateClock(void)
+{
+    if (0u != g_tick_hz)
+    {
+        BOARD_SystickEnableTick(g_tick_hz, g_tick_callback);
+    }
+}
+
+// ARM-core specific function to sleep with the periodic tick suppressed.
+uint32_t BOARD_SystickSleep(uint32_t ticks)
+{
+    uint32_t primask, period, remain, maxTicks, sleepLoad, csr, current, next, skipped;
+
+    if ((0u == g_tick_reload) || (ticks < 2u))
+    {
+        // Nothing to suppress, the next tick interrupt wakes the core.
+        __DSB();
+        __WFI();
+        return 0u;
+    }
+
+    period = g_tick_reload + 1u;
+    primask = DisableGlobalIRQ();
+
+    SYST_CSR &= ~SysTick_CTRL_ENABLE_Msk;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        // A tick is already pending, let it be serviced first.
+        SYST_CSR |= SysTick_CTRL_ENABLE_Msk;
+        EnableGlobalIRQ(primask);
+        return 0u;
+    }
+
+    // Cycles until the next tick boundary plus whole periods for the remaining ticks.
+    remain = SYST_CVR;
+    maxTicks = (0x00FFFFFFu - remain) / period + 1u;
+    if (ticks > maxTicks)
+    {
+        ticks = maxTicks;
+    }
+    sleepLoad = remain + (ticks - 1u) * period;
+
+    SYST_RVR = sleepLoad;
+    SYST_CVR = 0u;
+    SYST_CSR |= SysTick_CTRL_ENABLE_Msk;
+    SYST_RVR = g_tick_reload; // Used from the next wrap onwards.
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    csr = SYST_CSR;
+    SYST_CSR = csr & ~SysTick_CTRL_ENABLE_Msk;
+    if ((csr & SysTick_CTRL_COUNTFLAG_Msk) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        // Slept the full period, the pending tick interrupt accounts for the last tick.
+        skipped = ticks - 1u;
+        SYST_CSR |= SysTick_CTRL_ENABLE_Msk;
+    }
+    else
+    {
+        // Woken early: tick boundaries sit at multiples of period below sleepLoad.
+        current = SYST_CVR;
+        skipped = (ticks - 1u) - current / period;
+        next = current % period;
+        if (next < 2u)
+        {
+            next += period;
+            skipped += 1u;
+        }
+        SYST_RVR = next - 1u;
+        SYST_CVR = 0u;
+        SYST_CSR |= SysTick_CTRL_ENABLE_Msk;
+        SYST_RVR = g_tick_reload;
+    }
+
+    EnableGlobalIRQ(primask);
+    return skipped;
+}
@@ -16,6 +16,11 @@
 #ifndef __SYSTICK_UTILS_H__
 #define __SYSTICK_UTILS_H__
 
+#include <stdint.h>
+
+/*! @brief Callback invoked from the SysTick interrupt once per tick period. */
+typedef void (*systick_tick_callback_t)(void);
+
 /*! @brief       Function to enable systicks framework.
  *  @details     This function initializes the CMSIS define ARM core specific systick implementation.
  *  @param[in]   void.
@@ -39,7 +44,8 @@ void BOARD_SystickStart(int32_t *pStart);
  *               of the current tick to the one in the arguement.
  *  @param[in]   pStart Pointer to the variable contating the start systick.
  *  @return      int32_t The elapsed systicks.
- *  @constraints None.
+ *  @constraints Works with interrupts masked as long as it is called at least once per counter wrap, a
+ *               wrap that is still pending is accounted by the call itself.
  *  @reeentrant  Yes
  */
 int32_t BOARD_SystickElapsedTicks(int32_t *pStart);
@@ -60,9 +66,46 @@ uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart);
  *               to determine time delays.
  *  @param[in]   delay_ms The required time to block.
  *  @return      void.
- *  @constraints None.
+ *  @constraints None, also usable with interrupts masked.
  *  @reeentrant  Yes
  */
 void BOARD_DELAY_ms(uint32_t delay_ms);
 
+/*! @brief       Function to run systick as a periodic tick source.
+ *  @details     This function reprograms the systick reload value so that the counter wraps tickHz times
+ *               per second and installs a callback which is invoked from the SysTick interrupt on each wrap.
+ *               The elapsed ticks/time APIs keep working, they simply see a shorter reload value.
+ *  @param[in]   tickHz   Required tick rate in Hz.
+ *  @param[in]   callback Function invoked from interrupt context on every tick, NULL to remove it.
+ *  @return      void.
+ *  @constraints BOARD_SystickEnable() must have been called. The core clock must not change afterwards
+ *               without calling this function again.
+ *  @reeentrant  No
+ */
+void BOARD_SystickEnableTick(uint32_t tickHz, systick_tick_callback_t callback);
+
+/*! @brief       Function to reprogram the periodic tick for a new core clock.
+ *  @details     This function repeats BOARD_SystickEnableTick() with the current rate and callback, the
+ *               partial tick in progress is lost. Nothing is done while systick free runs.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Call right after every core clock change. Elapsed ticks measurements in progress are
+ *               invalidated.
+ *  @reeentrant  No
+ */
+void BOARD_SystickUpdateClock(void);
+
+/*! @brief       Function to sleep for a number of tick periods with the tick interrupt suppressed.
+ *  @details     This function stretches the systick reload so that only one interrupt fires after ticks
+ *               periods, executes WFI and resynchronises the counter to the tick grid on wake-up.
+ *               The core may be woken earlier by any other interrupt.
+ *  @param[in]   ticks Maximum number of tick periods to sleep. Clamped to the 24 bit counter range.
+ *  @return      uint32_t Number of whole tick periods that passed without a tick interrupt being
+ *               delivered; the caller has to account for them.
+ *  @constraints BOARD_SystickEnableTick() must have been called. Any in-progress BOARD_SystickElapsedTicks()
+ *               measurement is invalidated by the stretched reload.
+ *  @reeentrant  No
+ */
+uint32_t BOARD_SystickSleep(uint32_t ticks);
+
 #endif // __SYSTICK_UTILS_H__
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_log.c
+ * @brief Tokenized binary trace logging.
+ */
+
+#include <stdarg.h>
+#include "trace_log.h"
+#include "sw_timer.h"
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+#include "debug_console_dma.h"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if ((TRACE_LOG_BUFFER_LEN & (TRACE_LOG_BUFFER_LEN - 1U)) != 0U)
+#error "TRACE_LOG_BUFFER_LEN must be a power of two."
+#endif
+
+/* Largest LEB128 encoding of a 32-bit value. */
+#define TRACE_LOG_VARINT_MAX (5U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t s_ring[TRACE_LOG_BUFFER_LEN];
+static volatile uint32_t s_head;
+static volatile uint32_t s_tail;
+static uint32_t s_lastTimestamp;
+static trace_log_stats_t s_stats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t TRACE_LOG_PutVarint(uint8_t *pBuffer, uint32_t value)
+{
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        pBuffer[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7U;
+    }
+    pBuffer[length++] = (uint8_t)value;
+
+    return length;
+}
+
+static void TRACE_LOG_Copy(uint32_t index, const uint8_t *pData, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        s_ring[(index + i) & (TRACE_LOG_BUFFER_LEN - 1U)] = pData[i];
+    }
+}
+
+void TRACE_LOG_Emit(const char *fmt, uint32_t nargs, ...)
+{
+    uint8_t head[2U + 2U * TRACE_LOG_VARINT_MAX];
+    uint8_t args[TRACE_LOG_MAX_ARGS * TRACE_LOG_VARINT_MAX];
+    uint32_t headLength, argsLength, used, now, i;
+    uint32_t primask;
+    va_list ap;
+
+    if (nargs > TRACE_LOG_MAX_ARGS)
+    {
+        nargs = TRACE_LOG_MAX_ARGS;
+    }
+
+    /* Everything but the timestamp is encoded outside the critical section. */
+    argsLength = 0U;
+    va_start(ap, nargs);
+    for (i = 0U; i < nargs; i++)
+    {
+        argsLength += TRACE_LOG_PutVarint(&args[argsLength], va_arg(ap, uint32_t));
+    }
+    va_end(ap);
+
+    head[0] = TRACE_LOG_SYNC;
+    headLength = 2U + TRACE_LOG_PutVarint(&head[2], (uint32_t)fmt);
+
+    primask = DisableGlobalIRQ();
+
+    /* The delta is taken under the lock so records and timestamps stay in the same order. */
+    now = SW_TIMER_GetTicks();
+    i = headLength + TRACE_LOG_PutVarint(&head[headLength], now - s_lastTimestamp);
+    head[1] = (uint8_t)(i - 2U + argsLength);
+
+    used = s_head - s_tail;
+    if ((used + i + argsLength) > TRACE_LOG_BUFFER_LEN)
+    {
+        s_stats.recordsDropped++;
+    }
+    else
+    {
+        TRACE_LOG_Copy(s_head, head, i);
+        TRACE_LOG_Copy(s_head + i, args, argsLength);
+        s_head += i + argsLength;
+        s_lastTimestamp = now;
+        s_stats.records++;
+        used += i + argsLength;
+        if (used > s_stats.highWaterMark)
+        {
+            s_stats.highWaterMark = used;
+        }
+    }
+
+    EnableGlobalIRQ(primask);
+}
+
+void TRACE_LOG_Process(void)
+{
+    uint32_t head, tail, length;
+
+    head = s_head;
+    tail = s_tail;
+    while (head != tail)
+    {
+        /* Send up to the end of the buffer, the wrapped part goes in the next pass. */
+        length = TRACE_LOG_BUFFER_LEN - (tail & (TRACE_LOG_BUFFER_LEN - 1U));
+        if (length > (head - tail))
+        {
+            length = head - tail;
+        }
+
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+        if (DbgConsole_DmaWrite(&s_ring[tail & (TRACE_LOG_BUFFER_LEN - 1U)], length) < 0)
+        {
+            /* The DMA ring is full, retry on the next call. */
+            break;
+        }
+#else
+        for (uint32_t i = 0U; i < length; i++)
+        {
+            (void)DbgConsole_Putchar((int)s_ring[(tail + i) & (TRACE_LOG_BUFFER_LEN - 1U)]);
+        }
+#endif
+        tail += length;
+        s_tail = tail;
+        s_stats.bytesSent += length;
+    }
+}
+
+void TRACE_LOG_GetStats(trace_log_stats_t *pStats)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    *pStats = s_stats;
+    EnableGlobalIRQ(primask);
+}
@@ -61,10 +61,10 @@ extern void LPUART4_DeinitPins();
 /* UART configuration. */
 #define RTE_USART4_PIN_INIT        LPUART4_InitPins
 #define RTE_USART4_PIN_DEINIT      LPUART4_DeinitPins
-#define RTE_USART4_DMA_TX_CH       0
+#define RTE_USART4_DMA_TX_CH       2
 #define RTE_USART4_DMA_TX_PERI_SEL (uint16_t) kDmaRequestMuxLpFlexcomm4Tx
 #define RTE_USART4_DMA_TX_DMA_BASE DMA0
-#define RTE_USART4_DMA_RX_CH       1
+#define RTE_USART4_DMA_RX_CH       3
 #define RTE_USART4_DMA_RX_PERI_SEL (uint16_t) kDmaRequestMuxLpFlexcomm4Rx
 #define RTE_USART4_DMA_RX_DMA_BASE DMA0
 
@@ -28,7 +28,7 @@ gpioHandleKSDK_t D10 = {.base = GPIO0, .pinNumber = 27, .mask = 1 << (27), .cloc
 gpioHandleKSDK_t D2 = {.base = GPIO0, .pinNumber = 29, .mask = 1 << (29), .clockName = kCLOCK_Gpio0, .portNumber = 0};
 
 //GPIO Pin Handles
-gpioHandleKSDK_t PCA9420_INT = {.base = GPIO0, .pinNumber = 28, .mask = 1 << (28), .clockName = kCLOCK_Gpio0, .portNumber = 0};
+gpioHandleKSDK_t PCA9420_INT = {.base = GPIO0, .pinNumber = 28, .mask = 1 << (28), .irq = GPIO00_IRQn, .clockName = kCLOCK_Gpio0, .portNumber = 0};
 
 // Internal Peripheral Pin Definitions
 gpioHandleKSDK_t RED_LED = {
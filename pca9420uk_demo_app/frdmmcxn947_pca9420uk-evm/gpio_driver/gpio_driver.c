@@ -10,13 +10,28 @@
 */
 
 #include "gpio_driver.h"
+#include "gpio_dispatch.h"
 
 /*******************************************************************************
 * Definitions
 ******************************************************************************/
 #define GPIO_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(2, 0) /* driver version */
-// ISR handler array for each gpio pin in the system
-#define GPIO_NUMBER_OF_PIN 0x20
+
+/* Set to 1 to measure the former scan over all pins for comparison. */
+#ifndef GPIO_DISPATCH_LINEAR_SCAN
+#define GPIO_DISPATCH_LINEAR_SCAN 0
+#endif
+
+/* Record the ISR entry to handler latency in DWT cycles. */
+#ifndef GPIO_DISPATCH_MEASURE_LATENCY
+#define GPIO_DISPATCH_MEASURE_LATENCY 1
+#endif
+
+#if (GPIO_DISPATCH_MEASURE_LATENCY)
+#define GPIO_DISPATCH_STAMP() (DWT->CYCCNT)
+#else
+#define GPIO_DISPATCH_STAMP() (0U)
+#endif
 
 /*******************************************************************************
 * Variables
@@ -24,13 +39,35 @@
 
 /* Driver Version */
 static const GENERIC_DRIVER_VERSION DriverVersion = {GPIO_API_VERSION, GPIO_DRV_VERSION};
-static gpioIsrObj_t isrObj[TOTAL_NUMBER_PORT][GPIO_NUMBER_OF_PIN];
+// Pin handlers of all ports, looked up by the set bits of the interrupt flags
+static gpio_dispatch_t gpioDispatch;
+static bool gpioDispatchReady = false;
 static gpioConfigKSDK_t gpioConfigDefault = {
     .pinConfig = {kGPIO_DigitalInput, 0}, .portPinConfig = {0}, .interruptMode = kGPIO_InterruptFallingEdge};
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
+#if (GPIO_DISPATCH_MEASURE_LATENCY)
+static uint32_t ksdk_gpio_get_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+static void ksdk_gpio_dispatch_init(void)
+{
+#if (GPIO_DISPATCH_MEASURE_LATENCY)
+    // Start the cycle counter, it stays 0 on parts without one
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    GPIO_DispatchInit(&gpioDispatch, ksdk_gpio_get_cycles);
+#else
+    GPIO_DispatchInit(&gpioDispatch, NULL);
+#endif
+    gpioDispatchReady = true;
+}
 
 /***********************************************************************
  *
@@ -73,10 +110,13 @@ void ksdk_gpio_pin_init(
     // Isr is installed
     if (aIsrHandler)
     {
+        if (!gpioDispatchReady)
+        {
+            ksdk_gpio_dispatch_init();
+        }
+        (void)GPIO_DispatchRegister(&gpioDispatch, pinHandle->portNumber, pinHandle->pinNumber, aIsrHandler, apUserData);
         // Enable the IRQ
         EnableIRQ(pinHandle->irq);
-        isrObj[pinHandle->portNumber][pinHandle->pinNumber].isrHandle = aIsrHandler;
-        isrObj[pinHandle->portNumber][pinHandle->pinNumber].pUserData = apUserData;
         // Enable the interrupt on a pin.
         GPIO_SetPinInterruptConfig(pinHandle->base, pinHandle->pinNumber, pGpioConfig->interruptMode);
     }
@@ -151,23 +191,29 @@ uint32_t ksdk_gpio_read_pin(pinID_t aPinId)
  ***************************************************************************/
 void ksdk_gpio_handle_interrupt(GPIO_Type *apBase, port_number_t aPortNumber)
 {
+    uint32_t entryStamp = GPIO_DISPATCH_STAMP();
     uint32_t isfr = GPIO_GpioGetInterruptFlags(apBase);
 
-    // parse through all the pending interrupt for a PORT
-    for (uint8_t i = 0; i < GPIO_NUMBER_OF_PIN; i++)
-    {
-        if (isfr & (1 << i))
-        {
-            gpio_isr_handler_t handle = isrObj[aPortNumber][i].isrHandle;
-            if (handle == NULL)
-            {
-                continue;
-            }
-            // call user defined handler
-            handle(isrObj[aPortNumber][i].pUserData);
-            GPIO_PinClearInterruptFlag(apBase, (1 << i));
-        }
-    }
+    // Acknowledge before the handlers run, an edge arriving meanwhile pends the IRQ again
+    GPIO_GpioClearInterruptFlags(apBase, isfr);
+
+#if (GPIO_DISPATCH_LINEAR_SCAN)
+    (void)GPIO_DispatchFlagsLinear(&gpioDispatch, aPortNumber, isfr, entryStamp);
+#else
+    (void)GPIO_DispatchFlags(&gpioDispatch, aPortNumber, isfr, entryStamp);
+#endif
+}
+
+/***********************************************************************
+ *
+ * Function Name : ksdk_gpio_get_dispatch_stats
+ * Description   : get the dispatch count and latency of a pin handler.
+ *
+ ***************************************************************************/
+const gpio_dispatch_entry_t *ksdk_gpio_get_dispatch_stats(pinID_t aPinId)
+{
+    gpioHandleKSDK_t *pinHandle = (gpioHandleKSDK_t *)aPinId;
+    return GPIO_DispatchGetEntry(&gpioDispatch, pinHandle->portNumber, pinHandle->pinNumber);
 }
 #endif
 GENERIC_DRIVER_GPIO Driver_GPIO_KSDK = {
@@ -12,12 +12,35 @@
 #include "fsl_gpio.h"
 #include "gpio_driver.h"
 
-extern void ksdk_gpio_handle_interrupt(GPIO_Type *base, port_number_t portNumber);
-
 /*******************************************************************************
  * Functions - GPIOIRQ implementation
  ******************************************************************/
-void PORT0_IRQHandler(void)
+void GPIO00_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO0, PORTA_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO10_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO1, PORTB_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO20_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO2, PORTC_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO30_IRQHandler(void)
+{
+    ksdk_gpio_handle_interrupt(GPIO3, PORTD_NUM);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void GPIO40_IRQHandler(void)
 {
-    ksdk_gpio_handle_interrupt(GPIO0, 0);
+    ksdk_gpio_handle_interrupt(GPIO4, PORTE_NUM);
+    SDK_ISR_EXIT_BARRIER;
 }
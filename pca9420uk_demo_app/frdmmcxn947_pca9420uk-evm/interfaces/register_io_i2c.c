@@ -148,6 +148,22 @@ void I2C11_SignalEvent_t(uint32_t event)
 #endif
 #endif
 
+/* Nothing on the bus: no transfer running and, on LPI2C, no read holding the bus for its repeated start. */
+static bool Register_I2C_BusFree(ARM_DRIVER_I2C *pCommDrv, registerDeviceInfo_t *devInfo)
+{
+    if (pCommDrv->GetStatus().busy)
+    {
+        return false;
+    }
+#if defined(LPI2C_MSR_BBF_MASK)
+    if ((devInfo->deviceInstance < I2C_COUNT) && (i2cBases[devInfo->deviceInstance]->MSR & LPI2C_MSR_BBF_MASK))
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
 /*! The interface function to block write sensor registers. */
 int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
                                 registerDeviceInfo_t *devInfo,
@@ -380,3 +396,54 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
 
     return status;
 }
+
+/*! The interface function to block write sensor registers from an interrupt handler. */
+int32_t Register_I2C_PreemptBlockWrite(ARM_DRIVER_I2C *pCommDrv,
+                                       registerDeviceInfo_t *devInfo,
+                                       uint16_t slaveAddress,
+                                       uint8_t offset,
+                                       const uint8_t *pBuffer,
+                                       uint8_t bytesToWrite)
+{
+    bool completion;
+    uint32_t event;
+    int32_t status;
+
+    if (!Register_I2C_BusFree(pCommDrv, devInfo))
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    /* Thread code may have armed the flag for a transfer it has not started yet. */
+    completion = b_I2C_CompletionFlag[devInfo->deviceInstance];
+    event = g_I2C_ErrorEvent[devInfo->deviceInstance];
+    status = Register_I2C_BlockWrite(pCommDrv, devInfo, slaveAddress, offset, pBuffer, bytesToWrite);
+    b_I2C_CompletionFlag[devInfo->deviceInstance] = completion;
+    g_I2C_ErrorEvent[devInfo->deviceInstance] = event;
+
+    return status;
+}
+
+/*! The interface function to read sensor registers from an interrupt handler. */
+int32_t Register_I2C_PreemptRead(ARM_DRIVER_I2C *pCommDrv,
+                                 registerDeviceInfo_t *devInfo,
+                                 uint16_t slaveAddress,
+                                 uint8_t offset,
+                                 uint8_t length,
+                                 uint8_t *pOutBuffer)
+{
+    bool completion;
+    uint32_t event;
+    int32_t status;
+
+    if (!Register_I2C_BusFree(pCommDrv, devInfo))
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    completion = b_I2C_CompletionFlag[devInfo->deviceInstance];
+    event = g_I2C_ErrorEvent[devInfo->deviceInstance];
+    status = Register_I2C_Read(pCommDrv, devInfo, slaveAddress, offset, length, pOutBuffer);
+    b_I2C_CompletionFlag[devInfo->deviceInstance] = completion;
+    g_I2C_ErrorEvent[devInfo->deviceInstance] = event;
+
+    return status;
+}
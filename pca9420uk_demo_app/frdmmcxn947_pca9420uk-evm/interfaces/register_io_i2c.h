@@ -206,4 +206,49 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
                           uint8_t length,
                           uint8_t *pOutBuffer);
 
+/*!
+ * @brief The interface function to write sensor registers from an interrupt handler.
+ *
+ * The transfer goes ahead only when the bus is free, neither a transfer in progress nor a register
+ * read holding the bus for its repeated start. The completion state of the bus is saved and restored
+ * around it, so thread code interrupted anywhere in its own transfer sequence is not disturbed. The
+ * I2C interrupt must have a higher priority than the caller.
+ *
+ * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
+ * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
+ * @param uint16_t slaveAddress - the sensor's I2C slave address.
+ * @param uint8_t offset - The register/offset to write to.
+ * @param uint8_t *pBuffer - The buffer containing bytes to write.
+ * @param uint8_t bytesToWrite - A number of bytes to write.
+ *
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_BUSY if the bus is in use or ARM_DRIVER_ERROR if error.
+ */
+int32_t Register_I2C_PreemptBlockWrite(ARM_DRIVER_I2C *pCommDrv,
+                                       registerDeviceInfo_t *devInfo,
+                                       uint16_t slaveAddress,
+                                       uint8_t offset,
+                                       const uint8_t *pBuffer,
+                                       uint8_t bytesToWrite);
+
+/*!
+ * @brief The interface function to read sensor registers from an interrupt handler.
+ *
+ * Same conditions as Register_I2C_PreemptBlockWrite().
+ *
+ * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
+ * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
+ * @param uint16_t slaveAddress - the sensor's I2C slave address.
+ * @param uint8_t offset - The register/offset to read from
+ * @param uint8_t length - The number of bytes to read
+ * @param uint8_t *pOutBuffer - The pointer to the buffer to store the register value read.
+ *
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_BUSY if the bus is in use or ARM_DRIVER_ERROR if error.
+ */
+int32_t Register_I2C_PreemptRead(ARM_DRIVER_I2C *pCommDrv,
+                                 registerDeviceInfo_t *devInfo,
+                                 uint16_t slaveAddress,
+                                 uint8_t offset,
+                                 uint8_t length,
+                                 uint8_t *pOutBuffer);
+
 #endif // __REGISTER_IO_I2C_H__
@@ -0,0 +1,291 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_brownout.c
+ * @brief The pca9420uk_brownout.c file implements the PCA9420UK brown-out response.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_brownout.h"
+#include "pca9420uk.h"
+#include "pca9420uk_config.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Rail enable bits of MODECFG_x_2. */
+#define PCA9420_BROWNOUT_RAILS_MASK \
+	(PCA9420_SW1_EN_MASK | PCA9420_SW2_EN_MASK | PCA9420_LDO1_EN_MASK | PCA9420_LDO2_EN_MASK)
+
+/* Register distance of two mode banks. */
+#define PCA9420_BROWNOUT_BANK_STRIDE (PCA9420UK_MODECFG_1_0 - PCA9420UK_MODECFG_0_0)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t PCA9420_BROWNOUT_ElapsedUs(const pca9420_brownout_t *pBrownout, uint32_t edgeStamp)
+{
+	return (uint32_t)COUNT_TO_USEC(pBrownout->getCycles() - edgeStamp, SystemCoreClock);
+}
+
+/* Takes the armed command, from thread context with the interrupt shut out. */
+static bool PCA9420_BROWNOUT_Claim(pca9420_brownout_t *pBrownout)
+{
+	uint32_t primask = DisableGlobalIRQ();
+	bool armed = pBrownout->armed;
+
+	pBrownout->armed = false;
+	EnableGlobalIRQ(primask);
+	return armed;
+}
+
+/* Accounts a shed that went out and runs the actions. */
+static void PCA9420_BROWNOUT_Shed(pca9420_brownout_t *pBrownout, uint32_t edgeStamp, uint8_t record)
+{
+	uint32_t us = PCA9420_BROWNOUT_ElapsedUs(pBrownout, edgeStamp);
+	uint8_t i;
+
+	pBrownout->pending = false;
+	pBrownout->shed = true;
+	pBrownout->sheds++;
+	pBrownout->lastUs = us;
+	if (us > pBrownout->maxUs)
+	{
+		pBrownout->maxUs = us;
+	}
+	if (us > pBrownout->config.budgetUs)
+	{
+		pBrownout->overBudget++;
+	}
+	if (record == kPCA9420_BrownoutLate)
+	{
+		pBrownout->lateSheds++;
+	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogBrownout, record, (uint16_t)((us < 0xFFFFu) ? us : 0xFFFFu));
+
+	for (i = 0u; i < pBrownout->actionCount; i++)
+	{
+		pBrownout->actions[i].action(pBrownout->actions[i].pUserData);
+	}
+}
+
+/* Sets the shed rails of the prepared enable register as in value and leaves its other bits as they are now. */
+static int32_t PCA9420_BROWNOUT_WriteRails(pca9420_brownout_t *pBrownout, uint8_t value)
+{
+	pca9420_config_t target;
+	uint8_t careMask[PCA9420_CFG_REG_COUNT];
+
+	memset(&target, 0, sizeof(target));
+	memset(careMask, 0, sizeof(careMask));
+	target.regions = PCA9420_CFG_REGION_MODECFG;
+	target.regs[pBrownout->shedAddress] = value;
+	careMask[pBrownout->shedAddress] = pBrownout->config.shedRails;
+	return PCA9420_CFG_Reconcile(pBrownout->pSensorHandle, &target, careMask, NULL, NULL);
+}
+
+/* Dispatcher side, sheds when the INT pin interrupt could not. */
+static void PCA9420_BROWNOUT_Interrupt(uint32_t sources, void *pUserData)
+{
+	pca9420_brownout_t *pBrownout = (pca9420_brownout_t *)pUserData;
+	uint32_t edgeStamp;
+
+	if (!PCA9420_BROWNOUT_Claim(pBrownout))
+	{
+		return;
+	}
+	edgeStamp = pBrownout->pending ? pBrownout->edgeStamp : pBrownout->getCycles();
+	if (SENSOR_ERROR_NONE != PCA9420_BROWNOUT_WriteRails(pBrownout, pBrownout->shedValue))
+	{
+		pBrownout->busErrors++;
+		pBrownout->armed = true;
+		return;
+	}
+	PCA9420_BROWNOUT_Shed(pBrownout, edgeStamp, kPCA9420_BrownoutLate);
+}
+
+int32_t PCA9420_BROWNOUT_Init(pca9420_brownout_t *pBrownout, pca9420_irq_t *pIrq, const pca9420_brownout_config_t *pConfig,
+                              pca9420_brownout_cycles_t getCycles)
+{
+	int32_t status;
+
+	if ((pBrownout == NULL) || (pIrq == NULL) || (pConfig == NULL) || (getCycles == NULL) ||
+	    ((pConfig->shedRails & PCA9420_BROWNOUT_RAILS_MASK) == 0u) ||
+	    ((pConfig->shedRails & ~PCA9420_BROWNOUT_RAILS_MASK) != 0u) || (pConfig->budgetUs == 0u) ||
+	    (pConfig->prewarn > kPCA9420_AsysPreWarn3V6))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pBrownout, 0, sizeof(*pBrownout));
+	pBrownout->pSensorHandle = pIrq->pSensorHandle;
+	pBrownout->config = *pConfig;
+	pBrownout->getCycles = getCycles;
+
+	status = PCA9420_Set_asys_prewarn_vol_tshld(pBrownout->pSensorHandle, (enum _pca9420_asys_prewarning)pConfig->prewarn);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	status = PCA9420_BROWNOUT_Prepare(pBrownout);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	return PCA9420_IRQ_Register(pIrq, kPCA9420_IntSrcSysAsysPreWarn, PCA9420_BROWNOUT_Interrupt, pBrownout);
+}
+
+int32_t PCA9420_BROWNOUT_AddAction(pca9420_brownout_t *pBrownout, pca9420_brownout_action_t action, void *pUserData)
+{
+	if ((action == NULL) || (pBrownout->actionCount >= PCA9420_BROWNOUT_MAX_ACTIONS))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	pBrownout->actions[pBrownout->actionCount].pUserData = pUserData;
+	pBrownout->actions[pBrownout->actionCount].action = action;
+	pBrownout->actionCount++;
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_BROWNOUT_Prepare(pca9420_brownout_t *pBrownout)
+{
+	uint8_t top, address, value;
+	uint32_t primask;
+	int32_t status;
+
+	status = PCA9420_DRV_BlockRead(pBrownout->pSensorHandle, PCA9420UK_TOP_CNTL3, &top, 1u);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		address = (uint8_t)(PCA9420UK_MODECFG_0_2 +
+		                    ((top & PCA9420_TOP_CNTL3_MODE_I2C_MASK) >> PCA9420_TOP_CNTL3_MODE_I2C_SHIFT) *
+		                        PCA9420_BROWNOUT_BANK_STRIDE);
+		status = PCA9420_DRV_BlockRead(pBrownout->pSensorHandle, address, &value, 1u);
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pBrownout->busErrors++;
+		return status;
+	}
+
+	/* The interrupt must not see half a command. */
+	primask = DisableGlobalIRQ();
+	pBrownout->shedAddress = address;
+	pBrownout->savedValue = value;
+	pBrownout->shedValue = (uint8_t)(value & ~pBrownout->config.shedRails);
+	pBrownout->pending = false;
+	pBrownout->armed = true;
+	EnableGlobalIRQ(primask);
+	return SENSOR_ERROR_NONE;
+}
+
+void PCA9420_BROWNOUT_NoteWrite(pca9420_brownout_t *pBrownout, uint8_t address, uint8_t length)
+{
+	uint32_t last = (uint32_t)address + length - 1u;
+	uint32_t reg;
+	bool touched = (address <= PCA9420UK_TOP_CNTL3) && (last >= PCA9420UK_TOP_CNTL3);
+
+	for (reg = PCA9420UK_MODECFG_0_2; reg <= PCA9420UK_MODECFG_3_2; reg += PCA9420_BROWNOUT_BANK_STRIDE)
+	{
+		touched = touched || ((address <= reg) && (last >= reg));
+	}
+	if ((length == 0u) || !touched)
+	{
+		return;
+	}
+
+	if (pBrownout->shed)
+	{
+		/* The interrupt may have shed between the read and the write of a read-modify-write, which then
+		 * put the rails back on. Only a changed register is written, so this comes back here once at most. */
+		if ((address <= pBrownout->shedAddress) && (last >= pBrownout->shedAddress))
+		{
+			if (SENSOR_ERROR_NONE != PCA9420_BROWNOUT_WriteRails(pBrownout, pBrownout->shedValue))
+			{
+				pBrownout->busErrors++;
+			}
+			else
+			{
+				pBrownout->reSheds++;
+			}
+		}
+	}
+	else if (pBrownout->armed)
+	{
+		/* Prepare only reads, no write comes back here. */
+		(void)PCA9420_BROWNOUT_Prepare(pBrownout);
+	}
+}
+
+void PCA9420_BROWNOUT_OnEdge(pca9420_brownout_t *pBrownout, uint32_t edgeStamp)
+{
+	pca9420_i2c_sensorhandle_t *pHandle = pBrownout->pSensorHandle;
+	uint8_t subInt0;
+	int32_t status;
+
+	if (!pBrownout->armed)
+	{
+		return;
+	}
+	pBrownout->edges++;
+
+	/* A transfer of thread code finishes meanwhile, the I2C interrupt runs above this one. */
+	do
+	{
+		status = Register_I2C_PreemptRead(pHandle->pCommDrv, &pHandle->deviceInfo, pHandle->slaveAddress,
+		                                  PCA9420UK_SUB_INT0, 1u, &subInt0);
+	} while ((ARM_DRIVER_ERROR_BUSY == status) &&
+	         (PCA9420_BROWNOUT_ElapsedUs(pBrownout, edgeStamp) < pBrownout->config.budgetUs));
+	if ((ARM_DRIVER_OK == status) && ((subInt0 & PCA9420_ASYS_PREWARN_MASK) == 0u))
+	{
+		/* Another source, the dispatcher handles it. */
+		return;
+	}
+	if (ARM_DRIVER_OK == status)
+	{
+		/* Nothing ran on the bus since the read, the write goes straight out. */
+		status = Register_I2C_PreemptBlockWrite(pHandle->pCommDrv, &pHandle->deviceInfo, pHandle->slaveAddress,
+		                                        pBrownout->shedAddress, &pBrownout->shedValue, 1u);
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		/* Bus still taken or failed, the dispatcher sheds when it finds the pre-warning. */
+		if (ARM_DRIVER_ERROR_BUSY != status)
+		{
+			pBrownout->busErrors++;
+		}
+		pBrownout->edgeStamp = edgeStamp;
+		pBrownout->pending = true;
+		return;
+	}
+	pBrownout->armed = false;
+	PCA9420_BROWNOUT_Shed(pBrownout, edgeStamp, kPCA9420_BrownoutShed);
+}
+
+int32_t PCA9420_BROWNOUT_Restore(pca9420_brownout_t *pBrownout)
+{
+	int32_t status;
+
+	if (!pBrownout->shed)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	/* Cleared first, PCA9420_BROWNOUT_NoteWrite() would shed the restore again. */
+	pBrownout->shed = false;
+	status = PCA9420_BROWNOUT_WriteRails(pBrownout, pBrownout->savedValue);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pBrownout->shed = true;
+		pBrownout->busErrors++;
+		return status;
+	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogBrownout, kPCA9420_BrownoutRestore, pBrownout->savedValue);
+	return PCA9420_BROWNOUT_Prepare(pBrownout);
+}
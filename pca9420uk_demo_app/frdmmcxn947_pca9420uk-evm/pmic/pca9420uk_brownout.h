@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_brownout.h
+ * @brief The pca9420uk_brownout.h file describes the PCA9420UK brown-out response.
+
+    When ASYS falls under the pre-warning threshold the rails behind non-essential loads are
+    switched off before anything else happens, so the energy left in the system goes to the
+    MCU. The response runs from the INT pin interrupt itself: PCA9420_BROWNOUT_OnEdge() reads
+    SUB_INT0 to tell a pre-warning from the other sources and then sends the shed command,
+    the enable register of the active mode bank with the shed rails cleared. The command is
+    built beforehand by PCA9420_BROWNOUT_Prepare(), so shedding is one single register write,
+    no read-modify-write. After it the response is recorded in the event log, which is
+    retained over the reset that may follow, and the registered actions run in order.
+
+    Both transfers go through the preempting register functions of register_io_i2c.h. A
+    transfer of thread code still on the bus is waited out, at most budgetUs from the edge;
+    when the bus stays taken, a register read holding it for its repeated start, the
+    interrupt dispatcher sheds in thread context instead and the response counts as late. It
+    also sheds when no edge reached PCA9420_BROWNOUT_OnEdge(). The time from the pin edge to
+    the end of the shed write is measured on every response, the worst one is kept and
+    responses over budgetUs are counted.
+
+    The shed command holds the whole enable register, LDO1_OUT included, of the mode bank
+    selected over I2C when it was prepared. PCA9420_BROWNOUT_NoteWrite(), called from the
+    driver write listener, prepares it again after every write to TOP_CNTL3 or an enable
+    register, so it never sends stale bits back. A mode selected by the external pins is not
+    followed. The dispatcher's shed and PCA9420_BROWNOUT_Restore() read the register and only
+    change the shed rails. Once shed, the response stays disarmed until
+    PCA9420_BROWNOUT_Restore() writes the rails back. Meanwhile a driver write to the shed
+    register, a read-modify-write the interrupt shed under included, is followed by the shed
+    rails being switched off again.
+*/
+
+#ifndef PCA9420UK_BROWNOUT_H_
+#define PCA9420UK_BROWNOUT_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_irq.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Largest number of actions after the shed. */
+#ifndef PCA9420_BROWNOUT_MAX_ACTIONS
+#define PCA9420_BROWNOUT_MAX_ACTIONS (4u)
+#endif
+
+/*! @brief Responses, the arg of the kPCA9420_EvlogBrownout records. */
+enum _pca9420_brownout_record
+{
+	kPCA9420_BrownoutShed    = 0u, /*!< Loads shed from the INT pin interrupt, value edge to shed in us. */
+	kPCA9420_BrownoutLate    = 1u, /*!< Loads shed from the dispatcher, value edge to shed in us. */
+	kPCA9420_BrownoutRestore = 2u, /*!< Shed rails switched back on, value the enable register written. */
+};
+
+/*! @brief Action after the shed, called from the INT pin interrupt or the dispatcher. No bus access. */
+typedef void (*pca9420_brownout_action_t)(void *pUserData);
+
+/*! @brief Free running cycle counter at the core clock, the time base of the latency figures. */
+typedef uint32_t (*pca9420_brownout_cycles_t)(void);
+
+/*!
+ * @brief Response configuration.
+ */
+typedef struct
+{
+	uint8_t prewarn;   /*!< ASYS pre-warning threshold, enum _pca9420_asys_prewarning. */
+	uint8_t shedRails; /*!< Rails to switch off, PCA9420_SW1_EN_MASK..PCA9420_LDO2_EN_MASK bits. */
+	uint16_t budgetUs; /*!< Longest pin edge to shed time, also the longest wait for the bus. */
+} pca9420_brownout_config_t;
+
+/*!
+ * @brief Action registration.
+ */
+typedef struct
+{
+	pca9420_brownout_action_t action; /*!< Action. */
+	void *pUserData;                  /*!< Passed to the action. */
+} pca9420_brownout_entry_t;
+
+/*!
+ * @brief Response context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;                      /*!< PMIC handle. */
+	pca9420_brownout_config_t config;                               /*!< Configuration in use. */
+	pca9420_brownout_cycles_t getCycles;                            /*!< Time base. */
+	pca9420_brownout_entry_t actions[PCA9420_BROWNOUT_MAX_ACTIONS]; /*!< Actions in order. */
+	uint8_t actionCount;                                            /*!< Actions registered. */
+	uint8_t shedAddress;                                            /*!< Enable register of the prepared mode bank. */
+	uint8_t shedValue;                                              /*!< Its value with the shed rails off. */
+	uint8_t savedValue;                                             /*!< Its value when prepared, written back by a restore. */
+	volatile bool armed;                                            /*!< Command prepared and not sent yet. */
+	volatile bool pending;                                          /*!< The interrupt left the response to the dispatcher. */
+	volatile bool shed;                                             /*!< Shed rails held off until a restore. */
+	volatile uint32_t edgeStamp;                                    /*!< Cycle count at the pin edge of a pending response. */
+	uint32_t edges;                                                 /*!< INT pin edges seen while armed. */
+	uint32_t sheds;                                                 /*!< Responses. */
+	uint32_t lateSheds;                                             /*!< Responses left to the dispatcher. */
+	uint32_t overBudget;                                            /*!< Responses slower than budgetUs. */
+	uint32_t lastUs;                                                /*!< Edge to shed time of the last response. */
+	uint32_t maxUs;                                                 /*!< Longest edge to shed time. */
+	uint32_t reSheds;                                               /*!< Shed rails switched off again after a driver write. */
+	uint32_t busErrors;                                             /*!< Reads or writes that failed. */
+} pca9420_brownout_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to set up the brown-out response.
+ *  @details     This function programs the ASYS pre-warning threshold, prepares the shed command and
+ *               registers with the dispatcher for the ASYS pre-warning interrupt.
+ *  @param[out]  pBrownout      response context.
+ *  @param[in]   pIrq           interrupt dispatcher.
+ *  @param[in]   pConfig        configuration, copied.
+ *  @param[in]   getCycles      cycle counter.
+ *  @constraints PCA9420_IRQ_Init() must have been called. The I2C interrupt must have a higher priority than the
+ *               INT pin interrupt.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_BROWNOUT_Init() returns the status, SENSOR_ERROR_INVALID_PARAM for no rail to shed,
+ *               a zero budget or a threshold out of range.
+ */
+int32_t PCA9420_BROWNOUT_Init(pca9420_brownout_t *pBrownout, pca9420_irq_t *pIrq, const pca9420_brownout_config_t *pConfig,
+                              pca9420_brownout_cycles_t getCycles);
+
+/*! @brief       The interface function to add an action after the shed.
+ *  @param[in]   pBrownout      response context.
+ *  @param[in]   action         action, short and safe to call from an interrupt.
+ *  @param[in]   pUserData      passed to the action.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_BROWNOUT_AddAction() returns the status, SENSOR_ERROR_INVALID_PARAM when all
+ *               PCA9420_BROWNOUT_MAX_ACTIONS are taken.
+ */
+int32_t PCA9420_BROWNOUT_AddAction(pca9420_brownout_t *pBrownout, pca9420_brownout_action_t action, void *pUserData);
+
+/*! @brief       The interface function to build the shed command from the rails in force.
+ *  @details     This function reads the active mode and its enable register and arms the response.
+ *  @param[in]   pBrownout      response context.
+ *  @constraints Thread context only. Not while shed, see PCA9420_BROWNOUT_Restore().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_BROWNOUT_Prepare() returns the status.
+ */
+int32_t PCA9420_BROWNOUT_Prepare(pca9420_brownout_t *pBrownout);
+
+/*! @brief       The interface function to keep the shed command in step with a driver write.
+ *  @details     This function prepares the shed command again when the written registers hold TOP_CNTL3 or
+ *               one of the MODECFG_x_2 enable registers and the response is armed. While shed it switches
+ *               the shed rails off again after a write to the shed register.
+ *  @param[in]   pBrownout      response context.
+ *  @param[in]   address        first register written.
+ *  @param[in]   length         registers written.
+ *  @constraints Thread context only, typically the pca9420_write_listener_t of the driver. It reads over the
+ *               bus after a write to these registers.
+ *  @reeentrant  No
+ *  @return      void
+ */
+void PCA9420_BROWNOUT_NoteWrite(pca9420_brownout_t *pBrownout, uint8_t address, uint8_t length);
+
+/*! @brief       The interface function to respond to an INT pin edge.
+ *  @details     This function reads SUB_INT0 and on an ASYS pre-warning sends the shed command, records the
+ *               response and runs the actions. It returns at once when not armed.
+ *  @param[in]   pBrownout      response context.
+ *  @param[in]   edgeStamp      cycle count at the pin edge.
+ *  @constraints Call from the INT pin interrupt handler.
+ *  @reeentrant  No
+ *  @return      void
+ */
+void PCA9420_BROWNOUT_OnEdge(pca9420_brownout_t *pBrownout, uint32_t edgeStamp);
+
+/*! @brief       The interface function to switch the shed rails back on.
+ *  @details     This function switches the shed rails on as they were when prepared, leaving the other bits of
+ *               the enable register as they are, and arms the response again.
+ *  @param[in]   pBrownout      response context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_BROWNOUT_Restore() returns the status, SENSOR_ERROR_INVALID_PARAM when not shed.
+ */
+int32_t PCA9420_BROWNOUT_Restore(pca9420_brownout_t *pBrownout);
+
+#endif /* PCA9420UK_BROWNOUT_H_ */
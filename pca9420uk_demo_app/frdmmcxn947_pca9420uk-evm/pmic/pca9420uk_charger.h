@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_charger.h
+ * @brief The pca9420uk_charger.h file describes the PCA9420UK charger configuration API.
+
+    A charger configuration holds every field of CHG_CNTL0..7 by name. Instead of one
+    read-modify-write per field through the PCA9420_Set_ charger functions, and the separate
+    PCA9420_enable_chg_lock() before them, PCA9420_CHARGER_Apply() encodes the whole block and
+    writes it as one I2C transaction: the register address and eight data bytes, CHG_CNTL0
+    first with the unlock key so the PMIC takes the seven registers after it. One burst read
+    back verifies the result, a register that did not take its value is recorded in the event
+    log as a configuration drift. The key stays written afterwards, as with the register image
+    functions of pca9420uk_config.h.
+*/
+
+#ifndef PCA9420UK_CHARGER_H_
+#define PCA9420UK_CHARGER_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Charger control registers, CHG_CNTL0..7. */
+#define PCA9420_CHARGER_REG_COUNT (8u)
+
+/*!
+ * @brief Charger configuration.
+ */
+typedef struct
+{
+	uint8_t enable;        /*!< CHG_EN, 1 to allow charging. */
+	uint8_t safetyTimers;  /*!< CHG_TIMER_EN, 1 to run the pre-qualification and fast charge timers. */
+	uint8_t ntc;           /*!< NTC_EN, 1 to monitor the battery temperature. */
+	uint8_t ccCurrent;     /*!< Fast charge current, enum _pca9420_bat_chrg_cur. */
+	uint8_t topoffCurrent; /*!< Top-off current, enum _pca9420_bat_topoff_cur. */
+	uint8_t lowCurrent;    /*!< Pre-charge current, enum _pca9420_low_bat_chrg_cur. */
+	uint8_t deadTimer;     /*!< Dead battery timer, enum _pca9420_dead_chrg_timer. */
+	uint8_t deadCurrent;   /*!< Dead battery current, enum _pca9420_dead_bat_chrg_cur. */
+	uint8_t recharge;      /*!< Recharge threshold, enum _pca9420_threshld_rechrg. */
+	uint8_t vbatReg;       /*!< Regulation voltage, enum _pca9420_bat_reg_vol. */
+	uint8_t ntcResistor;   /*!< Thermistor resistance, enum _pca9420_ntc_res_sel. */
+	uint8_t fastTimer;     /*!< Fast charge timer, enum _pca9420_fast_chrg_timer. */
+	uint8_t preqTimer;     /*!< Pre-qualification timer, enum _pca9420_preq_chrg_timer. */
+	uint8_t topoffTimer;   /*!< Top-off timer, enum _pca9420_topoff_timer. */
+	uint8_t ntcBeta;       /*!< Thermistor beta, enum _pca9420_ntc_beta_val. */
+	uint8_t thermalReg;    /*!< Thermal regulation threshold, enum _pca9420_thrml_reg_thshld. */
+} pca9420_charger_config_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to read the charger configuration.
+ *  @details     This function reads CHG_CNTL0..7 in one burst and decodes every field.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[out]  pConfig        charger configuration.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize(). Not on PCA9421.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CHARGER_Get() returns the status.
+ */
+int32_t PCA9420_CHARGER_Get(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_charger_config_t *pConfig);
+
+/*! @brief       The interface function to program the charger configuration.
+ *  @details     This function writes CHG_CNTL0..7 in one burst behind the unlock key, then reads them back
+ *               in one burst and compares every field.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pConfig        charger configuration.
+ *  @constraints This can be called only after PCA9420_I2C_Initialize(). Not on PCA9421.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_CHARGER_Apply() returns the status, SENSOR_ERROR_INVALID_PARAM for a field out of
+ *               range, SENSOR_ERROR_WRITE when the read back differs.
+ */
+int32_t PCA9420_CHARGER_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_charger_config_t *pConfig);
+
+#endif /* PCA9420UK_CHARGER_H_ */
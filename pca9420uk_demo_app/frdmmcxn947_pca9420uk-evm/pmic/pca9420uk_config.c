@@ -0,0 +1,524 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_config.c
+ * @brief The pca9420uk_config.c file implements the PCA9420UK register image configuration.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_config.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+#include "crc16.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Upper five bits of CHG_CNTL0, the key that opens the charger registers for writing. */
+#define PCA9420_CFG_CHG_KEY_MASK (0xF8u)
+
+/* Low bits of TOP_CNTL3 that start a software reset when they hold PCA9420_TOP_CNTL3_SW_RESET_MASK. */
+#define PCA9420_CFG_SW_RESET_FIELD (0x07u)
+
+typedef struct
+{
+	uint8_t region; /* PCA9420_CFG_REGION_ bit. */
+	uint8_t first;  /* First register. */
+	uint8_t count;  /* Registers in the burst. */
+} pca9420_cfg_region_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* In write order: masks, charger, discharge, mode banks, then TOP_CNTL which may switch to one of those banks. */
+static const pca9420_cfg_region_t s_regions[] = {
+	{PCA9420_CFG_REGION_INT_MASK, PCA9420UK_SUB_INT0_MASK, PCA9420UK_SUB_INT2_MASK - PCA9420UK_SUB_INT0_MASK + 1},
+#if (!PCA9421UK_EVM_EN)
+	{PCA9420_CFG_REGION_CHARGER, PCA9420UK_CHG_CNTL0, PCA9420UK_CHG_CNTL7 - PCA9420UK_CHG_CNTL0 + 1},
+#endif
+	{PCA9420_CFG_REGION_DISCHARGE, PCA9420UK_ACT_DIS_CNTL_1, 1},
+	{PCA9420_CFG_REGION_MODECFG, PCA9420UK_MODECFG_0_0, PCA9420UK_MODECFG_3_3 - PCA9420UK_MODECFG_0_0 + 1},
+	{PCA9420_CFG_REGION_TOP, PCA9420UK_TOP_CNTL0, PCA9420UK_TOP_CNTL3 - PCA9420UK_TOP_CNTL0 + 1},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* The sub interrupt flags sit between their masks, writing 0 to them clears nothing. */
+static void PCA9420_CFG_ClearFlags(uint8_t *pRegs)
+{
+	pRegs[PCA9420UK_SUB_INT1] = 0u;
+	pRegs[PCA9420UK_SUB_INT2] = 0u;
+}
+
+int32_t PCA9420_CFG_Capture(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_config_t *pConfig, uint8_t regions)
+{
+	int32_t status;
+	uint32_t i;
+
+	if ((pSensorHandle == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pConfig, 0, sizeof(*pConfig));
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		status = PCA9420_DRV_BlockRead(pSensorHandle, s_regions[i].first, &pConfig->regs[s_regions[i].first], s_regions[i].count);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+		pConfig->regions |= s_regions[i].region;
+	}
+	PCA9420_CFG_ClearFlags(pConfig->regs);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_CFG_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_config_t *pConfig)
+{
+	uint8_t regs[PCA9420_CFG_REG_COUNT];
+	int32_t status;
+	uint32_t i;
+
+	if ((pSensorHandle == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (((pConfig->regions & PCA9420_CFG_REGION_TOP) != 0u) &&
+	    ((pConfig->regs[PCA9420UK_TOP_CNTL3] & PCA9420_CFG_SW_RESET_FIELD) == PCA9420_TOP_CNTL3_SW_RESET_MASK))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memcpy(regs, pConfig->regs, sizeof(regs));
+	PCA9420_CFG_ClearFlags(regs);
+	regs[PCA9420UK_CHG_CNTL0] = (uint8_t)((regs[PCA9420UK_CHG_CNTL0] & ~PCA9420_CFG_CHG_KEY_MASK) | PCA9420UK_CHG_LOCK_MASK);
+
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((pConfig->regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		status = PCA9420_DRV_BlockWrite(pSensorHandle, s_regions[i].first, &regs[s_regions[i].first], s_regions[i].count);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+	if ((pConfig->regions & PCA9420_CFG_REGION_TOP) != 0u)
+	{
+		PCA9420_EVLOG_Record(kPCA9420_EvlogModeSwitch,
+		                     (uint8_t)((regs[PCA9420UK_TOP_CNTL3] & PCA9420_TOP_CNTL3_MODE_I2C_MASK) >> PCA9420_TOP_CNTL3_MODE_I2C_SHIFT), 0);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Bits of a register that a configuration controls. */
+static uint8_t PCA9420_CFG_CareBits(uint8_t address, const uint8_t *pCareMask)
+{
+	if ((address == PCA9420UK_SUB_INT1) || (address == PCA9420UK_SUB_INT2))
+	{
+		return 0u;
+	}
+	if (address == PCA9420UK_CHG_CNTL0)
+	{
+		return (uint8_t)(((pCareMask != NULL) ? pCareMask[address] : 0xFFu) & ~PCA9420_CFG_CHG_KEY_MASK);
+	}
+	return (pCareMask != NULL) ? pCareMask[address] : 0xFFu;
+}
+
+/* Writes regs[first..last] in one burst, keyed like PCA9420_CFG_Apply(), and updates the live image. */
+static int32_t PCA9420_CFG_WriteRun(pca9420_i2c_sensorhandle_t *pSensorHandle, const uint8_t *pRegs, uint8_t *pLive,
+                                    uint8_t first, uint8_t last)
+{
+	uint8_t buffer[PCA9420_CFG_REG_COUNT];
+	int32_t status;
+
+	memcpy(&buffer[first], &pRegs[first], (size_t)(last - first + 1u));
+	PCA9420_CFG_ClearFlags(buffer);
+	if (first == PCA9420UK_CHG_CNTL0)
+	{
+		buffer[first] = (uint8_t)((buffer[first] & ~PCA9420_CFG_CHG_KEY_MASK) | PCA9420UK_CHG_LOCK_MASK);
+	}
+
+	status = PCA9420_DRV_BlockWrite(pSensorHandle, first, &buffer[first], (uint8_t)(last - first + 1u));
+	if (SENSOR_ERROR_NONE == status)
+	{
+		memcpy(&pLive[first], &pRegs[first], (size_t)(last - first + 1u));
+	}
+	return status;
+}
+
+int32_t PCA9420_CFG_Reconcile(pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_config_t *pTarget,
+                              const uint8_t *pCareMask, pca9420_config_t *pCache, pca9420_cfg_result_t *pResult)
+{
+	pca9420_config_t live;
+	pca9420_config_t *pLive = (pCache != NULL) ? pCache : &live;
+	pca9420_cfg_result_t result;
+	uint8_t regs[PCA9420_CFG_REG_COUNT];
+	uint8_t missing, first, last, address, care, runFirst, runLast, oldTop;
+	bool inRun;
+	int32_t status = SENSOR_ERROR_NONE;
+	uint32_t i, j;
+
+	if ((pSensorHandle == NULL) || (pTarget == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	memset(&result, 0, sizeof(result));
+	if (pCache == NULL)
+	{
+		live.regions = 0u;
+	}
+
+	/* One burst over every region the cache does not hold, the registers in between are harmless to read. */
+	missing = pTarget->regions & (uint8_t)~pLive->regions;
+	first = PCA9420_CFG_REG_COUNT;
+	last = 0u;
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((missing & s_regions[i].region) != 0u)
+		{
+			first = MIN(first, s_regions[i].first);
+			last = MAX(last, (uint8_t)(s_regions[i].first + s_regions[i].count - 1u));
+		}
+	}
+	if (first <= last)
+	{
+		status = PCA9420_DRV_BlockRead(pSensorHandle, first, &pLive->regs[first], (uint8_t)(last - first + 1u));
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+		result.reads = 1u;
+		pLive->regions |= missing;
+		PCA9420_CFG_ClearFlags(pLive->regs);
+	}
+
+	/* Live values with the cared-for bits of the target. */
+	memcpy(regs, pLive->regs, sizeof(regs));
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((pTarget->regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		for (j = 0u; j < s_regions[i].count; j++)
+		{
+			address = (uint8_t)(s_regions[i].first + j);
+			care = PCA9420_CFG_CareBits(address, pCareMask);
+			regs[address] = (uint8_t)((regs[address] & ~care) | (pTarget->regs[address] & care));
+		}
+	}
+	if (((pTarget->regions & PCA9420_CFG_REGION_TOP) != 0u) &&
+	    ((regs[PCA9420UK_TOP_CNTL3] & PCA9420_CFG_SW_RESET_FIELD) == PCA9420_TOP_CNTL3_SW_RESET_MASK))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	oldTop = pLive->regs[PCA9420UK_TOP_CNTL3];
+	for (i = 0u; (i < ARRAY_SIZE(s_regions)) && (SENSOR_ERROR_NONE == status); i++)
+	{
+		if ((pTarget->regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		inRun = false;
+		runFirst = runLast = 0u;
+		for (j = 0u; j <= s_regions[i].count; j++)
+		{
+			address = (uint8_t)(s_regions[i].first + j);
+			if ((j < s_regions[i].count) && (regs[address] != pLive->regs[address]))
+			{
+				result.changed++;
+				result.changedMap[address >> 3] |= (uint8_t)(1u << (address & 7u));
+				if (!inRun)
+				{
+					/* The charger registers only take writes behind the key in CHG_CNTL0, one burst from there. */
+					runFirst = (s_regions[i].region == PCA9420_CFG_REGION_CHARGER) ? s_regions[i].first : address;
+					inRun = true;
+				}
+				runLast = address;
+			}
+			else if (inRun && ((j == s_regions[i].count) ||
+			                   ((s_regions[i].region != PCA9420_CFG_REGION_CHARGER) &&
+			                    ((uint32_t)(address - runLast) > PCA9420_CFG_MERGE_GAP))))
+			{
+				status = PCA9420_CFG_WriteRun(pSensorHandle, regs, pLive->regs, runFirst, runLast);
+				if (SENSOR_ERROR_NONE != status)
+				{
+					break;
+				}
+				result.writes++;
+				inRun = false;
+			}
+		}
+	}
+
+	if (((pLive->regs[PCA9420UK_TOP_CNTL3] ^ oldTop) & PCA9420_TOP_CNTL3_MODE_I2C_MASK) != 0u)
+	{
+		PCA9420_EVLOG_Record(kPCA9420_EvlogModeSwitch,
+		                     (uint8_t)((pLive->regs[PCA9420UK_TOP_CNTL3] & PCA9420_TOP_CNTL3_MODE_I2C_MASK) >> PCA9420_TOP_CNTL3_MODE_I2C_SHIFT), 0);
+	}
+
+	if (pResult != NULL)
+	{
+		*pResult = result;
+	}
+	return status;
+}
+
+uint32_t PCA9420_CFG_Diff(const pca9420_config_t *pExpected, const pca9420_config_t *pActual, pca9420_cfg_diff_visit_t visit,
+                          void *pUserData)
+{
+	uint8_t regions = pExpected->regions & pActual->regions;
+	uint8_t address, mask;
+	uint32_t i, j, count = 0u;
+
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		for (j = 0u; j < s_regions[i].count; j++)
+		{
+			address = (uint8_t)(s_regions[i].first + j);
+			if ((address == PCA9420UK_SUB_INT1) || (address == PCA9420UK_SUB_INT2))
+			{
+				continue;
+			}
+			mask = (address == PCA9420UK_CHG_CNTL0) ? (uint8_t)~PCA9420_CFG_CHG_KEY_MASK : 0xFFu;
+			if (((pExpected->regs[address] ^ pActual->regs[address]) & mask) != 0u)
+			{
+				count++;
+				if (visit != NULL)
+				{
+					visit(address, pExpected->regs[address], pActual->regs[address], pUserData);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+uint8_t PCA9420_CFG_RegionOf(uint8_t address)
+{
+	uint32_t i;
+
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((address >= s_regions[i].first) && (address < s_regions[i].first + s_regions[i].count))
+		{
+			return s_regions[i].region;
+		}
+	}
+	return 0u;
+}
+
+/* CRC16 of the checked bits of every region held by the configuration, in region order. */
+static uint16_t PCA9420_CFG_VerifyCrc(const pca9420_cfg_verify_t *pVerify, const uint8_t *pRegs)
+{
+	uint8_t masked[PCA9420_CFG_REG_COUNT];
+	uint16_t crc = CRC16_INIT;
+	uint32_t i, j;
+
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((pVerify->expected.regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		for (j = s_regions[i].first; j < (uint32_t)s_regions[i].first + s_regions[i].count; j++)
+		{
+			masked[j] = pRegs[j] & pVerify->care[j];
+		}
+		crc = CRC16_Update(crc, &masked[s_regions[i].first], s_regions[i].count);
+	}
+
+	return crc;
+}
+
+/* Puts back writes taken by a check that could not complete. */
+static void PCA9420_CFG_VerifyMerge(pca9420_cfg_verify_t *pVerify, const uint8_t *pWritten)
+{
+	uint32_t i, primask = DisableGlobalIRQ();
+
+	for (i = 0u; i < sizeof(pVerify->writtenMap); i++)
+	{
+		pVerify->writtenMap[i] |= pWritten[i];
+	}
+	EnableGlobalIRQ(primask);
+}
+
+int32_t PCA9420_CFG_VerifyInit(pca9420_cfg_verify_t *pVerify, const pca9420_config_t *pExpected, const uint8_t *pCareMask)
+{
+	uint32_t address, primask;
+
+	if ((pVerify == NULL) || (pExpected == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	pVerify->expected.regions = pExpected->regions;
+	for (address = 0u; address < PCA9420_CFG_REG_COUNT; address++)
+	{
+		pVerify->care[address] = PCA9420_CFG_CareBits((uint8_t)address, pCareMask);
+		pVerify->expected.regs[address] = pExpected->regs[address] & pVerify->care[address];
+	}
+	pVerify->crc = PCA9420_CFG_VerifyCrc(pVerify, pVerify->expected.regs);
+	memset(pVerify->driftMap, 0, sizeof(pVerify->driftMap));
+	primask = DisableGlobalIRQ();
+	for (address = 0u; address < sizeof(pVerify->writtenMap); address++)
+	{
+		pVerify->writtenMap[address] = 0u;
+	}
+	EnableGlobalIRQ(primask);
+
+	return SENSOR_ERROR_NONE;
+}
+
+void PCA9420_CFG_VerifyNoteWrite(pca9420_cfg_verify_t *pVerify, uint8_t address, uint8_t length)
+{
+	uint32_t primask, last = (uint32_t)address + length;
+
+	if (last > PCA9420_CFG_REG_COUNT)
+	{
+		last = PCA9420_CFG_REG_COUNT;
+	}
+	primask = DisableGlobalIRQ();
+	for (; address < last; address++)
+	{
+		pVerify->writtenMap[address >> 3] |= (uint8_t)(1u << (address & 7u));
+	}
+	EnableGlobalIRQ(primask);
+}
+
+int32_t PCA9420_CFG_Verify(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_cfg_verify_t *pVerify,
+                           pca9420_cfg_diff_visit_t visit, void *pUserData, uint32_t *pMismatches)
+{
+	uint8_t live[PCA9420_CFG_REG_COUNT];
+	uint8_t written[sizeof(pVerify->writtenMap)];
+	uint8_t actual, bit, drifting = 0u, folded = 0u;
+	int32_t status;
+	uint32_t i, address, primask, count = 0u;
+
+	if ((pSensorHandle == NULL) || (pVerify == NULL) || (pMismatches == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/* Take the application's writes so far, a write during the reads below marks again. */
+	primask = DisableGlobalIRQ();
+	for (i = 0u; i < sizeof(written); i++)
+	{
+		written[i] = pVerify->writtenMap[i];
+		pVerify->writtenMap[i] = 0u;
+		drifting |= pVerify->driftMap[i];
+	}
+	EnableGlobalIRQ(primask);
+
+	for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+	{
+		if ((pVerify->expected.regions & s_regions[i].region) == 0u)
+		{
+			continue;
+		}
+		status = PCA9420_DRV_BlockRead(pSensorHandle, s_regions[i].first, &live[s_regions[i].first], s_regions[i].count);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			/* Keep the writes for the next check. */
+			PCA9420_CFG_VerifyMerge(pVerify, written);
+			return status;
+		}
+		for (address = s_regions[i].first; address < (uint32_t)s_regions[i].first + s_regions[i].count; address++)
+		{
+			bit = (uint8_t)(1u << (address & 7u));
+			if ((written[address >> 3] & bit) != 0u)
+			{
+				pVerify->expected.regs[address] = live[address] & pVerify->care[address];
+				pVerify->driftMap[address >> 3] &= (uint8_t)~bit;
+				folded = 1u;
+			}
+		}
+	}
+	if (folded != 0u)
+	{
+		pVerify->crc = PCA9420_CFG_VerifyCrc(pVerify, pVerify->expected.regs);
+	}
+
+	if ((PCA9420_CFG_VerifyCrc(pVerify, live) != pVerify->crc) || (drifting != 0u))
+	{
+		for (i = 0u; i < ARRAY_SIZE(s_regions); i++)
+		{
+			if ((pVerify->expected.regions & s_regions[i].region) == 0u)
+			{
+				continue;
+			}
+			for (address = s_regions[i].first; address < (uint32_t)s_regions[i].first + s_regions[i].count; address++)
+			{
+				bit = (uint8_t)(1u << (address & 7u));
+				if ((pVerify->writtenMap[address >> 3] & bit) != 0u)
+				{
+					continue; /* Written while reading, the next check takes it. */
+				}
+				actual = live[address] & pVerify->care[address];
+				if (actual != pVerify->expected.regs[address])
+				{
+					count++;
+					if (visit != NULL)
+					{
+						visit((uint8_t)address, pVerify->expected.regs[address], actual, pUserData);
+					}
+					pVerify->driftMap[address >> 3] |= bit;
+				}
+				else if ((pVerify->driftMap[address >> 3] & bit) != 0u)
+				{
+					if (visit != NULL)
+					{
+						visit((uint8_t)address, actual, actual, pUserData);
+					}
+					pVerify->driftMap[address >> 3] &= (uint8_t)~bit;
+				}
+			}
+		}
+	}
+	*pMismatches = count;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_CFG_VerifyAcknowledge(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_cfg_verify_t *pVerify)
+{
+	pca9420_config_t live;
+	int32_t status;
+
+	if ((pSensorHandle == NULL) || (pVerify == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCA9420_CFG_Capture(pSensorHandle, &live, pVerify->expected.regions);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	return PCA9420_CFG_VerifyInit(pVerify, &live, pVerify->care);
+}
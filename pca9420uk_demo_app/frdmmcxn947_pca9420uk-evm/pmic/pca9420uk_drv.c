@@ -12,8 +12,10 @@
 //-----------------------------------------------------------------------
 // ISSDK Includes
 //-----------------------------------------------------------------------
+#include "fsl_common.h"
 #include "pca9420uk_drv.h"
 #include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
 
 #include "systick_utils.h"
 #include "stdio.h"
@@ -21,6 +23,21 @@
 
 bool repeatedStart = 1;
 
+/* Every register write goes through here, the write listener hears of the successful ones. */
+static int32_t PCA9420_DRV_RegWrite(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t RegAddress, uint8_t value, uint8_t mask,
+                                    bool repeatedStart)
+{
+	int32_t status;
+
+	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, RegAddress,
+	                            value, mask, repeatedStart);
+	if ((ARM_DRIVER_OK == status) && (pSensorHandle->writeListener != NULL))
+	{
+		pSensorHandle->writeListener(RegAddress, 1u, pSensorHandle->pWriteListenerData);
+	}
+	return status;
+}
+
 //APIs
 
 int32_t PCA9420_I2C_Initialize(pca9420_i2c_sensorhandle_t *pSensorHandle, ARM_DRIVER_I2C *pBus, uint8_t index, uint16_t sAddress)
@@ -41,11 +58,22 @@ int32_t PCA9420_I2C_Initialize(pca9420_i2c_sensorhandle_t *pSensorHandle, ARM_DR
 	/*! Initialize the sensor handle. */
 	pSensorHandle->pCommDrv = pBus;
 	pSensorHandle->slaveAddress = sAddress;
+	pSensorHandle->writeListener = NULL;
+	pSensorHandle->pWriteListenerData = NULL;
 	pSensorHandle->isInitialized = true;
 
 	return SENSOR_ERROR_NONE;
 }
 
+void PCA9420_DRV_SetWriteListener(pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_write_listener_t listener, void *pUserData)
+{
+	uint32_t primask = DisableGlobalIRQ();
+
+	pSensorHandle->writeListener = listener;
+	pSensorHandle->pWriteListenerData = pUserData;
+	EnableGlobalIRQ(primask);
+}
+
 int32_t PCA9420_DRV_Read(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t RegAddress, uint16_t* Data)
 {
 	int32_t status;
@@ -66,7 +94,7 @@ int32_t PCA9420_DRV_Write(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t Reg
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, RegAddress,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, RegAddress,
 			Data, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
@@ -76,11 +104,66 @@ int32_t PCA9420_DRV_Write(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t Reg
 	return SENSOR_ERROR_NONE;
 }
 
+int32_t PCA9420_DRV_BlockRead(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t StartAddress, uint8_t *pBuffer, uint8_t length)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL) || (length == 0))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before reading.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, StartAddress, length, pBuffer);
+	if (ARM_DRIVER_OK != status)
+	{
+		pSensorHandle->isInitialized = false;
+		return SENSOR_ERROR_INIT;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_DRV_BlockWrite(pca9420_i2c_sensorhandle_t *pSensorHandle, uint8_t StartAddress, const uint8_t *pBuffer, uint8_t length)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL) || (length == 0) || (length >= SENSOR_MAX_REGISTER_COUNT))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before writing.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	status = Register_I2C_BlockWrite(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, StartAddress, pBuffer, length);
+	if (ARM_DRIVER_OK != status)
+	{
+		return SENSOR_ERROR_WRITE;
+	}
+	if (pSensorHandle->writeListener != NULL)
+	{
+		pSensorHandle->writeListener(StartAddress, length, pSensorHandle->pWriteListenerData);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
 int32_t PCA9420_wtchdg_timer_reset(pca9420_i2c_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL4,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL4,
 			PCA9420_WTCHDG_TIMER_RESET, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
@@ -153,7 +236,7 @@ int32_t PCA9420_Set_long_glitch_timer(pca9420_i2c_sensorhandle_t *pSensorHandle,
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL3,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL3,
 			(uint8_t)(eLngGthTmr << PCA9420_TOP_CNTL3_ON_GLT_LONG_SHIFT), PCA9420_TOP_CNTL3_ON_GLT_LONG_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -180,7 +263,7 @@ int32_t PCA9420_SW_reset(pca9420_i2c_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL3,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL3,
 			PCA9420_TOP_CNTL3_SW_RESET_MASK, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
@@ -206,13 +289,14 @@ int32_t PCA9420_Set_mode_control(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL3,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL3,
 			(uint8_t)(epca9420_mode << PCA9420_MODE_CNTL_SEL_SHIFT), PCA9420_MODE_CNTL_SEL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogModeSwitch, (uint8_t)epca9420_mode, 0);
 
 	return SENSOR_ERROR_NONE;
 }
@@ -280,7 +364,7 @@ int32_t PCA9420_Set_die_temp_tshld(pca9420_i2c_sensorhandle_t *pSensorHandle, en
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL2,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL2,
 			(uint8_t)(epca9420_die_temp << PCA9420_MODE_DIE_TEMP_SHIFT), PCA9420_MODE_DIE_TEMP_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -354,7 +438,7 @@ int32_t PCA9420_Set_thrml_shtdn_tshld(pca9420_i2c_sensorhandle_t *pSensorHandle,
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL2,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL2,
 			(uint8_t)(epca9420_them_shdn << PCA9420_MODE_THML_STDN_SHIFT), PCA9420_MODE_THML_STDN_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -436,7 +520,7 @@ int32_t PCA9420_Set_asys_uvlo_tshld(pca9420_i2c_sensorhandle_t *pSensorHandle, e
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL2,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL2,
 			(uint8_t)(epca9420_asys_uvlo << PCA9420_MODE_ASYS_UVLO_SHIFT), PCA9420_MODE_ASYS_UVLO_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -509,7 +593,7 @@ int32_t PCA9420_Set_vin_uvlo_tshld(pca9420_i2c_sensorhandle_t *pSensorHandle, en
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL1,
 			(uint8_t)(epca9420_vin_uvlo << PCA9420_MODE_VIN_UVLO_SHIFT), PCA9420_MODE_VIN_UVLO_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -582,7 +666,7 @@ int32_t PCA9420_Set_vin_overvoltage_tshld(pca9420_i2c_sensorhandle_t *pSensorHan
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL1,
 			(uint8_t)(epca9420_vin_ovp << PCA9420_MODE_VIN_OVP_SHIFT), PCA9420_MODE_VIN_OVP_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -649,7 +733,7 @@ int32_t PCA9420_asys_input_src_sel(pca9420_i2c_sensorhandle_t *pSensorHandle, en
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL1,
 			(uint8_t)(epca9420_asys_input_sel << PCA9420_MODE_ASYS_INP_SEL_SHIFT), PCA9420_MODE_ASYS_INP_SEL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -677,7 +761,7 @@ int32_t PCA9420_Set_asys_prewarn_vol_tshld(pca9420_i2c_sensorhandle_t *pSensorHa
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL1,
 			(uint8_t)(epca9420_asys_prewarning << PCA9420_MODE_ASYS_PRE_VOL_SHIFT), PCA9420_MODE_ASYS_PRE_VOL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -752,7 +836,7 @@ int32_t PCA9420_Set_vin_inp_cur(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL0,
 			(uint8_t)(epca9420_vin_ilim << PCA9420_MODE_VIN_ILIM_SEL_SHIFT), PCA9420_MODE_VIN_ILIM_SEL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -844,7 +928,7 @@ int32_t PCA9420_enable_disable_bleed_resistor(pca9420_i2c_sensorhandle_t *pSenso
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_ACT_DIS_CNTL_1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_ACT_DIS_CNTL_1,
 			(uint8_t)(operation << shift), mask, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -889,7 +973,7 @@ int32_t PCA9420_ship_mode_enable_disable(pca9420_i2c_sensorhandle_t *pSensorHand
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(operation << PCA9420_SHIP_MODE_SHIFT), PCA9420_SHIP_MODE_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -934,7 +1018,7 @@ int32_t PCA9420_mode_control(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pc
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(operation << PCA9420_MODE_CTRL_SHIFT), PCA9420_MODE_CTRL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -979,13 +1063,15 @@ int32_t PCA9420_Set_sw1_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(epca9420_sw1_out << PCA9420_SW1_VOL_SHIFT), PCA9420_SW1_VOL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogVoltage, (uint8_t)((kPCA9420_RegulatorSwitch1 << 4) | epca9420_mode),
+	                     (uint16_t)PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch1, (uint8_t)epca9420_sw1_out));
 
 	return SENSOR_ERROR_NONE;
 }
@@ -1024,13 +1110,15 @@ int32_t PCA9420_Set_sw2_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(epca9420_sw2_out << PCA9420_SW2_VOL_SHIFT), PCA9420_SW2_VOL_OFF_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogVoltage, (uint8_t)((kPCA9420_RegulatorSwitch2 << 4) | epca9420_mode),
+	                     (uint16_t)PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch2, (uint8_t)epca9420_sw2_out));
 
 	return SENSOR_ERROR_NONE;
 }
@@ -1070,13 +1158,15 @@ int32_t PCA9420_Set_ldo1_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(epca9420_ldo1_out << PCA9420_LDO1_VOL_SHIFT), PCA9420_LDO1_VOL_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogVoltage, (uint8_t)((kPCA9420_RegulatorLdo1 << 4) | epca9420_mode),
+	                     (uint16_t)PCA9420_Decode_regulator_mv(kPCA9420_RegulatorLdo1, (uint8_t)epca9420_ldo1_out));
 
 	return SENSOR_ERROR_NONE;
 }
@@ -1115,13 +1205,94 @@ int32_t PCA9420_Set_ldo2_out_vol(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(epca9420_ldo2_out << PCA9420_LDO2_VOL_SHIFT), PCA9420_LDO2_VOL_OFF_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogVoltage, (uint8_t)((kPCA9420_RegulatorLdo2 << 4) | epca9420_mode),
+	                     (uint16_t)PCA9420_Decode_regulator_mv(kPCA9420_RegulatorLdo2, (uint8_t)epca9420_ldo2_out));
+
+	return SENSOR_ERROR_NONE;
+}
+
+uint32_t PCA9420_Decode_regulator_mv(pca9420_regulator_t regulator, uint8_t code)
+{
+	uint32_t offset = 0, step;
+
+	switch (regulator)
+	{
+	case kPCA9420_RegulatorSwitch1:
+		step = code & PCA9420_SW1_VOL_MASK;
+		/* 0.5 V to 1.5 V in 25 mV steps, codes above clamp to 1.5 V except the fixed 1.8 V code. */
+		if (step == kPCA9420_Sw1OutVolt1V800)
+		{
+			return 1800u;
+		}
+		return (step <= kPCA9420_Sw1OutVolt1V500) ? (500u + step * 25u) : 1500u;
+	case kPCA9420_RegulatorLdo1:
+		step = code & (PCA9420_LDO1_VOL_MASK >> PCA9420_LDO1_VOL_SHIFT);
+		return (step <= kPCA9420_Ldo1OutVolt1V900) ? (1700u + step * 25u) : 1900u;
+	case kPCA9420_RegulatorSwitch2:
+	case kPCA9420_RegulatorLdo2:
+		/* Both share the layout: 1.5 V to 2.1 V in 25 mV steps, bit 5 adds 1.2 V. */
+		if (code & PCA9420_SW2_VOL_OFFSET_MASK)
+		{
+			offset = 1200u;
+		}
+		step = code & PCA9420_SW2_VOL_MASK;
+		return offset + ((step <= kPCA9420_Sw2OutVolt2V100) ? (1500u + step * 25u) : 2100u);
+	default:
+		return 0;
+	}
+}
+
+int32_t PCA9420_Encode_regulator_mv(pca9420_regulator_t regulator, uint32_t milliVolt, uint8_t *pCode)
+{
+	uint32_t min, max, base = 0;
+
+	if (pCode == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	switch (regulator)
+	{
+	case kPCA9420_RegulatorSwitch1:
+		if (milliVolt == 1800u)
+		{
+			*pCode = kPCA9420_Sw1OutVolt1V800;
+			return SENSOR_ERROR_NONE;
+		}
+		min = 500u;
+		max = 1500u;
+		break;
+	case kPCA9420_RegulatorLdo1:
+		min = 1700u;
+		max = 1900u;
+		break;
+	case kPCA9420_RegulatorSwitch2:
+	case kPCA9420_RegulatorLdo2:
+		if (milliVolt >= 2700u)
+		{
+			milliVolt -= 1200u;
+			base = PCA9420_SW2_VOL_OFFSET_MASK;
+		}
+		min = 1500u;
+		max = 2100u;
+		break;
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	if ((milliVolt < min) || (milliVolt > max) || ((milliVolt - min) % 25u))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	*pCode = (uint8_t)(base | ((milliVolt - min) / 25u));
 
 	return SENSOR_ERROR_NONE;
 }
@@ -1161,7 +1332,7 @@ int32_t PCA9420_Set_wtchdg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(epca9420_wd_timer << PCA9420_MODE_WD_TIMER_SHIFT), PCA9420_MODE_WD_TIMER_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1172,6 +1343,54 @@ int32_t PCA9420_Set_wtchdg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 	return SENSOR_ERROR_NONE;
 }
 
+int32_t PCA9420_Get_wtchdg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pca9420_mode epca9420_mode, enum _pca9420_wd_timer *pBuffer)
+{
+	int32_t status;
+	uint8_t offset;
+	uint8_t reg;
+
+	if(epca9420_mode == kPCA9420_Mode0)
+	{
+		offset = PCA9420UK_MODECFG_0_3;
+	}
+	else if(epca9420_mode == kPCA9420_Mode1)
+	{
+		offset = PCA9420UK_MODECFG_1_3;
+	}
+	else if(epca9420_mode == kPCA9420_Mode2)
+	{
+		offset = PCA9420UK_MODECFG_2_3;
+	}
+	else
+	{
+		offset = PCA9420UK_MODECFG_3_3;
+	}
+
+	/*! Validate for the correct handle and register write list.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before applying configuration.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset, PCA9420UK_REG_SIZE_BYTES, &reg);
+
+	if (ARM_DRIVER_OK != status)
+	{
+		pSensorHandle->isInitialized = false;
+		return SENSOR_ERROR_INIT;
+	}
+
+	*pBuffer = (enum _pca9420_wd_timer)((reg & PCA9420_MODE_WD_TIMER_MASK) >> PCA9420_MODE_WD_TIMER_SHIFT);
+
+	return SENSOR_ERROR_NONE;
+}
+
 int32_t PCA9420_vol_reg_enable_disable(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _pca9420_mode epca9420_mode,
 		enum _pca9420_vol_reg_source epca9420_vol_reg_source, uint8_t operation)
 {
@@ -1229,13 +1448,14 @@ int32_t PCA9420_vol_reg_enable_disable(pca9420_i2c_sensorhandle_t *pSensorHandle
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(operation << shift), mask, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
 		return SENSOR_ERROR_WRITE;
 	}
+	PCA9420_EVLOG_Record(kPCA9420_EvlogRailEnable, (uint8_t)((epca9420_vol_reg_source << 4) | epca9420_mode), operation);
 
 	return SENSOR_ERROR_NONE;
 }
@@ -1275,7 +1495,7 @@ int32_t PCA9420_on_pin_mode_set(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, offset,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, offset,
 			(uint8_t)(operation << PCA9420_MODE_ON_CFG_SHIFT), PCA9420_MODE_ON_CFG_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1291,11 +1511,11 @@ int32_t PCA9420_clear_interrupt(pca9420_i2c_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT0,
 			PCA9420_CLR_INT_MASK, 0, repeatedStart);
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT1,
 			PCA9420_CLR_INT_MASK, 0, repeatedStart);
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT2,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT2,
 			PCA9420_CLR_INT_MASK, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
@@ -1310,7 +1530,7 @@ int32_t PCA9420_enable_disable_System_int(pca9420_i2c_sensorhandle_t *pSensorHan
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT0_MASK,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT0_MASK,
 			data, 0, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1326,7 +1546,7 @@ int32_t PCA9420_enable_disable_bat_int(pca9420_i2c_sensorhandle_t *pSensorHandle
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT1_MASK,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT1_MASK,
 			data, 0, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1341,7 +1561,7 @@ int32_t PCA9420_enable_disable_vol_reg_int(pca9420_i2c_sensorhandle_t *pSensorHa
 {
 	int32_t status;
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_SUB_INT2_MASK,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_SUB_INT2_MASK,
 			data, 0, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1370,7 +1590,7 @@ int32_t PCA9420_chrg_conf_wtchdg(pca9420_i2c_sensorhandle_t *pSensorHandle, uint
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_TOP_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_TOP_CNTL0,
 			(uint8_t)(operation << PCA9420UK_EN_CHG_IN_WTCH_SHIFT), PCA9420UK_EN_CHG_IN_WTCH_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1399,7 +1619,7 @@ int32_t PCA9420_enable_chg_lock(pca9420_i2c_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL0,
 			0xAB, 0, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1426,7 +1646,7 @@ int32_t PCA9420_ntc_cntrl_enable_disable(pca9420_i2c_sensorhandle_t *pSensorHand
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL0,
 			(uint8_t)(operation << PCA9420_NTC_EN_SHIFT), PCA9420_NTC_EN_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1453,7 +1673,7 @@ int32_t PCA9420_fast_preq_timer_enable_disable(pca9420_i2c_sensorhandle_t *pSens
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL0,
 			(uint8_t)(operation << PCA9420_CHG_TIMER_EN_SHIFT), PCA9420_CHG_TIMER_EN_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1480,7 +1700,7 @@ int32_t PCA9420_charger_enable_disable(pca9420_i2c_sensorhandle_t *pSensorHandle
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL0,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL0,
 			(uint8_t)(operation << PCA9420_CHG_EN_SHIFT), PCA9420_CHG_EN_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1508,7 +1728,7 @@ int32_t PCA9420_Set_battery_charge_cur(pca9420_i2c_sensorhandle_t *pSensorHandle
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL1,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL1,
 			(uint8_t)(epca9420_bat_chrg_cur << PCA9420_MODE_ICHG_CC_SHIFT), PCA9420_MODE_ICHG_CC_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1536,7 +1756,7 @@ int32_t PCA9420_Set_battery_topoff_cur(pca9420_i2c_sensorhandle_t *pSensorHandle
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL2,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL2,
 			(uint8_t)(epca9420_bat_topoff_cur << PCA9420_MODE_ICHG_TOPOFF_SHIFT), PCA9420_MODE_ICHG_TOPOFF_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1564,7 +1784,7 @@ int32_t PCA9420_Set_low_battery_chrg_cur(pca9420_i2c_sensorhandle_t *pSensorHand
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL3,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL3,
 			(uint8_t)(epca9420_low_bat_chrg_cur << PCA9420_MODE_ICHG_LOW_SHIFT), PCA9420_MODE_ICHG_LOW_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1638,7 +1858,7 @@ int32_t PCA9420_Set_dead_chrg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, e
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL4,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL4,
 			(uint8_t)(epca9420_dead_chrg_timer << PCA9420_MODE_ICHG_DEAD_TIMER_SHIFT), PCA9420_MODE_ICHG_DAED_TIMER_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1665,7 +1885,7 @@ int32_t PCA9420_Set_dead_chrg_cur(pca9420_i2c_sensorhandle_t *pSensorHandle, enu
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL4,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL4,
 			(uint8_t)(epca9420_dead_bat_chrg_cur << PCA9420_MODE_ICHG_DEAD_SHIFT), PCA9420_MODE_ICHG_DAED_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1739,7 +1959,7 @@ int32_t PCA9420_Set_thrshld_rechrg(pca9420_i2c_sensorhandle_t *pSensorHandle, en
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL5,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL5,
 			(uint8_t)(epca9420_threshld_rechrg << PCA9420_VBAT_RESTART_SHIFT), PCA9420_VBAT_RESTART_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1766,7 +1986,7 @@ int32_t PCA9420_Set_bat_regulation_vol(pca9420_i2c_sensorhandle_t *pSensorHandle
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL5,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL5,
 			(uint8_t)(epca9420_bat_reg_vol << PCA9420_VBAT_REG_SHIFT), PCA9420_VBAT_REG_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1793,7 +2013,7 @@ int32_t PCA9420_Set_thmstr_resistance(pca9420_i2c_sensorhandle_t *pSensorHandle,
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL6,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL6,
 			(uint8_t)(epca9420_ntc_res_sel << PCA9420_NTC_RES_SEL_SHIFT), PCA9420_NTC_RES_SEL_MASK,  repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1862,7 +2082,7 @@ int32_t PCA9420_Set_fast_chrg_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, e
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL6,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL6,
 			(uint8_t)(epca9420_fast_chrg_timer << PCA9420_ICHG_FAST_TIMER_SHIFT), PCA9420_ICHG_FAST_TIMER_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -1936,7 +2156,7 @@ int32_t PCA9420_Set_preq_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum _
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL6,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL6,
 			(uint8_t)(epca9420_preq_chrg_timer << PCA9420_ICHG_PREQ_TIMER_SHIFT), PCA9420_ICHG_PREQ_TIMER_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -2009,7 +2229,7 @@ int32_t PCA9420_Set_topoff_timer(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL6,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL6,
 			(uint8_t)(epca9420_topoff_timer << PCA9420_T_TOPOFF_TIMER_SHIFT), PCA9420_T_TOPOFF_TIMER_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -2082,7 +2302,7 @@ int32_t PCA9420_Set_ntc_beta_val(pca9420_i2c_sensorhandle_t *pSensorHandle, enum
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL7,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL7,
 			(uint8_t)(epca9420_ntc_beta_val << PCA9420_NTC_BETA_SHIFT), PCA9420_NTC_BETA_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
@@ -2167,7 +2387,7 @@ int32_t PCA9420_Set_thrml_reg_thshld(pca9420_i2c_sensorhandle_t *pSensorHandle,
 		return SENSOR_ERROR_INIT;
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress, PCA9420UK_CHG_CNTL7,
+	status = PCA9420_DRV_RegWrite(pSensorHandle, PCA9420UK_CHG_CNTL7,
 			(uint8_t)(epca9420_thrml_reg_thshld << PCA9420_THM_REG_SHIFT), PCA9420_THM_REG_MASK, repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
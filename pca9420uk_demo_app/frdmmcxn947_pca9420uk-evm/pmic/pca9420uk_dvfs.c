@@ -0,0 +1,205 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_dvfs.c
+ * @brief The pca9420uk_dvfs.c file implements the PCA9420UK coordinated DVFS engine.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_dvfs.h"
+#include "pca9420uk.h"
+#include "systick_utils.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t PCA9420_DVFS_ElapsedUs(int32_t *pStart, uint32_t clockHz)
+{
+	return (uint32_t)COUNT_TO_USEC((uint32_t)BOARD_SystickElapsedTicks(pStart), clockHz);
+}
+
+/* SW1 of the mode the PMIC runs in. */
+static int32_t PCA9420_DVFS_SetSw1(pca9420_dvfs_t *pDvfs, uint8_t code)
+{
+	enum _pca9420_mode mode;
+	int32_t status;
+
+	status = PCA9420_Get_mode_control(pDvfs->pSensorHandle, &mode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	return PCA9420_Set_sw1_out_vol(pDvfs->pSensorHandle, mode, (enum _pca9420_sw1_out)code);
+}
+
+/* Waits the ramp of a SW1 raise, then for its power-good. Sampled at once the flag would still tell
+ * of the old setpoint. */
+static int32_t PCA9420_DVFS_WaitPowerGood(pca9420_dvfs_t *pDvfs, uint8_t fromCode, uint8_t toCode)
+{
+	uint32_t fromMv = PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch1, fromCode);
+	uint32_t toMv = PCA9420_Decode_regulator_mv(kPCA9420_RegulatorSwitch1, toCode);
+	uint32_t rampUs = 0u;
+	uint16_t regStatus;
+	int32_t start, status;
+
+	BOARD_SystickStart(&start);
+	if (toMv > fromMv)
+	{
+		rampUs = ((toMv - fromMv) * 1000u + PCA9420_DVFS_SW1_RAMP_UV_PER_US - 1u) / PCA9420_DVFS_SW1_RAMP_UV_PER_US;
+	}
+	while (COUNT_TO_USEC((uint32_t)BOARD_SystickElapsedTicks(&start), SystemCoreClock) < rampUs)
+	{
+	}
+	pDvfs->stats.lastRampUs = rampUs;
+
+	do
+	{
+		status = PCA9420_DRV_Read(pDvfs->pSensorHandle, PCA9420UK_REG_STATUS, &regStatus);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+		if ((regStatus & kPCA9420_RegStatusVoutSw1OK) != 0u)
+		{
+			return SENSOR_ERROR_NONE;
+		}
+	} while (COUNT_TO_USEC((uint32_t)BOARD_SystickElapsedTicks(&start), SystemCoreClock) < rampUs + PCA9420_DVFS_PGOOD_TIMEOUT_US);
+
+	return SENSOR_ERROR_READ;
+}
+
+/* Switches the clock and returns its duration, counted in core cycles and scaled by the slower clock. */
+static uint32_t PCA9420_DVFS_SwitchClock(const pca9420_dvfs_opp_t *pFrom, const pca9420_dvfs_opp_t *pTo)
+{
+	int32_t start;
+	uint32_t elapsedUs;
+
+	BOARD_SystickStart(&start);
+	pTo->setClock();
+	elapsedUs = PCA9420_DVFS_ElapsedUs(&start, MIN(pFrom->coreHz, pTo->coreHz));
+	BOARD_SystickUpdateClock();
+
+	return elapsedUs;
+}
+
+int32_t PCA9420_DVFS_Init(pca9420_dvfs_t *pDvfs, pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_dvfs_opp_t *pTable,
+                          uint8_t count, pca9420_dvfs_core_level_t setCoreLevel, uint8_t current)
+{
+	if ((pDvfs == NULL) || (pSensorHandle == NULL) || (pTable == NULL) || (setCoreLevel == NULL) || (current >= count))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	memset(pDvfs, 0, sizeof(*pDvfs));
+	pDvfs->pSensorHandle = pSensorHandle;
+	pDvfs->pTable = pTable;
+	pDvfs->count = count;
+	pDvfs->current = current;
+	pDvfs->setCoreLevel = setCoreLevel;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_DVFS_SetPoint(pca9420_dvfs_t *pDvfs, uint8_t index)
+{
+	const pca9420_dvfs_opp_t *pFrom, *pTo;
+	int32_t start, status = SENSOR_ERROR_NONE;
+	uint32_t voltageUs, clockUs;
+
+	if ((pDvfs == NULL) || (index >= pDvfs->count))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (index == pDvfs->current)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+	pFrom = &pDvfs->pTable[pDvfs->current];
+	pTo = &pDvfs->pTable[index];
+	pDvfs->stats.lastRampUs = 0u;
+
+	if (pTo->coreHz > pFrom->coreHz)
+	{
+		/* Voltage first, the clock only once the rail is there. */
+		BOARD_SystickStart(&start);
+		if (pTo->sw1Code != pFrom->sw1Code)
+		{
+			status = PCA9420_DVFS_SetSw1(pDvfs, pTo->sw1Code);
+			if (SENSOR_ERROR_NONE == status)
+			{
+				status = PCA9420_DVFS_WaitPowerGood(pDvfs, pFrom->sw1Code, pTo->sw1Code);
+				if (SENSOR_ERROR_NONE != status)
+				{
+					(void)PCA9420_DVFS_SetSw1(pDvfs, pFrom->sw1Code);
+				}
+			}
+			if (SENSOR_ERROR_NONE != status)
+			{
+				pDvfs->stats.failures++;
+				return status;
+			}
+		}
+		if (pTo->coreLevel != pFrom->coreLevel)
+		{
+			pDvfs->setCoreLevel(pTo->coreLevel);
+		}
+		voltageUs = PCA9420_DVFS_ElapsedUs(&start, pFrom->coreHz);
+
+		clockUs = PCA9420_DVFS_SwitchClock(pFrom, pTo);
+		pDvfs->current = index;
+	}
+	else
+	{
+		/* Clock first, the voltages may drop once nothing runs fast on them. */
+		clockUs = PCA9420_DVFS_SwitchClock(pFrom, pTo);
+		pDvfs->current = index;
+
+		BOARD_SystickStart(&start);
+		if (pTo->coreLevel != pFrom->coreLevel)
+		{
+			pDvfs->setCoreLevel(pTo->coreLevel);
+		}
+		if (pTo->sw1Code != pFrom->sw1Code)
+		{
+			/* On failure SW1 stays above what the slower clock needs, which is safe. */
+			status = PCA9420_DVFS_SetSw1(pDvfs, pTo->sw1Code);
+		}
+		voltageUs = PCA9420_DVFS_ElapsedUs(&start, pTo->coreHz);
+	}
+
+	if (SENSOR_ERROR_NONE != status)
+	{
+		pDvfs->stats.failures++;
+	}
+	pDvfs->stats.transitions++;
+	pDvfs->stats.lastVoltageUs = voltageUs;
+	pDvfs->stats.lastClockUs = clockUs;
+	pDvfs->stats.maxUs = MAX(pDvfs->stats.maxUs, voltageUs + clockUs);
+
+	return status;
+}
+
+int32_t PCA9420_DVFS_SelectForLoad(pca9420_dvfs_t *pDvfs, uint32_t requiredHz)
+{
+	uint8_t index;
+
+	if (pDvfs == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	for (index = 0u; (index + 1u < pDvfs->count) && (pDvfs->pTable[index].coreHz < requiredHz); index++)
+	{
+	}
+
+	return PCA9420_DVFS_SetPoint(pDvfs, index);
+}
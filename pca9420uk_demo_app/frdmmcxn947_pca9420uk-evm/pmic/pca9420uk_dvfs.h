@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_dvfs.h
+ * @brief The pca9420uk_dvfs.h file describes the PCA9420UK coordinated DVFS engine.
+
+    An operating point couples a core clock setup with the level of the MCU internal core
+    regulator (SPC) and the PCA9420 SW1 output that supplies it. The engine moves between
+    points in the safe order: going up it raises SW1, waits the ramp of the voltage step and
+    then for its power-good, raises the core regulator and only then the clock; going down it lowers the clock first and the
+    voltages after it.
+
+    Every transition is timed, split into the voltage and the clock part, so the application
+    can tell what a point change costs and stay at the lowest point that carries its load.
+*/
+
+#ifndef PCA9420UK_DVFS_H_
+#define PCA9420UK_DVFS_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Longest wait for the SW1 power-good after raising it. */
+#ifndef PCA9420_DVFS_PGOOD_TIMEOUT_US
+#define PCA9420_DVFS_PGOOD_TIMEOUT_US (2000u)
+#endif
+
+/*! @brief SW1 slew rate assumed when raising it, in microvolts per microsecond. The power-good flag still
+ *         reads set from the old setpoint right after the write, so the engine waits out the ramp of the
+ *         step at this rate before it samples the flag. Lower is safer. */
+#ifndef PCA9420_DVFS_SW1_RAMP_UV_PER_US
+#define PCA9420_DVFS_SW1_RAMP_UV_PER_US (1000u)
+#endif
+
+/*! @brief Board function that sets up the core clock, one of the BOARD_BootClock functions. */
+typedef void (*pca9420_dvfs_clock_t)(void);
+
+/*! @brief Board function that sets the MCU internal core regulator level. */
+typedef void (*pca9420_dvfs_core_level_t)(uint8_t level);
+
+/*!
+ * @brief Operating point.
+ */
+typedef struct
+{
+	const char *name;             /*!< Name for the console. */
+	uint32_t coreHz;              /*!< Core clock set up by setClock. */
+	pca9420_dvfs_clock_t setClock; /*!< Clock setup. */
+	uint8_t coreLevel;            /*!< Core regulator level, board specific, higher is more voltage. */
+	uint8_t sw1Code;              /*!< SW1 output, enum _pca9420_sw1_out. */
+} pca9420_dvfs_opp_t;
+
+/*!
+ * @brief Transition statistics, times in microseconds.
+ */
+typedef struct
+{
+	uint32_t transitions;   /*!< Completed transitions. */
+	uint32_t failures;      /*!< Transitions that failed, see PCA9420_DVFS_SetPoint(). */
+	uint32_t lastVoltageUs; /*!< SW1 and core regulator part of the last transition, ramp and power-good wait included. */
+	uint32_t lastRampUs;    /*!< SW1 ramp wait of the last transition, 0 when SW1 was not raised. */
+	uint32_t lastClockUs;   /*!< Clock part of the last transition, core cycles scaled by the slower clock. */
+	uint32_t maxUs;         /*!< Longest transition. */
+} pca9420_dvfs_stats_t;
+
+/*!
+ * @brief DVFS engine context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+	const pca9420_dvfs_opp_t *pTable;          /*!< Operating points by rising coreHz. */
+	uint8_t count;                             /*!< Number of points. */
+	uint8_t current;                           /*!< Point in force. */
+	pca9420_dvfs_core_level_t setCoreLevel;    /*!< Core regulator hook. */
+	pca9420_dvfs_stats_t stats;                /*!< Statistics. */
+} pca9420_dvfs_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to set up the DVFS engine.
+ *  @details     This function only records the point in force, nothing is written.
+ *  @param[out]  pDvfs          engine context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pTable         operating points, ordered by rising coreHz and voltages.
+ *  @param[in]   count          number of points.
+ *  @param[in]   setCoreLevel   core regulator hook.
+ *  @param[in]   current        point the MCU and PMIC are in now.
+ *  @constraints The systick periodic tick must run, see BOARD_SystickEnableTick().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_DVFS_Init() returns the status.
+ */
+int32_t PCA9420_DVFS_Init(pca9420_dvfs_t *pDvfs, pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_dvfs_opp_t *pTable,
+                          uint8_t count, pca9420_dvfs_core_level_t setCoreLevel, uint8_t current);
+
+/*! @brief       The interface function to move to an operating point.
+ *  @details     This function writes SW1 of the active PMIC mode. A failure on the way up restores SW1
+ *               and leaves the point unchanged. On the way down the clock is already lowered when a
+ *               voltage write fails, the point changes and SW1 stays higher than needed.
+ *  @param[in]   pDvfs          engine context.
+ *  @param[in]   index          target point.
+ *  @constraints Thread context only. The periodic tick is reprogrammed for the new clock.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_DVFS_SetPoint() returns the status, SENSOR_ERROR_READ when power-good timed out.
+ */
+int32_t PCA9420_DVFS_SetPoint(pca9420_dvfs_t *pDvfs, uint8_t index);
+
+/*! @brief       The interface function to run at the lowest point that carries a load.
+ *  @param[in]   pDvfs          engine context.
+ *  @param[in]   requiredHz     core clock the load needs.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_DVFS_SelectForLoad() returns the status, the highest point is taken when none is fast enough.
+ */
+int32_t PCA9420_DVFS_SelectForLoad(pca9420_dvfs_t *pDvfs, uint32_t requiredHz);
+
+#endif /* PCA9420UK_DVFS_H_ */
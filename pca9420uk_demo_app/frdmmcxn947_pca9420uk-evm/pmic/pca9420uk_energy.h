@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_energy.h
+ * @brief The pca9420uk_energy.h file describes the PCA9420UK energy accounting model.
+
+    The model keeps the time spent in each PMIC mode and MCU power state, and the output
+    energy of every rail per PMIC mode. A rail delivers its set voltage times a load current
+    taken from a per rail, per MCU state table, or nothing when it is disabled in the mode.
+
+    Accounting is incremental: each transition closes the running segment with one multiply
+    per rail and starts the next, so mode and power state changes cost constant time. The
+    rail voltages and enables come from the MODECFG registers and are followed through the
+    event log listener, see pca9420uk_evlog.h, whenever the driver writes a mode, a voltage or
+    an enable. Bulk writes of MODECFG, a profile apply, a brown-out shed or restore or a
+    low-power exit, do not reach the event log: PCA9420_ENERGY_NoteWrite(), called from the
+    driver write listener, closes the segment at the write and asks for
+    PCA9420_ENERGY_Refresh(). Time is counted in software timer ticks, sleep included.
+*/
+
+#ifndef PCA9420UK_ENERGY_H_
+#define PCA9420UK_ENERGY_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_config.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief PMIC modes. */
+#define PCA9420_ENERGY_MODES (4u)
+
+/*! @brief Rails in MODECFG order: SW1, SW2, LDO1, LDO2. */
+#define PCA9420_ENERGY_RAILS (4u)
+
+/*! @brief MCU power states, numbered by the application. */
+#ifndef PCA9420_ENERGY_MCU_STATES
+#define PCA9420_ENERGY_MCU_STATES (4u)
+#endif
+
+/*!
+ * @brief Load model.
+ */
+typedef struct
+{
+	uint32_t loadUa[PCA9420_ENERGY_RAILS][PCA9420_ENERGY_MCU_STATES]; /*!< Load current per rail and MCU state, uA. */
+} pca9420_energy_model_t;
+
+/*!
+ * @brief Accounting context.
+ */
+typedef struct
+{
+	pca9420_energy_model_t model;                                  /*!< Load model in use. */
+	uint16_t railMv[PCA9420_ENERGY_MODES][PCA9420_ENERGY_RAILS];   /*!< Set voltage per mode and rail. */
+	uint8_t railOn[PCA9420_ENERGY_MODES];                          /*!< Enabled rails per mode, bit per rail. */
+	uint8_t mode;                                                  /*!< PMIC mode in force. */
+	uint8_t mcuState;                                              /*!< MCU power state in force. */
+	uint32_t since;                                                /*!< Tick the running segment started. */
+	uint32_t transitions;                                          /*!< Segments closed. */
+	uint32_t residency[PCA9420_ENERGY_MODES][PCA9420_ENERGY_MCU_STATES]; /*!< Ticks per mode and MCU state. */
+	uint64_t energy[PCA9420_ENERGY_MODES][PCA9420_ENERGY_RAILS];   /*!< mV * uA * ticks per mode and rail. */
+} pca9420_energy_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start energy accounting.
+ *  @details     This function clears the counters and takes the event log listener. The rails count as
+ *               off until PCA9420_ENERGY_Refresh() or PCA9420_ENERGY_SetRails().
+ *  @param[out]  pEnergy        accounting context.
+ *  @param[in]   pModel         load model, copied.
+ *  @param[in]   mcuState       MCU power state now.
+ *  @constraints SW_TIMER_Init() and PCA9420_EVLOG_Init() must have been called.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_ENERGY_Init() returns the status.
+ */
+int32_t PCA9420_ENERGY_Init(pca9420_energy_t *pEnergy, const pca9420_energy_model_t *pModel, uint8_t mcuState);
+
+/*! @brief       The interface function to take the rails and the mode from the PMIC.
+ *  @details     This function reads MODECFG and TOP_CNTL in one burst each.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_ENERGY_Refresh() returns the status.
+ */
+int32_t PCA9420_ENERGY_Refresh(pca9420_energy_t *pEnergy, pca9420_i2c_sensorhandle_t *pSensorHandle);
+
+/*! @brief       The interface function to take the rails and the mode from a register image.
+ *  @details     The MODECFG region gives the rails, the TOP region the mode, regions not held are ignored.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   pConfig        register image, for example the cache of a low-power sequence.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_ENERGY_SetRails(pca9420_energy_t *pEnergy, const pca9420_config_t *pConfig);
+
+/*! @brief       The interface function to account a register write of the driver.
+ *  @details     This function closes the running segment when the write holds TOP_CNTL3 or a MODECFG
+ *               register, so the time up to the write counts at the rails it replaced. No bus access.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   address        first register written.
+ *  @param[in]   length         registers written.
+ *  @constraints Thread context only, typically the pca9420_write_listener_t of the driver.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_ENERGY_NoteWrite() returns true when the model needs PCA9420_ENERGY_Refresh().
+ */
+bool PCA9420_ENERGY_NoteWrite(pca9420_energy_t *pEnergy, uint8_t address, uint8_t length);
+
+/*! @brief       The interface function to account a PMIC mode change.
+ *  @details     Mode writes through the driver and pca9420uk_config.h arrive through the event log.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   mode           new mode.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_ENERGY_SetMode(pca9420_energy_t *pEnergy, uint8_t mode);
+
+/*! @brief       The interface function to account an MCU power state change.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   mcuState       new state, 0..PCA9420_ENERGY_MCU_STATES - 1.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_ENERGY_SetMcuState(pca9420_energy_t *pEnergy, uint8_t mcuState);
+
+/*! @brief       The interface function to change the load model of one rail.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   rail           rail, 0..PCA9420_ENERGY_RAILS - 1.
+ *  @param[in]   mcuState       MCU power state the load applies to.
+ *  @param[in]   loadUa         load current, uA.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_ENERGY_SetLoad() returns the status.
+ */
+int32_t PCA9420_ENERGY_SetLoad(pca9420_energy_t *pEnergy, uint8_t rail, uint8_t mcuState, uint32_t loadUa);
+
+/*! @brief       The interface function to bring the counters up to now.
+ *  @details     This function closes the running segment, call it before reading the counters.
+ *  @param[in]   pEnergy        accounting context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_ENERGY_Update(pca9420_energy_t *pEnergy);
+
+/*! @brief       The interface function to read the energy of a rail in a mode.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   mode           PMIC mode.
+ *  @param[in]   rail           rail.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_ENERGY_GetUj() returns the energy in microjoules up to the last update.
+ */
+uint32_t PCA9420_ENERGY_GetUj(const pca9420_energy_t *pEnergy, uint8_t mode, uint8_t rail);
+
+/*! @brief       The interface function to read the residency in a mode and MCU power state.
+ *  @param[in]   pEnergy        accounting context.
+ *  @param[in]   mode           PMIC mode.
+ *  @param[in]   mcuState       MCU power state.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_ENERGY_GetResidencyMs() returns the time in milliseconds up to the last update.
+ */
+uint32_t PCA9420_ENERGY_GetResidencyMs(const pca9420_energy_t *pEnergy, uint8_t mode, uint8_t mcuState);
+
+/*! @brief       The interface function to clear the counters.
+ *  @param[in]   pEnergy        accounting context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_ENERGY_Reset(pca9420_energy_t *pEnergy);
+
+#endif /* PCA9420UK_ENERGY_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_ilim.h
+ * @brief The pca9420uk_ilim.h file describes the PCA9420UK VIN input current limit manager.
+
+    The manager runs the VIN current limit at 425 mA and falls back to 85 mA when the adapter
+    cannot hold it: on an input current limit interrupt with the VIN status of CHG_STATUS1 no
+    longer valid, ASYS having dropped under VBAT plus the headroom, or on an ASYS pre-warning.
+    After backoffMs at 85 mA it tries 425 mA again. A try that falls back within stableMs
+    doubles the wait up to maxBackoffMs, one that holds resets it. A new adapter, seen as a
+    VIN_OK change to valid, starts at 425 mA with the first wait, so each adapter finds its
+    own sustainable limit.
+
+    The PMIC flags the start of current limiting but not its end. The charger counts as in
+    limit from an input current limit interrupt until clearMs pass without another one, the
+    time is kept per limit setting. Everything runs from the interrupt dispatcher, see
+    pca9420uk_irq.h, and two one-shot software timers. Each limit change is recorded in the
+    event log.
+*/
+
+#ifndef PCA9420UK_ILIM_H_
+#define PCA9420UK_ILIM_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_irq.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Limit settings, indexed by enum _pca9420_vin_ilim. */
+#define PCA9420_ILIM_SETTINGS (2u)
+
+/*! @brief Reasons of the kPCA9420_EvlogInputLimit records. */
+enum _pca9420_ilim_reason
+{
+	kPCA9420_IlimStart    = 0u, /*!< Start of the manager. */
+	kPCA9420_IlimSag      = 1u, /*!< Fall back, VIN not valid while in limit. */
+	kPCA9420_IlimAsysWarn = 2u, /*!< Fall back on an ASYS pre-warning. */
+	kPCA9420_IlimRetry    = 3u, /*!< Try the high limit again after the wait. */
+	kPCA9420_IlimAdapter  = 4u, /*!< New adapter. */
+};
+
+/*!
+ * @brief Manager configuration.
+ */
+typedef struct
+{
+	uint16_t clearMs;      /*!< Time without an input current limit interrupt that ends a limit interval. */
+	uint16_t stableMs;     /*!< Time at the high limit after which a try counts as sustainable. */
+	uint32_t backoffMs;    /*!< First wait at the low limit. */
+	uint32_t maxBackoffMs; /*!< Longest wait. */
+} pca9420_ilim_config_t;
+
+/*!
+ * @brief Manager context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;   /*!< PMIC handle. */
+	pca9420_ilim_config_t config;                /*!< Configuration in use. */
+	sw_timer_t clearTimer;                       /*!< Ends a limit interval. */
+	sw_timer_t retryTimer;                       /*!< Ends the wait at the low limit. */
+	uint8_t setting;                             /*!< enum _pca9420_vin_ilim in force. */
+	uint8_t vinStatus;                           /*!< VIN status of CHG_STATUS1 last read. */
+	bool inLimit;                                /*!< The charger is in current limit. */
+	uint32_t limitStart;                         /*!< Tick the running limit interval started. */
+	uint32_t highSince;                          /*!< Tick the high limit was last set. */
+	uint32_t waitMs;                             /*!< Next wait at the low limit. */
+	uint32_t limitTicks[PCA9420_ILIM_SETTINGS];  /*!< Time in limit per setting up to the last interval. */
+	uint32_t limitEvents;                        /*!< Limit intervals started. */
+	uint32_t fallbacks;                          /*!< Changes to the low limit. */
+	uint32_t retries;                            /*!< Tries of the high limit. */
+	uint32_t busErrors;                          /*!< Reads or writes that failed. */
+} pca9420_ilim_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start the manager.
+ *  @details     This function sets the high limit and registers with the dispatcher for the VIN_OK, ASYS
+ *               pre-warning and input current limit interrupts.
+ *  @param[out]  pIlim          manager context.
+ *  @param[in]   pIrq           interrupt dispatcher.
+ *  @param[in]   pConfig        configuration, copied.
+ *  @constraints SW_TIMER_Init() and PCA9420_IRQ_Init() must have been called. Not on PCA9421. Nothing else may
+ *               write VIN_ILIM_SEL while the manager runs.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_ILIM_Init() returns the status, SENSOR_ERROR_INVALID_PARAM when a time is zero or
+ *               backoffMs is above maxBackoffMs.
+ */
+int32_t PCA9420_ILIM_Init(pca9420_ilim_t *pIlim, pca9420_irq_t *pIrq, const pca9420_ilim_config_t *pConfig);
+
+/*! @brief       The interface function to read the time spent in current limit.
+ *  @param[in]   pIlim          manager context.
+ *  @param[in]   setting        enum _pca9420_vin_ilim.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_ILIM_GetLimitMs() returns the time in milliseconds, the running interval included.
+ */
+uint32_t PCA9420_ILIM_GetLimitMs(const pca9420_ilim_t *pIlim, uint8_t setting);
+
+/*! @brief       The interface function to read the limit in force.
+ *  @param[in]   pIlim          manager context.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_ILIM_GetMa() returns the typical limit in mA.
+ */
+uint32_t PCA9420_ILIM_GetMa(const pca9420_ilim_t *pIlim);
+
+#endif /* PCA9420UK_ILIM_H_ */
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_irq.h
+ * @brief The pca9420uk_irq.h file describes the PCA9420UK interrupt dispatcher.
+
+    The PMIC latches its interrupt flags in SUB_INT0..SUB_INT2 until they are written back
+    with ones and keeps the INT pin low meanwhile, so the falling edge of the next event only
+    comes once every flag is cleared. The dispatcher reads the top level and sub-block flags in
+    one burst, clears exactly the flags it read in a second one, and hands them to the
+    handlers registered for them. A flag raised between the two bursts stays set and pulls the
+    pin low again. Every service is recorded in the event log before the handlers run.
+
+    Sources use the layout of enum _pca9420_interrupt_source: SUB_INT0 in bits 0..7, SUB_INT1
+    in bits 8..15 and SUB_INT2 in bits 16..23. Since the flags are gone from the PMIC once
+    serviced, the dispatcher also latches the sources of every service until the application
+    takes them with PCA9420_IRQ_TakeLatched().
+*/
+
+#ifndef PCA9420UK_IRQ_H_
+#define PCA9420UK_IRQ_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Handlers the dispatcher holds. */
+#ifndef PCA9420_IRQ_MAX_HANDLERS
+#define PCA9420_IRQ_MAX_HANDLERS (6u)
+#endif
+
+/*! @brief Called with the sources of one service that match the registration. */
+typedef void (*pca9420_irq_handler_t)(uint32_t sources, void *pUserData);
+
+/*!
+ * @brief Handler registration.
+ */
+typedef struct
+{
+	uint32_t sources;              /*!< enum _pca9420_interrupt_source bits the handler wants. */
+	pca9420_irq_handler_t handler; /*!< Handler. */
+	void *pUserData;               /*!< Argument of handler. */
+} pca9420_irq_entry_t;
+
+/*!
+ * @brief Dispatcher context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;             /*!< PMIC handle. */
+	pca9420_irq_entry_t entries[PCA9420_IRQ_MAX_HANDLERS]; /*!< Handlers in registration order. */
+	uint8_t count;                                         /*!< Handlers registered. */
+	uint8_t topInt;                                        /*!< TOP_INT of the last service. */
+	uint32_t lastSources;                                  /*!< Sources of the last service. */
+	uint8_t latchedTopInt;                                 /*!< TOP_INT bits of the services since the last take. */
+	uint32_t latched;                                      /*!< Sources of the services since the last take. */
+	uint32_t services;                                     /*!< Services that found a flag set. */
+	uint32_t busErrors;                                    /*!< Services that failed on the bus. */
+} pca9420_irq_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to set up the dispatcher.
+ *  @details     This function clears the handlers, nothing is read or written.
+ *  @param[out]  pIrq           dispatcher context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @constraints None.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_IRQ_Init() returns the status.
+ */
+int32_t PCA9420_IRQ_Init(pca9420_irq_t *pIrq, pca9420_i2c_sensorhandle_t *pSensorHandle);
+
+/*! @brief       The interface function to register a handler.
+ *  @details     Handlers are called in registration order.
+ *  @param[in]   pIrq           dispatcher context.
+ *  @param[in]   sources        enum _pca9420_interrupt_source bits the handler wants.
+ *  @param[in]   handler        handler.
+ *  @param[in]   pUserData      argument of handler.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_IRQ_Register() returns SENSOR_ERROR_INVALID_PARAM when all PCA9420_IRQ_MAX_HANDLERS
+ *               entries are taken.
+ */
+int32_t PCA9420_IRQ_Register(pca9420_irq_t *pIrq, uint32_t sources, pca9420_irq_handler_t handler, void *pUserData);
+
+/*! @brief       The interface function to service the INT pin.
+ *  @details     This function reads TOP_INT..SUB_INT2 in one burst, clears the flags found set in one write
+ *               and calls the handlers whose sources match. Nothing is written when no flag is set.
+ *  @param[in]   pIrq           dispatcher context.
+ *  @param[out]  pSources       sources found set, may be NULL.
+ *  @constraints Thread context only, typically from the event posted by the INT pin interrupt.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_IRQ_Service() returns the status, handlers are not called on a bus error.
+ */
+int32_t PCA9420_IRQ_Service(pca9420_irq_t *pIrq, uint32_t *pSources);
+
+/*! @brief       The interface function to take the latched interrupt sources.
+ *  @details     This function returns the sources every service found since the previous call and clears
+ *               them, for a status display that runs after the flags were cleared in the PMIC.
+ *  @param[in]   pIrq           dispatcher context.
+ *  @param[out]  pTopInt        TOP_INT bits of those services, may be NULL.
+ *  @constraints Thread context only, as PCA9420_IRQ_Service().
+ *  @reeentrant  No
+ *  @return      ::PCA9420_IRQ_TakeLatched() returns the sources, 0 when no flag was serviced.
+ */
+uint32_t PCA9420_IRQ_TakeLatched(pca9420_irq_t *pIrq, uint8_t *pTopInt);
+
+#endif /* PCA9420UK_IRQ_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_jeita.h
+ * @brief The pca9420uk_jeita.h file describes the PCA9420UK temperature zoned charging profile engine.
+
+    A profile holds the charger settings of each battery temperature zone reported in the
+    TS_STATUS field of CHG_STATUS3: whether to charge, the constant current, the top-off
+    current, the regulation voltage and the recharge threshold. Whenever the zone changes the
+    engine programs the settings of the new zone as one reconcile of the CHARGER region, see
+    pca9420uk_config.h: one read of CHG_CNTL0..7 and at most one burst write from CHG_CNTL0,
+    which carries the unlock key.
+
+    The zone is read on every charger interrupt through the interrupt dispatcher, see
+    pca9420uk_irq.h. The PMIC has no interrupt for zone crossings, so while the charger is in
+    a charging phase a software timer also reads it every PCA9420_JEITA_POLL_MS. With a
+    thermal governor attached, see
+    pca9420uk_thermal.h, the constant current of the zone becomes the governor limit and the
+    code the governor allows goes out in the same write. The time spent in each zone is kept.
+*/
+
+#ifndef PCA9420UK_JEITA_H_
+#define PCA9420UK_JEITA_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_irq.h"
+#include "pca9420uk_thermal.h"
+#include "pca9420uk_config.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Temperature zones, indexed by enum _pca9420_ts_status. */
+#define PCA9420_JEITA_ZONES (5u)
+
+/*! @brief Zone before the first read. */
+#define PCA9420_JEITA_ZONE_UNKNOWN (0xFFu)
+
+/*! @brief Zone poll interval while charging. */
+#ifndef PCA9420_JEITA_POLL_MS
+#define PCA9420_JEITA_POLL_MS (5000u)
+#endif
+
+/*!
+ * @brief Charger settings of one zone.
+ */
+typedef struct
+{
+	uint8_t charge;     /*!< 1 to charge, 0 to keep the charger disabled. */
+	uint8_t ichgCode;   /*!< Constant current, enum _pca9420_bat_chrg_cur. */
+	uint8_t topoffCode; /*!< Top-off current, enum _pca9420_bat_topoff_cur. */
+	uint8_t vbatReg;    /*!< Regulation voltage, enum _pca9420_bat_reg_vol. */
+	uint8_t recharge;   /*!< Recharge threshold, enum _pca9420_threshld_rechrg. */
+} pca9420_jeita_zone_t;
+
+/*!
+ * @brief Charging profile.
+ */
+typedef struct
+{
+	pca9420_jeita_zone_t zones[PCA9420_JEITA_ZONES]; /*!< Settings by enum _pca9420_ts_status. */
+} pca9420_jeita_profile_t;
+
+/*!
+ * @brief Engine context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle;  /*!< PMIC handle. */
+	pca9420_jeita_profile_t profile;            /*!< Profile in use. */
+	pca9420_thermal_t *pThermal;                /*!< Thermal governor, may be NULL. */
+	sw_timer_t timer;                           /*!< Zone poll while charging. */
+	uint8_t zone;                               /*!< Zone whose settings are in force. */
+	uint32_t since;                             /*!< Tick the zone was entered. */
+	uint32_t zoneTicks[PCA9420_JEITA_ZONES];    /*!< Time in each zone up to the last change. */
+	uint32_t changes;                           /*!< Zone changes applied. */
+	uint32_t busErrors;                         /*!< Reads or writes that failed. */
+	pca9420_cfg_result_t last;                  /*!< Bus traffic of the last apply. */
+} pca9420_jeita_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to start the engine.
+ *  @details     This function reads the zone, programs its settings and registers with the dispatcher for
+ *               the charger interrupts.
+ *  @param[out]  pJeita         engine context.
+ *  @param[in]   pIrq           interrupt dispatcher.
+ *  @param[in]   pProfile       profile, copied.
+ *  @param[in]   pThermal       thermal governor, already started, may be NULL.
+ *  @constraints SW_TIMER_Init() and PCA9420_IRQ_Init() must have been called. Not on PCA9421.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_JEITA_Init() returns the status, SENSOR_ERROR_INVALID_PARAM for a setting out of range.
+ */
+int32_t PCA9420_JEITA_Init(pca9420_jeita_t *pJeita, pca9420_irq_t *pIrq, const pca9420_jeita_profile_t *pProfile,
+                           pca9420_thermal_t *pThermal);
+
+/*! @brief       The interface function to follow the zone.
+ *  @details     This function reads CHG_STATUS2..3 and programs the settings of the zone when it changed, the
+ *               dispatcher calls it on every charger interrupt and the poll timer while charging. The
+ *               charger phase read starts and stops the poll timer.
+ *  @param[in]   pJeita         engine context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_JEITA_Update() returns the status.
+ */
+int32_t PCA9420_JEITA_Update(pca9420_jeita_t *pJeita);
+
+/*! @brief       The interface function to read the time spent in a zone.
+ *  @param[in]   pJeita         engine context.
+ *  @param[in]   zone           enum _pca9420_ts_status.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_JEITA_GetZoneMs() returns the time in milliseconds, the running zone included.
+ */
+uint32_t PCA9420_JEITA_GetZoneMs(const pca9420_jeita_t *pJeita, uint8_t zone);
+
+#endif /* PCA9420UK_JEITA_H_ */
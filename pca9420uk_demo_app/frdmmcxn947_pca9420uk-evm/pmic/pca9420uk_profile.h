@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_profile.h
+ * @brief The pca9420uk_profile.h file describes the PCA9420UK named power profile store.
+
+    A profile is a named PMIC configuration, see pca9420uk_config.h, kept in the NVM store
+    so that a whole board setup (for example "bench", "ship" or "field") is saved once and
+    brought back with a single apply. The store is the top sectors of the program flash, so
+    profiles, the "boot" profile included, survive a power cycle; built with the retained RAM
+    backend of nvm_store.h they only survive MCU resets. PCA9420_PROFILE_IsPersistent()
+    reports which.
+
+    The store is a table of PCA9420_PROFILE_SLOTS slots in one NVM sector. Each slot holds a
+    format version and a CRC of its own, a slot that fails either is treated as empty. A
+    change writes the complete table to the other sector under a higher generation number,
+    slots first and the table header last, so a reset in the middle leaves the previous
+    table in force.
+*/
+
+#ifndef PCA9420UK_PROFILE_H_
+#define PCA9420UK_PROFILE_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_config.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of profiles. */
+#ifndef PCA9420_PROFILE_SLOTS
+#define PCA9420_PROFILE_SLOTS (6u)
+#endif
+
+/*! @brief Longest profile name. */
+#define PCA9420_PROFILE_NAME_LEN (15u)
+
+/*! @brief Format version of a slot, raised whenever pca9420_profile_t or the register image changes. */
+#define PCA9420_PROFILE_VERSION (1u)
+
+/*!
+ * @brief One stored profile.
+ */
+typedef struct
+{
+	uint16_t version;                           /*!< PCA9420_PROFILE_VERSION. */
+	uint16_t length;                            /*!< sizeof(pca9420_profile_t). */
+	char name[PCA9420_PROFILE_NAME_LEN + 1u];   /*!< NUL terminated name. */
+	pca9420_config_t config;                    /*!< Register image. */
+	uint16_t crc;                               /*!< CRC16 of the fields above. */
+} pca9420_profile_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to open the profile store.
+ *  @details     This function picks the newest valid table, an empty store is valid.
+ *  @constraints Call once before the other functions, NVM_Init() is done here.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Init() returns the status.
+ */
+int32_t PCA9420_PROFILE_Init(void);
+
+/*! @brief       The interface function to find a profile.
+ *  @param[in]   pName          profile name.
+ *  @param[out]  pConfig        the stored configuration.
+ *  @constraints None.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Load() returns SENSOR_ERROR_NONE, or SENSOR_ERROR_INVALID_PARAM when there is no such profile.
+ */
+int32_t PCA9420_PROFILE_Load(const char *pName, pca9420_config_t *pConfig);
+
+/*! @brief       The interface function to store a configuration under a name.
+ *  @details     An existing profile of the same name is replaced.
+ *  @param[in]   pName          profile name, 1..PCA9420_PROFILE_NAME_LEN characters.
+ *  @param[in]   pConfig        configuration to store.
+ *  @constraints Thread context only, erasing the sector blocks for a few milliseconds.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Store() returns the status, SENSOR_ERROR_WRITE when the store is full or not writable.
+ */
+int32_t PCA9420_PROFILE_Store(const char *pName, const pca9420_config_t *pConfig);
+
+/*! @brief       The interface function to remove a profile.
+ *  @param[in]   pName          profile name.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Delete() returns the status.
+ */
+int32_t PCA9420_PROFILE_Delete(const char *pName);
+
+/*! @brief       The interface function to save the live PMIC configuration.
+ *  @details     This function captures every region with burst reads and stores it under the name.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pName          profile name.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Save() returns the status.
+ */
+int32_t PCA9420_PROFILE_Save(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName);
+
+/*! @brief       The interface function to program a stored profile into the PMIC.
+ *  @details     This function writes only the registers that differ, see PCA9420_CFG_Reconcile().
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pName          profile name.
+ *  @param[out]  pResult        what was written, may be NULL.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Apply() returns the status.
+ */
+int32_t PCA9420_PROFILE_Apply(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName, pca9420_cfg_result_t *pResult);
+
+/*! @brief       The interface function to compare a stored profile with the live PMIC.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pName          profile name.
+ *  @param[in]   visit          function called per differing register, may be NULL.
+ *  @param[in]   pUserData      argument of visit.
+ *  @param[out]  pCount         number of differing registers.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_Diff() returns the status.
+ */
+int32_t PCA9420_PROFILE_Diff(pca9420_i2c_sensorhandle_t *pSensorHandle, const char *pName, pca9420_cfg_diff_visit_t visit,
+                             void *pUserData, uint32_t *pCount);
+
+/*! @brief       The interface function to list the stored profiles.
+ *  @param[in]   slot           slot index, 0..PCA9420_PROFILE_SLOTS - 1.
+ *  @constraints None.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_PROFILE_GetName() returns the name in the slot, NULL when the slot is empty.
+ */
+const char *PCA9420_PROFILE_GetName(uint32_t slot);
+
+/*! @brief       The interface function to tell whether profiles survive a power cycle.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_PROFILE_IsPersistent() returns false when the store runs on retained RAM.
+ */
+bool PCA9420_PROFILE_IsPersistent(void);
+
+#endif /* PCA9420UK_PROFILE_H_ */
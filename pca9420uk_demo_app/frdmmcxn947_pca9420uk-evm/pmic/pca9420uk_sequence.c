@@ -0,0 +1,326 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_sequence.c
+ * @brief The pca9420uk_sequence.c file implements the PCA9420UK rail sequencing engine.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "pca9420uk_sequence.h"
+#include "pca9420uk.h"
+#include "pca9420uk_evlog.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Registers per mode bank. */
+#define PCA9420_SEQ_MODECFG_LEN (4u)
+
+/* Rails of enum _pca9420_vol_reg_source, the voltage sits in MODECFG_x_<index>. */
+#define PCA9420_SEQ_RAILS (4u)
+
+typedef struct
+{
+	pca9420_regulator_t regulator; /* Regulator of the voltage code. */
+	uint8_t voltMask;              /* Voltage field in MODECFG_x_<rail>. */
+	uint8_t voltShift;
+	uint8_t enMask;                /* Enable bit in MODECFG_x_2. */
+} pca9420_seq_rail_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const pca9420_seq_rail_t s_rails[PCA9420_SEQ_RAILS] = {
+	{kPCA9420_RegulatorSwitch1, PCA9420_MODECFG_0_SW1_OUT_MASK, 0u, PCA9420_SW1_EN_MASK},
+	{kPCA9420_RegulatorSwitch2, PCA9420_MODECFG_1_SW2_OUT_MASK, 0u, PCA9420_SW2_EN_MASK},
+	{kPCA9420_RegulatorLdo1, PCA9420_MODECFG_2_LDO1_OUT_MASK, PCA9420_MODECFG_2_LDO1_OUT_SHIFT, PCA9420_LDO1_EN_MASK},
+	{kPCA9420_RegulatorLdo2, PCA9420_MODECFG_3_LDO2_OUT_MASK, 0u, PCA9420_LDO2_EN_MASK},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t PCA9420_SEQ_ElapsedMs(const pca9420_seq_t *pSeq)
+{
+	return (uint32_t)((uint64_t)(SW_TIMER_GetTicks() - pSeq->startTick) * 1000u / SW_TIMER_TICK_HZ);
+}
+
+static bool PCA9420_SEQ_IsRailStep(const pca9420_seq_step_t *pStep)
+{
+	return (pStep->op == kPCA9420_SeqRailOn) || (pStep->op == kPCA9420_SeqRailOff) || (pStep->op == kPCA9420_SeqVoltage);
+}
+
+static int32_t PCA9420_SEQ_CheckStep(const pca9420_seq_step_t *pStep)
+{
+	uint8_t code;
+
+	switch (pStep->op)
+	{
+	case kPCA9420_SeqRailOn:
+	case kPCA9420_SeqRailOff:
+	case kPCA9420_SeqVoltage:
+		if ((pStep->mode > kPCA9420_Mode3) || (pStep->rail < kPCA9420_SW1) || (pStep->rail > kPCA9420_LDO2))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		if (pStep->op == kPCA9420_SeqVoltage)
+		{
+			return PCA9420_Encode_regulator_mv(s_rails[pStep->rail - kPCA9420_SW1].regulator, pStep->value, &code);
+		}
+		return SENSOR_ERROR_NONE;
+	case kPCA9420_SeqDelay:
+		return SENSOR_ERROR_NONE;
+	case kPCA9420_SeqWaitGood:
+		if ((pStep->value == 0u) || ((pStep->value & ~(uint16_t)(kPCA9420_RegStatusVoutSw1OK | kPCA9420_RegStatusVoutSw2OK |
+		                                                         kPCA9420_RegStatusVoutLdo1OK | kPCA9420_RegStatusVoutLdo2OK)) != 0u))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		return SENSOR_ERROR_NONE;
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+}
+
+/* Writes the rail steps first..last in one reconcile of MODECFG. */
+static int32_t PCA9420_SEQ_RunRails(pca9420_seq_t *pSeq, uint32_t first, uint32_t last)
+{
+	const pca9420_seq_step_t *pStep;
+	const pca9420_seq_rail_t *pRail;
+	pca9420_config_t target;
+	pca9420_cfg_result_t result;
+	uint8_t care[PCA9420_CFG_REG_COUNT];
+	uint8_t bank, address, code, bits;
+	uint32_t i;
+	int32_t status;
+
+	memset(&target, 0, sizeof(target));
+	memset(care, 0, sizeof(care));
+	target.regions = PCA9420_CFG_REGION_MODECFG;
+	for (i = first; i <= last; i++)
+	{
+		pStep = &pSeq->pSteps[i];
+		pRail = &s_rails[pStep->rail - kPCA9420_SW1];
+		bank = (uint8_t)(PCA9420UK_MODECFG_0_0 + pStep->mode * PCA9420_SEQ_MODECFG_LEN);
+		if (pStep->op == kPCA9420_SeqVoltage)
+		{
+			(void)PCA9420_Encode_regulator_mv(pRail->regulator, pStep->value, &code);
+			address = (uint8_t)(bank + (pStep->rail - kPCA9420_SW1));
+			care[address] |= pRail->voltMask;
+			bits = (uint8_t)((code << pRail->voltShift) & pRail->voltMask);
+			target.regs[address] = (uint8_t)((target.regs[address] & ~pRail->voltMask) | bits);
+		}
+		else
+		{
+			address = (uint8_t)(bank + 2u);
+			care[address] |= pRail->enMask;
+			bits = (pStep->op == kPCA9420_SeqRailOn) ? pRail->enMask : 0u;
+			target.regs[address] = (uint8_t)((target.regs[address] & ~pRail->enMask) | bits);
+		}
+	}
+
+	memset(&result, 0, sizeof(result));
+	status = PCA9420_CFG_Reconcile(pSeq->pSensorHandle, &target, care, &pSeq->live, &result);
+	pSeq->reads += result.reads;
+	pSeq->writes += result.writes;
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	for (i = first; i <= last; i++)
+	{
+		pStep = &pSeq->pSteps[i];
+		if (pStep->op == kPCA9420_SeqVoltage)
+		{
+			PCA9420_EVLOG_Record(kPCA9420_EvlogVoltage,
+			                     (uint8_t)((s_rails[pStep->rail - kPCA9420_SW1].regulator << 4) | pStep->mode), pStep->value);
+		}
+		else
+		{
+			PCA9420_EVLOG_Record(kPCA9420_EvlogRailEnable, (uint8_t)((pStep->rail << 4) | pStep->mode),
+			                     (pStep->op == kPCA9420_SeqRailOn) ? 1u : 0u);
+		}
+		pSeq->stepMs[i] = PCA9420_SEQ_ElapsedMs(pSeq);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+static void PCA9420_SEQ_Finish(pca9420_seq_t *pSeq, int32_t status)
+{
+	SW_TIMER_Stop(&pSeq->timer);
+	pSeq->busy = false;
+	pSeq->waiting = false;
+	pSeq->status = status;
+	pSeq->totalMs = PCA9420_SEQ_ElapsedMs(pSeq);
+	if (pSeq->done != NULL)
+	{
+		pSeq->done(pSeq->current, status, pSeq->next, pSeq->pUserData);
+	}
+}
+
+/* Runs steps until a wait is pending or the sequence ends. */
+static void PCA9420_SEQ_Run(pca9420_seq_t *pSeq)
+{
+	const pca9420_seq_step_t *pStep;
+	uint32_t last, now;
+	uint8_t regStatus;
+	int32_t status;
+
+	while (pSeq->next < pSeq->count)
+	{
+		pStep = &pSeq->pSteps[pSeq->next];
+		switch (pStep->op)
+		{
+		case kPCA9420_SeqDelay:
+			if (!pSeq->waiting && (pStep->timeMs != 0u))
+			{
+				pSeq->waiting = true;
+				SW_TIMER_Start(&pSeq->timer, SW_TIMER_MS_TO_TICKS(pStep->timeMs), 0u);
+				return;
+			}
+			break;
+		case kPCA9420_SeqWaitGood:
+			status = PCA9420_DRV_BlockRead(pSeq->pSensorHandle, PCA9420UK_REG_STATUS, &regStatus, 1u);
+			pSeq->reads++;
+			if (SENSOR_ERROR_NONE != status)
+			{
+				PCA9420_SEQ_Finish(pSeq, status);
+				return;
+			}
+			if ((regStatus & pStep->value) != pStep->value)
+			{
+				now = SW_TIMER_GetTicks();
+				if (!pSeq->waiting)
+				{
+					pSeq->waiting = true;
+					pSeq->deadline = now + SW_TIMER_MS_TO_TICKS(pStep->timeMs);
+				}
+				if ((int32_t)(now - pSeq->deadline) >= 0)
+				{
+					PCA9420_SEQ_Finish(pSeq, SENSOR_ERROR_READ);
+					return;
+				}
+				SW_TIMER_Start(&pSeq->timer, SW_TIMER_MS_TO_TICKS(PCA9420_SEQ_POLL_MS), 0u);
+				return;
+			}
+			break;
+		default:
+			for (last = pSeq->next; (last + 1u < pSeq->count) && PCA9420_SEQ_IsRailStep(&pSeq->pSteps[last + 1u]); last++)
+			{
+			}
+			status = PCA9420_SEQ_RunRails(pSeq, pSeq->next, last);
+			if (SENSOR_ERROR_NONE != status)
+			{
+				PCA9420_SEQ_Finish(pSeq, status);
+				return;
+			}
+			pSeq->next = (uint8_t)last;
+			break;
+		}
+		pSeq->waiting = false;
+		pSeq->stepMs[pSeq->next] = PCA9420_SEQ_ElapsedMs(pSeq);
+		pSeq->next++;
+	}
+
+	PCA9420_SEQ_Finish(pSeq, SENSOR_ERROR_NONE);
+}
+
+static void PCA9420_SEQ_TimerCallback(void *pUserData)
+{
+	pca9420_seq_t *pSeq = (pca9420_seq_t *)pUserData;
+
+	if (pSeq->busy)
+	{
+		PCA9420_SEQ_Run(pSeq);
+	}
+}
+
+int32_t PCA9420_SEQ_Init(pca9420_seq_t *pSeq, pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_seq_table_t *pTables,
+                         uint8_t tableCount, pca9420_seq_done_t done, void *pUserData)
+{
+	uint32_t table, i;
+
+	if ((pSeq == NULL) || (pSensorHandle == NULL) || (pTables == NULL) || (tableCount == 0u))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	for (table = 0u; table < tableCount; table++)
+	{
+		if ((pTables[table].pSteps == NULL) || (pTables[table].count == 0u) || (pTables[table].count > PCA9420_SEQ_MAX_STEPS))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		for (i = 0u; i < pTables[table].count; i++)
+		{
+			if (SENSOR_ERROR_NONE != PCA9420_SEQ_CheckStep(&pTables[table].pSteps[i]))
+			{
+				return SENSOR_ERROR_INVALID_PARAM;
+			}
+		}
+	}
+
+	memset(pSeq, 0, sizeof(*pSeq));
+	pSeq->pSensorHandle = pSensorHandle;
+	pSeq->pTables = pTables;
+	pSeq->tableCount = tableCount;
+	pSeq->done = done;
+	pSeq->pUserData = pUserData;
+	SW_TIMER_Setup(&pSeq->timer, PCA9420_SEQ_TimerCallback, pSeq);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_SEQ_Start(pca9420_seq_t *pSeq, uint8_t sequence)
+{
+	if ((pSeq == NULL) || (sequence >= pSeq->tableCount))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (pSeq->busy)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	pSeq->current = sequence;
+	pSeq->pSteps = pSeq->pTables[sequence].pSteps;
+	pSeq->count = pSeq->pTables[sequence].count;
+	pSeq->next = 0u;
+	pSeq->waiting = false;
+	pSeq->reads = 0u;
+	pSeq->writes = 0u;
+	pSeq->totalMs = 0u;
+	memset(pSeq->stepMs, 0, sizeof(pSeq->stepMs));
+	/* Other writers may have changed MODECFG since the last sequence. */
+	pSeq->live.regions = 0u;
+	pSeq->startTick = SW_TIMER_GetTicks();
+	pSeq->busy = true;
+	PCA9420_SEQ_Run(pSeq);
+
+	return SENSOR_ERROR_NONE;
+}
+
+void PCA9420_SEQ_Abort(pca9420_seq_t *pSeq)
+{
+	if ((pSeq != NULL) && pSeq->busy)
+	{
+		SW_TIMER_Stop(&pSeq->timer);
+		pSeq->busy = false;
+		pSeq->waiting = false;
+		pSeq->totalMs = PCA9420_SEQ_ElapsedMs(pSeq);
+	}
+}
+
+bool PCA9420_SEQ_IsBusy(const pca9420_seq_t *pSeq)
+{
+	return (pSeq != NULL) && pSeq->busy;
+}
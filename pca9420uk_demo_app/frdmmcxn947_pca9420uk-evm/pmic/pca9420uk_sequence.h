@@ -0,0 +1,176 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_sequence.h
+ * @brief The pca9420uk_sequence.h file describes the PCA9420UK rail sequencing engine.
+
+    A rail sequence is a named const table of steps: enable or disable a rail, set its voltage, wait
+    a fixed time, or wait for power-good bits of REG_STATUS with a timeout. The executor walks
+    the table from the software timer, so waits do not block the caller and the sequence
+    completes through a callback.
+
+    Consecutive enable, disable and voltage steps go out as one reconcile of the MODECFG
+    region, see pca9420uk_config.h: the region is read once per sequence and only the
+    registers that change are written. A power-good wait polls right away and then once per
+    PCA9420_SEQ_POLL_MS, so a rail that is already good costs one read and no time. Each step
+    is timestamped from the start of the sequence.
+
+    Rail writes are recorded in the event log like the driver ones, so listeners such as the
+    energy model follow the sequence.
+*/
+
+#ifndef PCA9420UK_SEQUENCE_H_
+#define PCA9420UK_SEQUENCE_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ISSDK Includes */
+#include "pca9420uk_config.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Longest sequence. */
+#ifndef PCA9420_SEQ_MAX_STEPS
+#define PCA9420_SEQ_MAX_STEPS (12u)
+#endif
+
+/*! @brief Power-good poll period. */
+#ifndef PCA9420_SEQ_POLL_MS
+#define PCA9420_SEQ_POLL_MS (1u)
+#endif
+
+/*! @brief Step operations. */
+typedef enum
+{
+	kPCA9420_SeqRailOn    = 0u, /*!< Enable a rail in a mode. */
+	kPCA9420_SeqRailOff   = 1u, /*!< Disable a rail in a mode. */
+	kPCA9420_SeqVoltage   = 2u, /*!< Set the voltage of a rail in a mode. */
+	kPCA9420_SeqDelay     = 3u, /*!< Wait a fixed time. */
+	kPCA9420_SeqWaitGood  = 4u, /*!< Wait for REG_STATUS power-good bits. */
+} pca9420_seq_op_t;
+
+/*!
+ * @brief Sequence step.
+ */
+typedef struct
+{
+	pca9420_seq_op_t op; /*!< Operation. */
+	uint8_t mode;        /*!< enum _pca9420_mode of a rail step. */
+	uint8_t rail;        /*!< enum _pca9420_vol_reg_source of a rail step. */
+	uint16_t value;      /*!< Voltage in mV, or the kPCA9420_RegStatusVout bits to wait for. */
+	uint16_t timeMs;     /*!< Delay, or power-good timeout. */
+} pca9420_seq_step_t;
+
+/*! @brief Rail enable step initializer. */
+#define PCA9420_SEQ_ON(mode, rail) {kPCA9420_SeqRailOn, (mode), (rail), 0u, 0u}
+
+/*! @brief Rail disable step initializer. */
+#define PCA9420_SEQ_OFF(mode, rail) {kPCA9420_SeqRailOff, (mode), (rail), 0u, 0u}
+
+/*! @brief Rail voltage step initializer. */
+#define PCA9420_SEQ_VOLTAGE(mode, rail, milliVolt) {kPCA9420_SeqVoltage, (mode), (rail), (milliVolt), 0u}
+
+/*! @brief Delay step initializer. */
+#define PCA9420_SEQ_DELAY(ms) {kPCA9420_SeqDelay, 0u, 0u, 0u, (ms)}
+
+/*! @brief Power-good wait step initializer. */
+#define PCA9420_SEQ_WAIT_GOOD(mask, timeoutMs) {kPCA9420_SeqWaitGood, 0u, 0u, (mask), (timeoutMs)}
+
+/*!
+ * @brief Named sequence.
+ */
+typedef struct
+{
+	const char *name;                 /*!< Name for the console. */
+	const pca9420_seq_step_t *pSteps; /*!< Steps in order. */
+	uint8_t count;                    /*!< Number of steps, 1..PCA9420_SEQ_MAX_STEPS. */
+} pca9420_seq_table_t;
+
+/*! @brief Called once a sequence ends, failedStep is the step that failed, or the step count. */
+typedef void (*pca9420_seq_done_t)(uint8_t sequence, int32_t status, uint8_t failedStep, void *pUserData);
+
+/*!
+ * @brief Executor context.
+ */
+typedef struct
+{
+	pca9420_i2c_sensorhandle_t *pSensorHandle; /*!< PMIC handle. */
+	const pca9420_seq_table_t *pTables;        /*!< Sequences. */
+	uint8_t tableCount;                        /*!< Number of sequences. */
+	uint8_t current;                           /*!< Sequence running or last run. */
+	const pca9420_seq_step_t *pSteps;          /*!< Its steps. */
+	uint8_t count;                             /*!< Number of its steps. */
+	uint8_t next;                              /*!< Next step to run. */
+	bool busy;                                 /*!< A sequence is running. */
+	bool waiting;                              /*!< The wait of step next has started. */
+	sw_timer_t timer;                          /*!< Delay and poll timer. */
+	uint32_t startTick;                        /*!< Tick the sequence started. */
+	uint32_t deadline;                         /*!< Tick the power-good wait times out. */
+	pca9420_config_t live;                     /*!< MODECFG cache, read once per sequence. */
+	pca9420_seq_done_t done;                   /*!< Completion callback, may be NULL. */
+	void *pUserData;                           /*!< Argument of done. */
+	int32_t status;                            /*!< Status of the last sequence. */
+	uint16_t reads;                            /*!< Bus reads of the last sequence, polls included. */
+	uint16_t writes;                           /*!< Bus writes of the last sequence. */
+	uint32_t totalMs;                          /*!< Duration of the last sequence. */
+	uint32_t stepMs[PCA9420_SEQ_MAX_STEPS];    /*!< Time from the start to the end of each step. */
+} pca9420_seq_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       The interface function to set up the executor.
+ *  @details     This function checks the steps of every sequence, nothing is written.
+ *  @param[out]  pSeq           executor context.
+ *  @param[in]   pSensorHandle  handle to the PMIC.
+ *  @param[in]   pTables        sequences.
+ *  @param[in]   tableCount     number of sequences.
+ *  @param[in]   done           completion callback, may be NULL.
+ *  @param[in]   pUserData      argument of done.
+ *  @constraints SW_TIMER_Init() must have been called.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_SEQ_Init() returns the status, SENSOR_ERROR_INVALID_PARAM for a bad step such as
+ *               a voltage the rail cannot take.
+ */
+int32_t PCA9420_SEQ_Init(pca9420_seq_t *pSeq, pca9420_i2c_sensorhandle_t *pSensorHandle, const pca9420_seq_table_t *pTables,
+                         uint8_t tableCount, pca9420_seq_done_t done, void *pUserData);
+
+/*! @brief       The interface function to start a sequence.
+ *  @details     This function runs the steps up to the first wait that is not already satisfied, the rest
+ *               runs from SW_TIMER_Process(). The callback may run before this returns.
+ *  @param[in]   pSeq           executor context.
+ *  @param[in]   sequence       index of the sequence.
+ *  @constraints Thread context only. Nothing else may write MODECFG while the sequence runs.
+ *  @reeentrant  No
+ *  @return      ::PCA9420_SEQ_Start() returns SENSOR_ERROR_INIT when a sequence is running. The outcome of
+ *               the steps goes to the callback, a power-good timeout as SENSOR_ERROR_READ.
+ */
+int32_t PCA9420_SEQ_Start(pca9420_seq_t *pSeq, uint8_t sequence);
+
+/*! @brief       The interface function to stop a running sequence.
+ *  @details     The steps done stay in force, the callback is not called.
+ *  @param[in]   pSeq           executor context.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ *  @return      void.
+ */
+void PCA9420_SEQ_Abort(pca9420_seq_t *pSeq);
+
+/*! @brief       The interface function to tell whether a sequence is running.
+ *  @param[in]   pSeq           executor context.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ *  @return      ::PCA9420_SEQ_IsBusy() returns true from the start of a sequence until it ends.
+ */
+bool PCA9420_SEQ_IsBusy(const pca9420_seq_t *pSeq);
+
+#endif /* PCA9420UK_SEQUENCE_H_ */
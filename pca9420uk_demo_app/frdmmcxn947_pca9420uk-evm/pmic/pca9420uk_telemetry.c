@@ -0,0 +1,269 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pca9420uk_telemetry.c
+ * @brief The pca9420uk_telemetry.c file implements the PCA9420UK telemetry streaming service.
+ */
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "pca9420uk_telemetry.h"
+#include "pca9420uk.h"
+#include "cobs.h"
+#include "crc16.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* TOP_INT up to TOP_CNTL3, one burst gives both the interrupt flags and the active mode. */
+#define PCA9420_TLM_TOP_FIRST (PCA9420UK_TOP_INT)
+#define PCA9420_TLM_TOP_COUNT (PCA9420UK_TOP_CNTL3 - PCA9420UK_TOP_INT + 1)
+
+/* CHG_STATUS0 up to REG_STATUS. */
+#define PCA9420_TLM_STATUS_FIRST (PCA9420UK_CHG_STATUS0)
+#define PCA9420_TLM_STATUS_COUNT (PCA9420UK_REG_STATUS - PCA9420UK_CHG_STATUS0 + 1)
+
+/* Type, sequence, timestamp and field mask. */
+#define PCA9420_TLM_HEADER_LEN (7u)
+
+/* Registers per mode configuration group. */
+#define PCA9420_TLM_MODECFG_LEN (4u)
+
+/* Fields the device can report. */
+#if (!PCA9421UK_EVM_EN)
+#define PCA9420_TLM_FIELD_SUPPORTED (PCA9420_TLM_FIELD_ALL)
+#else
+#define PCA9420_TLM_FIELD_SUPPORTED (PCA9420_TLM_FIELD_ALL & ~PCA9420_TLM_FIELD_CHG_STATUS)
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void PCA9420_TLM_TimerCallback(void *pUserData)
+{
+	(void)PCA9420_TLM_Sample((pca9420_telemetry_t *)pUserData);
+}
+
+static uint32_t PCA9420_TLM_PutU32(uint8_t *pBuffer, uint32_t value)
+{
+	pBuffer[0] = (uint8_t)value;
+	pBuffer[1] = (uint8_t)(value >> 8);
+	pBuffer[2] = (uint8_t)(value >> 16);
+	pBuffer[3] = (uint8_t)(value >> 24);
+	return 4u;
+}
+
+/* Writes (offset, value) of every changed byte, stops early once the pairs would not be shorter than the payload. */
+static uint32_t PCA9420_TLM_DeltaPairs(const uint8_t *pOld, const uint8_t *pNew, uint32_t length, uint8_t *pPairs)
+{
+	uint32_t i, count = 0u;
+
+	for (i = 0u; (i < length) && (count < length); i++)
+	{
+		if ((pOld[i] ^ pNew[i]) != 0u)
+		{
+			pPairs[count++] = (uint8_t)i;
+			pPairs[count++] = pNew[i];
+		}
+	}
+	return count;
+}
+
+int32_t PCA9420_TLM_Init(pca9420_telemetry_t *pTelemetry, pca9420_i2c_sensorhandle_t *pSensorHandle, pca9420_tlm_write_t write)
+{
+	if ((pTelemetry == NULL) || (pSensorHandle == NULL) || (write == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	pTelemetry->pSensorHandle = pSensorHandle;
+	pTelemetry->write = write;
+	pTelemetry->period = 0u;
+	pTelemetry->rateHz = 0u;
+	pTelemetry->fields = PCA9420_TLM_FIELD_SUPPORTED;
+	pTelemetry->sequence = 0u;
+	pTelemetry->keyframePeriod = SW_TIMER_MS_TO_TICKS(PCA9420_TLM_DEFAULT_KEYFRAME_MS);
+	pTelemetry->snapshotValid = false;
+	memset(&pTelemetry->stats, 0, sizeof(pTelemetry->stats));
+	SW_TIMER_Setup(&pTelemetry->timer, PCA9420_TLM_TimerCallback, pTelemetry);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCA9420_TLM_Start(pca9420_telemetry_t *pTelemetry, uint16_t rateHz, uint8_t fields)
+{
+	if ((pTelemetry == NULL) || (rateHz == 0u) || (rateHz > PCA9420_TLM_MAX_RATE_HZ))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	fields &= PCA9420_TLM_FIELD_SUPPORTED;
+	if (fields == 0u)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	pTelemetry->rateHz = rateHz;
+	pTelemetry->fields = fields;
+	pTelemetry->period = SW_TIMER_TICK_HZ / rateHz;
+	pTelemetry->snapshotValid = false;
+	memset(&pTelemetry->stats, 0, sizeof(pTelemetry->stats));
+
+	/* Periodic timers keep their phase, a slow sample does not shift the ones after it. */
+	SW_TIMER_Start(&pTelemetry->timer, pTelemetry->period, pTelemetry->period);
+
+	return SENSOR_ERROR_NONE;
+}
+
+void PCA9420_TLM_SetKeyframeInterval(pca9420_telemetry_t *pTelemetry, uint32_t intervalMs)
+{
+	pTelemetry->keyframePeriod = SW_TIMER_MS_TO_TICKS(intervalMs);
+}
+
+void PCA9420_TLM_Stop(pca9420_telemetry_t *pTelemetry)
+{
+	SW_TIMER_Stop(&pTelemetry->timer);
+	pTelemetry->period = 0u;
+}
+
+int32_t PCA9420_TLM_Sample(pca9420_telemetry_t *pTelemetry)
+{
+	uint8_t top[PCA9420_TLM_TOP_COUNT];
+	uint8_t status[PCA9420_TLM_STATUS_COUNT];
+	uint8_t modecfg[PCA9420_TLM_MODECFG_LEN];
+	uint8_t frame[PCA9420_TLM_MAX_FRAME_LEN];
+	uint8_t encoded[COBS_MAX_ENCODED_LEN(PCA9420_TLM_MAX_FRAME_LEN) + 2u];
+	uint8_t pairs[PCA9420_TLM_MAX_PAYLOAD_LEN + 1u];
+	uint8_t *payload;
+	uint8_t fields, type, mode = 0u;
+	uint32_t length, payloadLen, timestamp;
+	uint16_t crc;
+	int32_t result = SENSOR_ERROR_NONE;
+
+	if (pTelemetry == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	fields = pTelemetry->fields;
+	timestamp = SW_TIMER_GetTicks();
+
+	/* One burst per register group, the bus stays busy for as short as possible. */
+	if ((fields & (PCA9420_TLM_FIELD_TOP_INT | PCA9420_TLM_FIELD_MODECFG)) != 0u)
+	{
+		result = PCA9420_DRV_BlockRead(pTelemetry->pSensorHandle, PCA9420_TLM_TOP_FIRST, top, PCA9420_TLM_TOP_COUNT);
+		mode = (uint8_t)((top[PCA9420UK_TOP_CNTL3 - PCA9420_TLM_TOP_FIRST] & PCA9420_TOP_CNTL3_MODE_I2C_MASK) >>
+		                 PCA9420_TOP_CNTL3_MODE_I2C_SHIFT);
+	}
+	if ((SENSOR_ERROR_NONE == result) && ((fields & PCA9420_TLM_FIELD_CHG_STATUS) != 0u))
+	{
+		result = PCA9420_DRV_BlockRead(pTelemetry->pSensorHandle, PCA9420_TLM_STATUS_FIRST, status, PCA9420_TLM_STATUS_COUNT);
+	}
+	else if ((SENSOR_ERROR_NONE == result) && ((fields & PCA9420_TLM_FIELD_REG_STATUS) != 0u))
+	{
+		/* REG_STATUS alone, skip the charger registers in front of it. */
+		result = PCA9420_DRV_BlockRead(pTelemetry->pSensorHandle, PCA9420UK_REG_STATUS,
+		                               &status[PCA9420UK_REG_STATUS - PCA9420_TLM_STATUS_FIRST], 1u);
+	}
+	if ((SENSOR_ERROR_NONE == result) && ((fields & PCA9420_TLM_FIELD_MODECFG) != 0u))
+	{
+		result = PCA9420_DRV_BlockRead(pTelemetry->pSensorHandle, PCA9420UK_MODECFG_0_0 + (mode * PCA9420_TLM_MODECFG_LEN),
+		                               modecfg, PCA9420_TLM_MODECFG_LEN);
+	}
+	if (SENSOR_ERROR_NONE != result)
+	{
+		pTelemetry->stats.readErrors++;
+		return result;
+	}
+
+	/* The payload goes straight behind the header, a delta frame overwrites it with pairs. */
+	payload = &frame[PCA9420_TLM_HEADER_LEN];
+	payloadLen = 0u;
+	if ((fields & PCA9420_TLM_FIELD_TOP_INT) != 0u)
+	{
+		payload[payloadLen++] = top[0];
+	}
+	if ((fields & PCA9420_TLM_FIELD_CHG_STATUS) != 0u)
+	{
+		memcpy(&payload[payloadLen], status, 4u);
+		payloadLen += 4u;
+	}
+	if ((fields & PCA9420_TLM_FIELD_REG_STATUS) != 0u)
+	{
+		payload[payloadLen++] = status[PCA9420UK_REG_STATUS - PCA9420_TLM_STATUS_FIRST];
+	}
+	if ((fields & PCA9420_TLM_FIELD_MODECFG) != 0u)
+	{
+		payload[payloadLen++] = mode;
+		memcpy(&payload[payloadLen], modecfg, PCA9420_TLM_MODECFG_LEN);
+		payloadLen += PCA9420_TLM_MODECFG_LEN;
+	}
+
+	type = PCA9420_TLM_FRAME_SAMPLE;
+	length = payloadLen;
+	if (pTelemetry->snapshotValid && (pTelemetry->snapshotLen == payloadLen) && (pTelemetry->keyframePeriod != 0u) &&
+	    ((timestamp - pTelemetry->lastKeyframe) < pTelemetry->keyframePeriod))
+	{
+		length = PCA9420_TLM_DeltaPairs(pTelemetry->snapshot, payload, payloadLen, pairs);
+		if (length == 0u)
+		{
+			pTelemetry->stats.unchanged++;
+			return SENSOR_ERROR_NONE;
+		}
+		if (length < payloadLen)
+		{
+			type = PCA9420_TLM_FRAME_DELTA;
+			memcpy(&pTelemetry->snapshot[0], payload, payloadLen);
+			memcpy(payload, pairs, length);
+		}
+		else
+		{
+			/* Half the bytes or more changed, the keyframe is no longer and resyncs the host. */
+			length = payloadLen;
+		}
+	}
+
+	frame[0] = type;
+	frame[1] = pTelemetry->sequence++;
+	(void)PCA9420_TLM_PutU32(&frame[2], timestamp);
+	frame[6] = fields;
+	length += PCA9420_TLM_HEADER_LEN;
+	crc = CRC16_Compute(frame, length);
+	frame[length++] = (uint8_t)crc;
+	frame[length++] = (uint8_t)(crc >> 8);
+
+	/* Delimit on both sides, console text printed in between never runs into a frame. */
+	encoded[0] = COBS_DELIMITER;
+	length = 1u + COBS_Encode(frame, length, &encoded[1]);
+	encoded[length++] = COBS_DELIMITER;
+
+	pTelemetry->stats.samples++;
+	if (!pTelemetry->write(encoded, length))
+	{
+		/* The host missed this state, only a keyframe brings it back. */
+		pTelemetry->snapshotValid = false;
+		pTelemetry->stats.dropped++;
+		return SENSOR_ERROR_WRITE;
+	}
+	pTelemetry->stats.bytesSent += length;
+	if (type == PCA9420_TLM_FRAME_SAMPLE)
+	{
+		memcpy(pTelemetry->snapshot, payload, payloadLen);
+		pTelemetry->snapshotLen = payloadLen;
+		pTelemetry->snapshotValid = true;
+		pTelemetry->lastKeyframe = timestamp;
+		pTelemetry->stats.keyframes++;
+	}
+	else
+	{
+		pTelemetry->stats.deltas++;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
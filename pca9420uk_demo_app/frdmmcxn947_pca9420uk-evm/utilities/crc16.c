@@ -0,0 +1,37 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file crc16.c
+ * @brief CRC-16/CCITT-FALSE checksum.
+ */
+
+#include "crc16.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* Remainders of the 16 possible high nibbles. */
+static const uint16_t s_crc16Nibble[16] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *pData, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ s_crc16Nibble[((crc >> 12) ^ (pData[i] >> 4)) & 0x0FU]);
+        crc = (uint16_t)((crc << 4) ^ s_crc16Nibble[((crc >> 12) ^ pData[i]) & 0x0FU]);
+    }
+
+    return crc;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file event_loop.c
+ * @brief Run-to-completion event loop.
+ */
+
+#include "fsl_common.h"
+#include "sw_timer.h"
+#include "event_loop.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+typedef struct
+{
+    event_handler_t handler;
+    void *pUserData;
+} event_loop_entry_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static event_loop_entry_t s_entries[EVENT_LOOP_MAX_EVENTS];
+static volatile uint32_t s_pending;
+static event_idle_hook_t s_idleHook;
+static event_loop_stats_t s_stats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+void EVENT_LOOP_Init(event_idle_hook_t idleHook)
+{
+    uint32_t i;
+
+    for (i = 0U; i < EVENT_LOOP_MAX_EVENTS; i++)
+    {
+        s_entries[i].handler = NULL;
+    }
+    s_pending = 0U;
+    s_idleHook = idleHook;
+}
+
+bool EVENT_LOOP_Register(uint32_t event, event_handler_t handler, void *pUserData)
+{
+    if (event >= EVENT_LOOP_MAX_EVENTS)
+    {
+        return false;
+    }
+
+    s_entries[event].pUserData = pUserData;
+    s_entries[event].handler = handler;
+
+    return true;
+}
+
+void EVENT_LOOP_Post(uint32_t event)
+{
+    uint32_t primask;
+
+    if (event < EVENT_LOOP_MAX_EVENTS)
+    {
+        primask = DisableGlobalIRQ();
+        s_pending |= (1UL << event);
+        EnableGlobalIRQ(primask);
+    }
+}
+
+bool EVENT_LOOP_RunOnce(void)
+{
+    uint32_t primask, pending, event;
+    bool ran = false;
+
+    /* Take all pending events at once, events posted by the handlers run in the next pass. */
+    primask = DisableGlobalIRQ();
+    pending = s_pending;
+    s_pending = 0U;
+    EnableGlobalIRQ(primask);
+
+    while (pending != 0U)
+    {
+        event = (uint32_t)__builtin_ctz(pending);
+
+        /* Drop the lowest set bit. */
+        pending &= pending - 1U;
+        if (s_entries[event].handler != NULL)
+        {
+            s_entries[event].handler(s_entries[event].pUserData);
+            s_stats.dispatched++;
+            ran = true;
+        }
+        else
+        {
+            s_stats.unhandled++;
+        }
+    }
+
+    SW_TIMER_Process();
+
+    return ran;
+}
+
+void EVENT_LOOP_Poll(void)
+{
+    uint32_t primask;
+
+    (void)EVENT_LOOP_RunOnce();
+
+    if (s_idleHook != NULL)
+    {
+        s_idleHook();
+    }
+
+    /* With interrupts masked a post between the check and WFI still wakes the core. */
+    primask = DisableGlobalIRQ();
+    if (s_pending == 0U)
+    {
+        s_stats.sleeps++;
+        SW_TIMER_Idle();
+    }
+    EnableGlobalIRQ(primask);
+}
+
+void EVENT_LOOP_Run(void)
+{
+    while (true)
+    {
+        EVENT_LOOP_Poll();
+    }
+}
+
+void EVENT_LOOP_GetStats(event_loop_stats_t *pStats)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    *pStats = s_stats;
+    EnableGlobalIRQ(primask);
+}
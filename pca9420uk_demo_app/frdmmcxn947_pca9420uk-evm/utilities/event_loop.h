@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file event_loop.h
+ * @brief Run-to-completion event loop.
+
+    Interrupts post events, a pending bit per event number, and return. The loop runs the
+    handler of every pending event in thread context, lowest event number first, then the
+    expired software timers. When nothing is left to do it calls the idle hook and sleeps in
+    WFI until the next interrupt or the next due timer.
+
+    Blocking console reads run the loop through DbgConsole_SetRxWaitHook(), so timers,
+    interrupts and logging keep being serviced while a menu waits for input.
+*/
+
+#ifndef __EVENT_LOOP_H__
+#define __EVENT_LOOP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of event numbers, one per bit of the pending word. */
+#define EVENT_LOOP_MAX_EVENTS (32U)
+
+/*! @brief Event handler, called from the loop in thread context. */
+typedef void (*event_handler_t)(void *pUserData);
+
+/*! @brief Called once per pass right before the loop goes to sleep. */
+typedef void (*event_idle_hook_t)(void);
+
+/*!
+ * @brief Event loop statistics.
+ */
+typedef struct
+{
+    uint32_t dispatched; /*!< Handler calls. */
+    uint32_t sleeps;     /*!< Passes that ended in WFI. */
+    uint32_t unhandled;  /*!< Posted events without a handler. */
+} event_loop_stats_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to initialize the event loop.
+ *  @param[in]   idleHook Work to run before sleeping, for example draining a log buffer, may be NULL.
+ *  @return      void.
+ *  @constraints SW_TIMER_Init() must have been called before.
+ *  @reeentrant  No
+ */
+void EVENT_LOOP_Init(event_idle_hook_t idleHook);
+
+/*! @brief       Function to attach a handler to an event number.
+ *  @param[in]   event     Event number, 0 to EVENT_LOOP_MAX_EVENTS - 1. Lower numbers run first.
+ *  @param[in]   handler   Event handler.
+ *  @param[in]   pUserData Argument of the handler.
+ *  @return      bool false when the event number is out of range.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+bool EVENT_LOOP_Register(uint32_t event, event_handler_t handler, void *pUserData);
+
+/*! @brief       Function to post an event.
+ *  @details     Posting an already pending event is coalesced, its handler runs once.
+ *  @param[in]   event Event number.
+ *  @return      void.
+ *  @constraints None, may be called from interrupt context.
+ *  @reeentrant  Yes
+ */
+void EVENT_LOOP_Post(uint32_t event);
+
+/*! @brief       Function to run the pending events and the expired timers once.
+ *  @param[in]   void.
+ *  @return      bool true when at least one event handler ran.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ */
+bool EVENT_LOOP_RunOnce(void);
+
+/*! @brief       Function to run one pass of the loop.
+ *  @details     This function runs the pending work and sleeps when no event was posted meanwhile.
+ *               It returns after the first wake up.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ */
+void EVENT_LOOP_Poll(void);
+
+/*! @brief       Function to run the loop forever.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Thread context only.
+ *  @reeentrant  No
+ */
+void EVENT_LOOP_Run(void);
+
+/*! @brief       Function to read the loop statistics.
+ *  @param[out]  pStats Statistics snapshot.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+void EVENT_LOOP_GetStats(event_loop_stats_t *pStats);
+
+#endif // __EVENT_LOOP_H__
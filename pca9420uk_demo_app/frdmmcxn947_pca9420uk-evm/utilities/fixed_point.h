@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fixed_point.h
+ * @brief Integer only formatting and parsing of fixed-point quantities.
+
+    Voltages, currents and temperatures are kept as scaled integers (mV, mA,
+    0.1 degC). These helpers print and scan them with a decimal point so the
+    console does not need PRINTF_FLOAT_ENABLE or SCANF_FLOAT_ENABLE.
+*/
+
+#ifndef __FIXED_POINT_H__
+#define __FIXED_POINT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Buffer size that holds any formatted value, sign and terminator included. */
+#define FIXPT_STR_LEN (14U)
+
+/*! @brief Formats milli units (mV, mA) as units with three decimals, "0.925". */
+#define FIXPT_FormatMilli(pBuffer, milli) FIXPT_Format((pBuffer), (milli), 3U)
+
+/*! @brief Formats tenths (0.1 degC) with one decimal, "25.5". */
+#define FIXPT_FormatDeci(pBuffer, deci) FIXPT_Format((pBuffer), (deci), 1U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to format a fixed-point value.
+ *  @details     This function prints value / 10^fracDigits with exactly fracDigits decimals.
+ *  @param[out]  pBuffer    Destination, at least FIXPT_STR_LEN bytes.
+ *  @param[in]   value      Scaled value.
+ *  @param[in]   fracDigits Number of implied decimals, 0 to 9.
+ *  @return      char* pBuffer, for use as a PRINTF argument.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+char *FIXPT_Format(char *pBuffer, int32_t value, uint8_t fracDigits);
+
+/*! @brief       Function to parse a decimal number into a fixed-point value.
+ *  @details     This function accepts an optional sign, digits and an optional fraction, "0.925" with
+ *               fracDigits 3 gives 925. Decimals beyond fracDigits must be zero.
+ *  @param[in]   pString    Text to parse, leading blanks are skipped.
+ *  @param[in]   fracDigits Number of implied decimals of the result, 0 to 9.
+ *  @param[out]  pValue     Parsed value.
+ *  @param[out]  ppEnd      First character after the number, may be NULL.
+ *  @return      bool true when a number was found and fits into 32 bits.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+bool FIXPT_Parse(const char *pString, uint8_t fracDigits, int32_t *pValue, const char **ppEnd);
+
+/*! @brief       Function to parse a quantity into milli units.
+ *  @details     This function accepts "0.925", "0.925V" and "925mV" alike, any unit letters after the
+ *               number are ignored, a leading 'm' selects milli units. The whole string must be consumed.
+ *  @param[in]   pString Text to parse.
+ *  @param[out]  pMilli  Value in milli units.
+ *  @return      bool true on success.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+bool FIXPT_ParseMilli(const char *pString, int32_t *pMilli);
+
+#endif // __FIXED_POINT_H__
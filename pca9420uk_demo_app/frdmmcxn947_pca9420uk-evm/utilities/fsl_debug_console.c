@@ -259,6 +259,9 @@ static debug_console_state_struct_t s_debugConsoleState;
 #endif
 serial_handle_t g_serialHandle; /*!< serial manager handle */
 
+/*! @brief Receive wait hook, NULL for a plain blocking read. */
+static void (*s_debugConsoleRxWait)(void);
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -274,12 +277,12 @@ serial_handle_t g_serialHandle; /*!< serial manager handle */
  */
 #if (defined(SDK_DEBUGCONSOLE) && (SDK_DEBUGCONSOLE == DEBUGCONSOLE_REDIRECT_TO_SDK))
 static void DbgConsole_PrintCallback(char *buf, int32_t *indicator, char dbgVal, int len);
+static int DbgConsole_ReadScanfLine(uint8_t *buf, size_t size);
 #endif
 
 status_t DbgConsole_ReadOneCharacter(uint8_t *ch);
 int DbgConsole_SendData(uint8_t *ch, size_t size);
 int DbgConsole_SendDataReliable(uint8_t *ch, size_t size);
-int DbgConsole_ReadLine(uint8_t *buf, size_t size);
 int DbgConsole_ReadCharacter(uint8_t *ch);
 
 #if ((SDK_DEBUGCONSOLE != DEBUGCONSOLE_REDIRECT_TO_SDK) && defined(DEBUG_CONSOLE_TRANSFER_NON_BLOCKING) && \
@@ -421,9 +424,20 @@ static void DbgConsole_SerialManagerRxCallback(void *callbackParam,
 
 #endif
 
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetRxWaitHook(void (*hook)(void))
+{
+    s_debugConsoleRxWait = hook;
+}
+
 status_t DbgConsole_ReadOneCharacter(uint8_t *ch)
 {
 #if (defined(DEBUG_CONSOLE_RX_ENABLE) && (DEBUG_CONSOLE_RX_ENABLE > 0U))
+    if (NULL != s_debugConsoleRxWait)
+    {
+        s_debugConsoleRxWait();
+    }
+
 
 #if defined(DEBUG_CONSOLE_TRANSFER_NON_BLOCKING) && \
     (DEBUG_CONSOLE_SYNCHRONIZATION_MODE == DEBUG_CONSOLE_SYNCHRONIZATION_BM) && defined(OSA_USED)
@@ -626,7 +640,8 @@ int DbgConsole_SendDataReliable(uint8_t *ch, size_t size)
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 }
 
-int DbgConsole_ReadLine(uint8_t *buf, size_t size)
+#if (defined(SDK_DEBUGCONSOLE) && (SDK_DEBUGCONSOLE == DEBUGCONSOLE_REDIRECT_TO_SDK))
+static int DbgConsole_ReadScanfLine(uint8_t *buf, size_t size)
 {
     int i = 0;
 
@@ -691,6 +706,7 @@ int DbgConsole_ReadLine(uint8_t *buf, size_t size)
 
     return i;
 }
+#endif
 
 int DbgConsole_ReadCharacter(uint8_t *ch)
 {
@@ -1059,6 +1075,10 @@ int DbgConsole_Printf(const char *fmt_s, ...)
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Vprintf(const char *fmt_s, va_list formatStringArg)
 {
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+    /* Blocking output would interleave with the DMA transmit ring. */
+    return (NULL != g_serialHandle) ? DbgConsole_DmaVprintf(fmt_s, formatStringArg) : 0;
+#else
     int logLength = 0, result = 0;
     char printBuf[DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN] = {'\0'};
 
@@ -1070,13 +1090,20 @@ int DbgConsole_Vprintf(const char *fmt_s, va_list formatStringArg)
         result = DbgConsole_SendDataReliable((uint8_t *)printBuf, (size_t)logLength);
     }
     return result;
+#endif
 }
 
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Putchar(int ch)
 {
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+    uint8_t c = (uint8_t)ch;
+
+    return (DbgConsole_DmaWrite(&c, 1U) < 0) ? -1 : 1;
+#else
     /* print char */
     return DbgConsole_SendDataReliable((uint8_t *)&ch, 1U);
+#endif
 }
 
 /* See fsl_debug_console.h for documentation of this function. */
@@ -1087,7 +1114,7 @@ int DbgConsole_Scanf(char *fmt_s, ...)
     char scanfBuf[DEBUG_CONSOLE_SCANF_MAX_LOG_LEN + 1U] = {'\0'};
 
     /* scanf log */
-    (void)DbgConsole_ReadLine((uint8_t *)scanfBuf, DEBUG_CONSOLE_SCANF_MAX_LOG_LEN);
+    (void)DbgConsole_ReadScanfLine((uint8_t *)scanfBuf, DEBUG_CONSOLE_SCANF_MAX_LOG_LEN);
     /* get va_list */
     va_start(ap, fmt_s);
     /* format scanf log */
@@ -1195,6 +1222,52 @@ int DbgConsole_Getchar(void)
     return ret;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_ReadLine(uint8_t *buf, size_t size)
+{
+    int i = 0;
+    int ch;
+
+    while (i < (int)size)
+    {
+        ch = DbgConsole_Getchar();
+        if (ch < 0)
+        {
+            return -1;
+        }
+
+        if ((ch == '\r') || (ch == '\n'))
+        {
+            /* End of Line, empty lines are skipped. */
+            if (i == 0)
+            {
+                continue;
+            }
+            (void)DbgConsole_Putchar('\r');
+            (void)DbgConsole_Putchar('\n');
+            break;
+        }
+
+        if ((ch == 0x7F) || (ch == '\b'))
+        {
+            if (i > 0)
+            {
+                i--;
+                (void)DbgConsole_Putchar('\b');
+                (void)DbgConsole_Putchar(' ');
+                (void)DbgConsole_Putchar('\b');
+            }
+            continue;
+        }
+
+        (void)DbgConsole_Putchar(ch);
+        buf[i++] = (uint8_t)ch;
+    }
+    buf[i] = (uint8_t)'\0';
+
+    return i;
+}
+
 #endif /* SDK_DEBUGCONSOLE */
 
 /*************Code to support toolchain's printf, scanf *******************************/
@@ -69,7 +69,12 @@ static inline int DbgConsole_Disabled(void)
 #define PUTCHAR(...) DbgConsole_Disabled()
 #define GETCHAR()    DbgConsole_Disabled()
 #elif SDK_DEBUGCONSOLE == DEBUGCONSOLE_REDIRECT_TO_SDK /* Select printf, scanf, putchar, getchar of SDK version. */
+#if defined(DEBUG_CONSOLE_TRANSFER_DMA_RING) && (DEBUG_CONSOLE_TRANSFER_DMA_RING > 0U)
+#include "debug_console_dma.h"
+#define PRINTF  DbgConsole_DmaPrintf /* Formats into the transmit ring, drained by LPUART eDMA. */
+#else
 #define PRINTF  DbgConsole_Printf
+#endif
 #define SCANF   DbgConsole_Scanf
 #define PUTCHAR DbgConsole_Putchar
 #define GETCHAR DbgConsole_Getchar
@@ -253,6 +258,29 @@ int DbgConsole_Scanf(char *fmt_s, ...);
  */
 int DbgConsole_Getchar(void);
 
+/*!
+ * @brief Reads a line from standard input.
+ *
+ * Call this function to read characters up to a carriage return or line feed. Empty lines are
+ * skipped, input is echoed and backspace removes the last character.
+ *
+ * @param   buf  Destination, at least size + 1 bytes, NUL terminated on return.
+ * @param   size Maximum number of characters of the line.
+ * @return  Returns the number of characters read without the line end, or -1 if an error occurs.
+ */
+int DbgConsole_ReadLine(uint8_t *buf, size_t size);
+
+/*!
+ * @brief Installs a hook that waits for receive data.
+ *
+ * The hook is called before every blocking character read and returns once a character can be
+ * read without blocking. An event loop uses it to keep servicing timers and interrupts while
+ * the console waits for input.
+ *
+ * @param   hook Wait function, NULL restores the plain blocking read.
+ */
+void DbgConsole_SetRxWaitHook(void (*hook)(void));
+
 /*!
  * @brief Writes formatted output to the standard output stream with the blocking mode.
  *
@@ -68,6 +68,18 @@
 #define DEBUG_CONSOLE_TRANSFER_BLOCKING
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 
+/*! @brief If DMA ring transmit is needed, define DEBUG_CONSOLE_TRANSFER_DMA_RING=1 at project setting.
+ * PRINTF and PUTCHAR then write into a ring buffer which the LPUART eDMA drains in the background and
+ * return without waiting for the UART, both go out in the order written and both follow the overflow
+ * policy when the ring is full. SCANF and GETCHAR keep using the transfer mode selected above.
+ * The ring size and the overflow policy (drop or block) are set with DEBUG_CONSOLE_DMA_TX_BUFFER_LEN and
+ * DEBUG_CONSOLE_DMA_OVERFLOW_POLICY, see debug_console_dma.h. The eDMA channel is taken from the
+ * RTE_USARTx_DMA_TX_* settings in RTE_Device.h. Call DbgConsole_DmaInit() after BOARD_InitDebugConsole().
+ */
+#ifndef DEBUG_CONSOLE_TRANSFER_DMA_RING
+#define DEBUG_CONSOLE_TRANSFER_DMA_RING (0U)
+#endif /* DEBUG_CONSOLE_TRANSFER_DMA_RING */
+
 /*!@brief Whether enable the RX function
  * If the macro is zero, the receive function of the debug console is disabled.
  */
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file nvm_store.c
+ * @brief Sector based application data storage.
+ */
+
+#include <string.h>
+#include "nvm_store.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if NVM_STORE_USE_FLASH
+/* FMU commands, the address and for a program the data come from writes to the flash array. */
+#define NVM_CMD_PROGRAM_PHRASE (0x24U)
+#define NVM_CMD_ERASE_SECTOR   (0x42U)
+
+/* Flags that end a command with an error. */
+#define NVM_FSTAT_ERRORS (FMU_FSTAT_ACCERR_MASK | FMU_FSTAT_PVIOL_MASK | FMU_FSTAT_CMDABT_MASK | FMU_FSTAT_FAIL_MASK)
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#if NVM_STORE_USE_FLASH
+/* Top of the program flash and end of the image, from the linker script. */
+extern char __top_Flash[];
+extern char _image_end[];
+
+static uint32_t s_base;
+#else
+/* .noinit is neither loaded nor zeroed by the startup code. */
+static uint8_t s_ram[NVM_SECTOR_COUNT][NVM_RAM_SECTOR_SIZE] __attribute__((section(".noinit.nvm_store"), aligned(4)));
+#endif
+static uint32_t s_sectorSize;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static bool NVM_CheckRange(uint32_t sector, uint32_t offset, uint32_t length)
+{
+    uint32_t unit = NVM_GetProgramUnit();
+
+    return (s_sectorSize != 0U) && (sector < NVM_SECTOR_COUNT) && (offset <= s_sectorSize) &&
+           (length <= s_sectorSize - offset) && ((offset % unit) == 0U) && ((length % unit) == 0U);
+}
+
+#if NVM_STORE_USE_FLASH
+/* Runs one FMU command from RAM, the flash cannot be read while it is busy. Interrupts must be masked,
+ * the vector table lives in the same flash. */
+AT_QUICKACCESS_SECTION_CODE(static uint32_t NVM_RunCommand(uint32_t command, uint32_t address, const uint32_t *pPhrase))
+{
+    volatile uint32_t *pArray = (volatile uint32_t *)address;
+    uint32_t speculation = SYSCON->NVM_CTRL;
+    uint32_t fstat;
+    uint32_t i;
+
+    /* No prefetch into the array while it changes. */
+    SYSCON->NVM_CTRL = speculation | SYSCON_NVM_CTRL_DIS_FLASH_SPEC_MASK | SYSCON_NVM_CTRL_DIS_DATA_SPEC_MASK;
+    while ((FMU0->FSTAT & FMU_FSTAT_CCIF_MASK) == 0U)
+    {
+    }
+    FMU0->FSTAT = FMU_FSTAT_ACCERR_MASK | FMU_FSTAT_PVIOL_MASK | FMU_FSTAT_CMDABT_MASK;
+    FMU0->FCCOB[0] = command;
+    FMU0->FSTAT = FMU_FSTAT_CCIF_MASK;
+
+    /* A refused command completes at once instead of opening the array for writes. */
+    do
+    {
+        fstat = FMU0->FSTAT;
+    } while ((fstat & (FMU_FSTAT_PEWEN_MASK | FMU_FSTAT_CCIF_MASK)) == 0U);
+    if ((fstat & FMU_FSTAT_PEWEN_MASK) != 0U)
+    {
+        for (i = 0U; i < NVM_PHRASE_SIZE / sizeof(uint32_t); i++)
+        {
+            pArray[i] = pPhrase[i];
+        }
+        do
+        {
+            fstat = FMU0->FSTAT;
+        } while ((fstat & (FMU_FSTAT_PERDY_MASK | FMU_FSTAT_CCIF_MASK)) == 0U);
+        if ((fstat & FMU_FSTAT_PERDY_MASK) != 0U)
+        {
+            FMU0->FSTAT = FMU_FSTAT_PERDY_MASK;
+        }
+        do
+        {
+            fstat = FMU0->FSTAT;
+        } while ((fstat & FMU_FSTAT_CCIF_MASK) == 0U);
+    }
+
+    /* Reads must not be served from lines cached before the command. */
+    SYSCON->LPCAC_CTRL |= SYSCON_LPCAC_CTRL_CLR_LPCAC_MASK;
+    SYSCON->NVM_CTRL = speculation;
+    return fstat & NVM_FSTAT_ERRORS;
+}
+
+static status_t NVM_Command(uint32_t command, uint32_t address, const uint32_t *pPhrase)
+{
+    uint32_t primask;
+    uint32_t errors;
+
+    primask = DisableGlobalIRQ();
+    errors = NVM_RunCommand(command, address, pPhrase);
+    EnableGlobalIRQ(primask);
+
+    return (errors == 0U) ? kStatus_Success : kStatus_Fail;
+}
+
+status_t NVM_Init(void)
+{
+    s_sectorSize = 0U;
+
+    /* The top sectors, as long as the image stays below them. */
+    s_base = (uint32_t)__top_Flash - NVM_SECTOR_COUNT * NVM_FLASH_SECTOR_SIZE;
+    if ((uint32_t)_image_end > s_base)
+    {
+        return kStatus_Fail;
+    }
+    s_sectorSize = NVM_FLASH_SECTOR_SIZE;
+
+    return kStatus_Success;
+}
+
+bool NVM_IsPersistent(void)
+{
+    return true;
+}
+
+uint32_t NVM_GetProgramUnit(void)
+{
+    return NVM_PHRASE_SIZE;
+}
+
+const uint8_t *NVM_GetSector(uint32_t sector)
+{
+    return ((s_sectorSize != 0U) && (sector < NVM_SECTOR_COUNT)) ? (const uint8_t *)(s_base + sector * s_sectorSize) : NULL;
+}
+
+status_t NVM_EraseSector(uint32_t sector)
+{
+    /* The write that selects the sector, its data is ignored. On the stack, not in the busy flash. */
+    uint32_t phrase[NVM_PHRASE_SIZE / sizeof(uint32_t)] = {0U};
+    const uint8_t *pSector;
+    status_t status;
+    uint32_t i;
+
+    if (!NVM_CheckRange(sector, 0U, s_sectorSize))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    pSector = NVM_GetSector(sector);
+    status = NVM_Command(NVM_CMD_ERASE_SECTOR, (uint32_t)pSector, phrase);
+
+    /* Read back, a sector that does not read erased is not usable. */
+    for (i = 0U; (kStatus_Success == status) && (i < s_sectorSize); i++)
+    {
+        if (pSector[i] != 0xFFU)
+        {
+            status = kStatus_Fail;
+        }
+    }
+    return status;
+}
+
+status_t NVM_Program(uint32_t sector, uint32_t offset, const void *pData, uint32_t length)
+{
+    uint32_t phrase[NVM_PHRASE_SIZE / sizeof(uint32_t)];
+    const uint8_t *pSource = (const uint8_t *)pData;
+    const uint8_t *pTarget;
+    status_t status = kStatus_Success;
+    uint32_t done;
+
+    if ((pData == NULL) || !NVM_CheckRange(sector, offset, length))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* One phrase at a time, interrupts are only held off for a phrase. */
+    pTarget = NVM_GetSector(sector) + offset;
+    for (done = 0U; (kStatus_Success == status) && (done < length); done += NVM_PHRASE_SIZE)
+    {
+        memcpy(phrase, &pSource[done], NVM_PHRASE_SIZE);
+        status = NVM_Command(NVM_CMD_PROGRAM_PHRASE, (uint32_t)&pTarget[done], phrase);
+    }
+    if ((kStatus_Success == status) && (memcmp(pTarget, pSource, length) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    return status;
+}
+#else
+status_t NVM_Init(void)
+{
+    s_sectorSize = NVM_RAM_SECTOR_SIZE;
+    return kStatus_Success;
+}
+
+bool NVM_IsPersistent(void)
+{
+    return false;
+}
+
+uint32_t NVM_GetProgramUnit(void)
+{
+    return 4U;
+}
+
+const uint8_t *NVM_GetSector(uint32_t sector)
+{
+    return ((s_sectorSize != 0U) && (sector < NVM_SECTOR_COUNT)) ? s_ram[sector] : NULL;
+}
+
+status_t NVM_EraseSector(uint32_t sector)
+{
+    if (!NVM_CheckRange(sector, 0U, s_sectorSize))
+    {
+        return kStatus_InvalidArgument;
+    }
+    memset(s_ram[sector], 0xFF, s_sectorSize);
+    return kStatus_Success;
+}
+
+status_t NVM_Program(uint32_t sector, uint32_t offset, const void *pData, uint32_t length)
+{
+    if ((pData == NULL) || !NVM_CheckRange(sector, offset, length))
+    {
+        return kStatus_InvalidArgument;
+    }
+    memcpy(&s_ram[sector][offset], pData, length);
+    return kStatus_Success;
+}
+#endif
+
+uint32_t NVM_GetSectorSize(void)
+{
+    return s_sectorSize;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file nvm_store.h
+ * @brief Sector based application data storage.
+
+    A small number of erase sectors for application data, read through plain pointers and
+    written with erase and program calls. The sectors are the top NVM_SECTOR_COUNT sectors of
+    the program flash, erased and programmed through the flash memory unit (FMU) registers,
+    so no flash driver is needed in the project. Building with NVM_STORE_USE_FLASH set to 0
+    moves them to retained RAM instead: they keep their contents over MCU resets but not over
+    a power cycle. NVM_IsPersistent() tells which backend is in use.
+
+    Erased bytes read as 0xFF. Programming is done in multiples of NVM_GetProgramUnit() at
+    offsets aligned to it, into erased space only. Erase and program read the result back.
+*/
+
+#ifndef __NVM_STORE_H__
+#define __NVM_STORE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of sectors provided. */
+#define NVM_SECTOR_COUNT (2U)
+
+/*! @brief Use the program flash. 0 keeps the sectors in retained RAM. */
+#ifndef NVM_STORE_USE_FLASH
+#define NVM_STORE_USE_FLASH 1
+#endif
+
+/*! @brief Flash erase sector and program phrase sizes. */
+#define NVM_FLASH_SECTOR_SIZE ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SECTOR_SIZE_BYTES)
+#define NVM_PHRASE_SIZE       (16U)
+
+/*! @brief Sector size of the retained RAM fallback. */
+#ifndef NVM_RAM_SECTOR_SIZE
+#define NVM_RAM_SECTOR_SIZE (1024U)
+#endif
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to initialize the storage.
+ *  @details     This function locates the sectors. On flash it refuses to run when the sectors overlap the image.
+ *  @param[in]   void.
+ *  @return      status_t kStatus_Success, or kStatus_Fail when the storage is not usable.
+ *  @constraints Call once before the other functions.
+ *  @reeentrant  No
+ */
+status_t NVM_Init(void);
+
+/*! @brief       Function to tell whether the contents survive a power cycle.
+ *  @param[in]   void.
+ *  @return      bool true on flash, false on the retained RAM fallback.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+bool NVM_IsPersistent(void);
+
+/*! @brief       Function to read the sector size.
+ *  @param[in]   void.
+ *  @return      uint32_t Bytes per sector, 0 before NVM_Init() succeeded.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint32_t NVM_GetSectorSize(void);
+
+/*! @brief       Function to read the program granularity.
+ *  @param[in]   void.
+ *  @return      uint32_t Bytes per program unit.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint32_t NVM_GetProgramUnit(void);
+
+/*! @brief       Function to map a sector for reading.
+ *  @param[in]   sector Sector index, 0 to NVM_SECTOR_COUNT - 1.
+ *  @return      const uint8_t* Start of the sector, NULL when out of range or not initialized.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+const uint8_t *NVM_GetSector(uint32_t sector);
+
+/*! @brief       Function to erase a sector.
+ *  @param[in]   sector Sector index.
+ *  @return      status_t kStatus_Success, kStatus_Fail when the flash refused the command or does not read erased.
+ *  @constraints Thread context only. Interrupts are masked while the flash is busy.
+ *  @reeentrant  No
+ */
+status_t NVM_EraseSector(uint32_t sector);
+
+/*! @brief       Function to program erased space.
+ *  @param[in]   sector Sector index.
+ *  @param[in]   offset Offset in the sector, aligned to the program unit.
+ *  @param[in]   pData  Data to write.
+ *  @param[in]   length Number of bytes, a multiple of the program unit.
+ *  @return      status_t kStatus_Success, kStatus_Fail when the flash refused the command or reads back different data.
+ *  @constraints Thread context only. Interrupts are masked while the flash is busy, one phrase at a time.
+ *  @reeentrant  No
+ */
+status_t NVM_Program(uint32_t sector, uint32_t offset, const void *pData, uint32_t length);
+
+#endif /* __NVM_STORE_H__ */
@@ -0,0 +1,265 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  sw_timer.c
+ * @brief Hierarchical timer wheel with SW_TIMER_LEVELS levels of SW_TIMER_SLOTS slots.
+ *        Level n slots span SW_TIMER_SLOTS^n ticks. A timer is linked into the level matching
+ *        the distance to its expiry and is cascaded one level down each time the wheel
+ *        reaches its slot, so insert and cancel are O(1) and expiry is amortized O(1).
+ */
+
+#include "fsl_common.h"
+#include "systick_utils.h"
+#include "sw_timer.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SW_TIMER_LEVELS    5u
+#define SW_TIMER_SLOT_BITS 5u
+#define SW_TIMER_SLOTS     (1u << SW_TIMER_SLOT_BITS)
+#define SW_TIMER_SLOT_MASK (SW_TIMER_SLOTS - 1u)
+
+#define SW_TIMER_LEVEL_SHIFT(level) ((level) * SW_TIMER_SLOT_BITS)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static sw_timer_t *s_wheel[SW_TIMER_LEVELS][SW_TIMER_SLOTS];
+static uint32_t s_occupied[SW_TIMER_LEVELS]; // One bit per non-empty slot.
+static uint32_t s_now;                       // Last tick processed by the wheel.
+static volatile uint32_t s_pendingTicks;     // Ticks counted by the interrupt, not yet processed.
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+// Systick tick callback, interrupt context.
+static void SW_TIMER_TickHandler(void)
+{
+    s_pendingTicks += 1u;
+}
+
+static void SW_TIMER_Link(sw_timer_t *pTimer)
+{
+    uint32_t delta = pTimer->expires - s_now;
+    uint32_t level = 0;
+    sw_timer_t **pHead;
+
+    while ((level < (SW_TIMER_LEVELS - 1u)) && (delta >= (1u << SW_TIMER_LEVEL_SHIFT(level + 1u))))
+    {
+        level++;
+    }
+
+    pTimer->level = (uint8_t)level;
+    pTimer->slot = (uint8_t)((pTimer->expires >> SW_TIMER_LEVEL_SHIFT(level)) & SW_TIMER_SLOT_MASK);
+
+    pHead = &s_wheel[level][pTimer->slot];
+    pTimer->next = *pHead;
+    if (pTimer->next != NULL)
+    {
+        pTimer->next->pprev = &pTimer->next;
+    }
+    *pHead = pTimer;
+    pTimer->pprev = pHead;
+    s_occupied[level] |= 1u << pTimer->slot;
+}
+
+static void SW_TIMER_Unlink(sw_timer_t *pTimer)
+{
+    *pTimer->pprev = pTimer->next;
+    if (pTimer->next != NULL)
+    {
+        pTimer->next->pprev = pTimer->pprev;
+    }
+    pTimer->next = NULL;
+    pTimer->pprev = NULL;
+
+    if (NULL == s_wheel[pTimer->level][pTimer->slot])
+    {
+        s_occupied[pTimer->level] &= ~(1u << pTimer->slot);
+    }
+}
+
+// Moves all timers of a slot to the level matching their remaining time.
+static void SW_TIMER_Cascade(uint32_t level, uint32_t slot)
+{
+    sw_timer_t *pTimer = s_wheel[level][slot];
+    sw_timer_t *pNext;
+
+    s_wheel[level][slot] = NULL;
+    s_occupied[level] &= ~(1u << slot);
+
+    while (pTimer != NULL)
+    {
+        pNext = pTimer->next;
+        SW_TIMER_Link(pTimer);
+        pTimer = pNext;
+    }
+}
+
+static void SW_TIMER_RunTick(void)
+{
+    uint32_t level = 1;
+    sw_timer_t **pHead;
+    sw_timer_t *pTimer;
+
+    s_now += 1u;
+
+    // Cascade every level whose lower levels just wrapped.
+    while ((level < SW_TIMER_LEVELS) && (0u == (s_now & ((1u << SW_TIMER_LEVEL_SHIFT(level)) - 1u))))
+    {
+        SW_TIMER_Cascade(level, (s_now >> SW_TIMER_LEVEL_SHIFT(level)) & SW_TIMER_SLOT_MASK);
+        level++;
+    }
+
+    // Pop one timer at a time so that callbacks may start or stop any timer.
+    pHead = &s_wheel[0][s_now & SW_TIMER_SLOT_MASK];
+    while ((pTimer = *pHead) != NULL)
+    {
+        SW_TIMER_Unlink(pTimer);
+        if (pTimer->period != 0u)
+        {
+            pTimer->expires += pTimer->period;
+            SW_TIMER_Link(pTimer);
+        }
+        pTimer->callback(pTimer->pUserData);
+    }
+}
+
+void SW_TIMER_Init(void)
+{
+    uint32_t level, slot;
+
+    for (level = 0; level < SW_TIMER_LEVELS; level++)
+    {
+        for (slot = 0; slot < SW_TIMER_SLOTS; slot++)
+        {
+            s_wheel[level][slot] = NULL;
+        }
+        s_occupied[level] = 0;
+    }
+    s_now = 0;
+    s_pendingTicks = 0;
+
+    BOARD_SystickEnableTick(SW_TIMER_TICK_HZ, SW_TIMER_TickHandler);
+}
+
+void SW_TIMER_Setup(sw_timer_t *pTimer, sw_timer_callback_t callback, void *pUserData)
+{
+    pTimer->next = NULL;
+    pTimer->pprev = NULL;
+    pTimer->expires = 0;
+    pTimer->period = 0;
+    pTimer->callback = callback;
+    pTimer->pUserData = pUserData;
+}
+
+void SW_TIMER_Start(sw_timer_t *pTimer, uint32_t timeout, uint32_t period)
+{
+    if (pTimer->pprev != NULL)
+    {
+        SW_TIMER_Unlink(pTimer);
+    }
+
+    if (0u == timeout)
+    {
+        timeout = 1u;
+    }
+    if (timeout > SW_TIMER_MAX_TICKS)
+    {
+        timeout = SW_TIMER_MAX_TICKS;
+    }
+    if (period > SW_TIMER_MAX_TICKS)
+    {
+        period = SW_TIMER_MAX_TICKS;
+    }
+
+    // Relative to the tick the interrupt has counted, not the one processed so far.
+    pTimer->expires = SW_TIMER_GetTicks() + timeout;
+    pTimer->period = period;
+    SW_TIMER_Link(pTimer);
+}
+
+void SW_TIMER_Stop(sw_timer_t *pTimer)
+{
+    if (pTimer->pprev != NULL)
+    {
+        SW_TIMER_Unlink(pTimer);
+    }
+}
+
+bool SW_TIMER_IsActive(const sw_timer_t *pTimer)
+{
+    return (pTimer->pprev != NULL);
+}
+
+uint32_t SW_TIMER_GetTicks(void)
+{
+    return s_now + s_pendingTicks;
+}
+
+void SW_TIMER_Process(void)
+{
+    uint32_t primask, ticks;
+
+    primask = DisableGlobalIRQ();
+    ticks = s_pendingTicks;
+    s_pendingTicks = 0;
+    EnableGlobalIRQ(primask);
+
+    while (ticks-- != 0u)
+    {
+        SW_TIMER_RunTick();
+    }
+}
+
+uint32_t SW_TIMER_GetTicksToNextExpiry(void)
+{
+    uint32_t level, shift, index, rotated, distance, due;
+    uint32_t next = SW_TIMER_NO_EXPIRY;
+
+    if (s_pendingTicks != 0u)
+    {
+        return 0u;
+    }
+
+    for (level = 0; level < SW_TIMER_LEVELS; level++)
+    {
+        if (0u == s_occupied[level])
+        {
+            continue;
+        }
+
+        // Distance in slots from the slot after the current one to the first occupied slot.
+        shift = SW_TIMER_LEVEL_SHIFT(level);
+        index = ((s_now >> shift) + 1u) & SW_TIMER_SLOT_MASK;
+        rotated = __ROR(s_occupied[level], index);
+        distance = __CLZ(__RBIT(rotated)) + 1u;
+
+        // Level 0 slots hold the exact expiry, higher levels are due when they get cascaded.
+        due = (((s_now >> shift) + distance) << shift) - s_now;
+        if (due < next)
+        {
+            next = due;
+        }
+    }
+
+    return next;
+}
+
+void SW_TIMER_Idle(void)
+{
+    uint32_t primask, ticks;
+
+    primask = DisableGlobalIRQ();
+    if (0u == s_pendingTicks)
+    {
+        ticks = SW_TIMER_GetTicksToNextExpiry();
+        s_pendingTicks += BOARD_SystickSleep(ticks);
+    }
+    EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_log.h
+ * @brief Tokenized binary trace logging.
+
+    TRACE_LOG() does not format on the target. It stores the address of the format
+    string, a timestamp and the raw 32-bit arguments as one compact record in a RAM
+    ring, which TRACE_LOG_Process() later sends to the debug UART. The format strings
+    stay in the ELF image and tools/trace_decode.py rebuilds the text on the host.
+
+    Record layout, integers are unsigned LEB128 varints:
+        0xA5 | length | format address | timestamp delta in ticks | argument...
+    Only integer, character and pointer arguments are supported, %s must point at a
+    constant string in flash. Format strings should not end with a line break, the
+    decoder prints one record per line.
+
+    Define TRACE_LOG_ENABLE=1 in the project settings to switch TRACE_LOG() from
+    PRINTF() to the binary records.
+*/
+
+#ifndef __TRACE_LOG_H__
+#define __TRACE_LOG_H__
+
+#include <stdint.h>
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Selects binary records (1) or plain PRINTF output (0). */
+#ifndef TRACE_LOG_ENABLE
+#define TRACE_LOG_ENABLE (0U)
+#endif
+
+/*! @brief Size of the record ring in bytes, must be a power of two. */
+#ifndef TRACE_LOG_BUFFER_LEN
+#define TRACE_LOG_BUFFER_LEN (512U)
+#endif
+
+/*! @brief Largest number of arguments of one TRACE_LOG() call. */
+#define TRACE_LOG_MAX_ARGS (6U)
+
+/*! @brief First byte of every record. */
+#define TRACE_LOG_SYNC (0xA5U)
+
+/*! @brief Counts the variadic arguments, 0 to TRACE_LOG_MAX_ARGS. */
+#define TRACE_LOG_NARGS(...)                           TRACE_LOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define TRACE_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, N, ...) N
+
+#if (defined(TRACE_LOG_ENABLE) && (TRACE_LOG_ENABLE > 0U))
+/*! @brief Logs a message, fmt must be a string literal. */
+#define TRACE_LOG(fmt, ...) TRACE_LOG_Emit("" fmt "", TRACE_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define TRACE_LOG(fmt, ...) (void)PRINTF("" fmt "\r\n", ##__VA_ARGS__)
+#endif
+
+/*!
+ * @brief Trace ring statistics.
+ */
+typedef struct
+{
+    uint32_t records;        /*!< Records accepted into the ring. */
+    uint32_t recordsDropped; /*!< Records discarded because the ring was full. */
+    uint32_t bytesSent;      /*!< Bytes handed to the debug UART. */
+    uint32_t highWaterMark;  /*!< Largest ring fill level in bytes. */
+} trace_log_stats_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Function to store one trace record, use TRACE_LOG() instead of calling it directly.
+ *  @details     This function encodes the format address, the time since the previous record and
+ *               the arguments into the ring. It never formats and never waits for the UART.
+ *  @param[in]   fmt   Format string in flash, its address identifies the message.
+ *  @param[in]   nargs Number of 32-bit arguments that follow.
+ *  @return      void.
+ *  @constraints None, callable from thread and interrupt context.
+ *  @reeentrant  Yes
+ */
+void TRACE_LOG_Emit(const char *fmt, uint32_t nargs, ...);
+
+/*! @brief       Function to send the pending records.
+ *  @details     This function writes the ring content to the debug UART, through the DMA ring
+ *               when DEBUG_CONSOLE_TRANSFER_DMA_RING is enabled.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Call periodically from the main loop, never from an interrupt.
+ *  @reeentrant  No
+ */
+void TRACE_LOG_Process(void);
+
+/*! @brief       Function to read the ring statistics.
+ *  @param[out]  pStats Destination of the statistics.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+void TRACE_LOG_GetStats(trace_log_stats_t *pStats);
+
+#endif // __TRACE_LOG_H__
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file gpio_dispatch_bench.c
+ * @brief Host test and benchmark of the GPIO interrupt dispatch core.
+
+    Checks that the set-bit dispatch calls exactly the handlers the 32 pin scan calls,
+    for every single pin and for random flag words, then times both on synthetic flag
+    words. The latency column is the dispatcher's own entry to handler figure, the one
+    the target reports in DWT cycles, here in host timestamp counter ticks.
+
+        cc -O2 -I../frdmmcxa153_pca9420uk-evm/gpio_drivers gpio_dispatch_bench.c \
+           ../frdmmcxa153_pca9420uk-evm/gpio_drivers/gpio_dispatch.c -o gpio_dispatch_bench
+        ./gpio_dispatch_bench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "gpio_dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() ((uint32_t)__rdtsc())
+#else
+#define BENCH_CYCLES() BENCH_Nanoseconds()
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_PORT       (3U)
+#define BENCH_ROUNDS     (2000000U)
+#define BENCH_RANDOM_RUN (100000U)
+
+/* Flag word scenarios, the handled pins are 2, 7, 13 and 30. */
+typedef struct
+{
+    const char *name;
+    uint32_t flags;
+} bench_case_t;
+
+static const bench_case_t s_cases[] = {
+    {"PMIC INT pin 30 only", 1UL << 30},
+    {"low pin 2 only", 1UL << 2},
+    {"two pins 7 and 13", (1UL << 7) | (1UL << 13)},
+    {"all four handled pins", (1UL << 2) | (1UL << 7) | (1UL << 13) | (1UL << 30)},
+    {"pin 30 and unhandled noise", (1UL << 30) | 0x00F0F000UL},
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static volatile uint32_t s_hits[GPIO_DISPATCH_PINS_PER_PORT];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t BENCH_Nanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+}
+
+static uint32_t BENCH_Cycles(void)
+{
+    return BENCH_CYCLES();
+}
+
+static void BENCH_Handler(void *pUserData)
+{
+    s_hits[(uintptr_t)pUserData]++;
+}
+
+static void BENCH_Setup(gpio_dispatch_t *pDispatch, gpio_dispatch_cycles_t getCycles)
+{
+    static const uint32_t pins[] = {2U, 7U, 13U, 30U};
+    uint32_t i;
+
+    GPIO_DispatchInit(pDispatch, getCycles);
+    for (i = 0U; i < sizeof(pins) / sizeof(pins[0]); i++)
+    {
+        (void)GPIO_DispatchRegister(pDispatch, BENCH_PORT, pins[i], BENCH_Handler, (void *)(uintptr_t)pins[i]);
+    }
+}
+
+/* Runs flags through one dispatch function and returns which pins were called. */
+static uint32_t BENCH_Called(uint32_t (*dispatch)(gpio_dispatch_t *, uint32_t, uint32_t, uint32_t),
+                             gpio_dispatch_t *pDispatch, uint32_t flags)
+{
+    uint32_t pin, called = 0U;
+
+    for (pin = 0U; pin < GPIO_DISPATCH_PINS_PER_PORT; pin++)
+    {
+        s_hits[pin] = 0U;
+    }
+    (void)dispatch(pDispatch, BENCH_PORT, flags, 0U);
+    for (pin = 0U; pin < GPIO_DISPATCH_PINS_PER_PORT; pin++)
+    {
+        if (s_hits[pin] > 1U)
+        {
+            return 0xFFFFFFFFUL; /* Called twice, never valid. */
+        }
+        called |= s_hits[pin] << pin;
+    }
+    return called;
+}
+
+static int BENCH_Check(void)
+{
+    gpio_dispatch_t dispatch;
+    uint32_t i, flags, expected;
+
+    BENCH_Setup(&dispatch, NULL);
+    for (i = 0U; i < GPIO_DISPATCH_PINS_PER_PORT + BENCH_RANDOM_RUN; i++)
+    {
+        flags = (i < GPIO_DISPATCH_PINS_PER_PORT) ? (1UL << i) : ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        expected = flags & dispatch.ports[BENCH_PORT].handledMask;
+        if ((BENCH_Called(GPIO_DispatchFlags, &dispatch, flags) != expected) ||
+            (BENCH_Called(GPIO_DispatchFlagsLinear, &dispatch, flags) != expected))
+        {
+            printf("FAIL flags 0x%08X\n", (unsigned)flags);
+            return 1;
+        }
+    }
+    printf("check: set-bit and linear dispatch agree on %u flag words\n",
+           (unsigned)(GPIO_DISPATCH_PINS_PER_PORT + BENCH_RANDOM_RUN));
+    return 0;
+}
+
+/* Average ns per dispatch call and the average entry to first handler latency in counter ticks. */
+static void BENCH_Time(uint32_t (*dispatch)(gpio_dispatch_t *, uint32_t, uint32_t, uint32_t), uint32_t flags,
+                       double *pNs, double *pLatency)
+{
+    gpio_dispatch_t plain, timed;
+    const gpio_dispatch_entry_t *pEntry;
+    uint64_t latencySum = 0U;
+    uint32_t i, start, first;
+
+    BENCH_Setup(&plain, NULL);
+    start = BENCH_Nanoseconds();
+    for (i = 0U; i < BENCH_ROUNDS; i++)
+    {
+        (void)dispatch(&plain, BENCH_PORT, flags, 0U);
+    }
+    *pNs = (double)(uint32_t)(BENCH_Nanoseconds() - start) / BENCH_ROUNDS;
+
+    BENCH_Setup(&timed, BENCH_Cycles);
+    first = (uint32_t)__builtin_ctz(flags & timed.ports[BENCH_PORT].handledMask);
+    pEntry = GPIO_DispatchGetEntry(&timed, BENCH_PORT, first);
+    for (i = 0U; i < BENCH_ROUNDS; i++)
+    {
+        (void)dispatch(&timed, BENCH_PORT, flags, BENCH_Cycles());
+        latencySum += pEntry->lastLatency;
+    }
+    *pLatency = (double)latencySum / BENCH_ROUNDS;
+}
+
+int main(void)
+{
+    double linearNs, linearLatency, bitNs, bitLatency;
+    size_t i;
+
+    if (BENCH_Check() != 0)
+    {
+        return 1;
+    }
+
+    printf("%-28s %22s %22s\n", "", "linear scan (before)", "set bits (after)");
+    printf("%-28s %10s %11s %10s %11s\n", "flags", "ns/call", "latency", "ns/call", "latency");
+    for (i = 0U; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        BENCH_Time(GPIO_DispatchFlagsLinear, s_cases[i].flags, &linearNs, &linearLatency);
+        BENCH_Time(GPIO_DispatchFlags, s_cases[i].flags, &bitNs, &bitLatency);
+        printf("%-28s %10.1f %11.1f %10.1f %11.1f\n", s_cases[i].name, linearNs, linearLatency, bitNs, bitLatency);
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Convert the telemetry stream of the PCA9420UK demo to CSV.
+
+The target sends one COBS encoded frame per sample, enclosed in zero bytes,
+see pmic/pca9420uk_telemetry.h. Console text between frames is skipped, blocks
+that fail the CRC are counted as rejected. Gaps in the sequence numbers are
+reported on stderr.
+
+Delta frames carry only the bytes that changed since the last frame. They are
+applied to the last keyframe and written out as full rows. After a gap the
+deltas are skipped until the next keyframe, as the state they build on is lost.
+Samples equal to the previous one are not sent, so rows only appear on a
+change or a keyframe.
+
+    telemetry_decode.py capture.bin > samples.csv
+    telemetry_decode.py /dev/ttyACM0 --baud 115200 -o samples.csv
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+FRAME_SAMPLE = 0x01
+FRAME_DELTA = 0x02
+TICK_HZ = 1000
+
+FIELD_TOP_INT = 0x01
+FIELD_CHG_STATUS = 0x02
+FIELD_REG_STATUS = 0x04
+FIELD_MODECFG = 0x08
+
+COLUMNS = ["time_s", "seq", "frame", "top_int", "chg_status0", "chg_status1", "chg_status2", "chg_status3",
+           "reg_status", "mode", "modecfg0", "modecfg1", "modecfg2", "modecfg3",
+           "sw1_mv", "sw2_mv", "ldo1_mv", "ldo2_mv", "sw1_en", "sw2_en", "ldo1_en", "ldo2_en"]
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as utilities/crc16.c."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("bad COBS group")
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def sw1_mv(code):
+    code &= 0x3F
+    if code == 0x3F:
+        return 1800
+    return 500 + code * 25 if code <= 0x28 else 1500
+
+
+def ldo1_mv(code):
+    code &= 0x0F
+    return 1700 + code * 25 if code <= 0x08 else 1900
+
+
+def sw2_mv(code):
+    # LDO2 shares the layout.
+    step = code & 0x1F
+    return (1200 if code & 0x20 else 0) + (1500 + step * 25 if step <= 0x18 else 2100)
+
+
+def parse(frame):
+    """Returns (type, sequence, timestamp, fields, payload) of a decoded frame, raises ValueError when it is not valid."""
+    if len(frame) < 9 or crc16(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+        raise ValueError("bad CRC")
+    kind, seq, timestamp, fields = struct.unpack_from("<BBIB", frame, 0)
+    if kind not in (FRAME_SAMPLE, FRAME_DELTA):
+        raise ValueError("unknown frame type 0x%02x" % kind)
+    return kind, seq, timestamp, fields, frame[7:-2]
+
+
+def apply_delta(snapshot, pairs):
+    """The keyframe payload with the (offset, value) pairs of a delta frame applied."""
+    if len(pairs) % 2:
+        raise ValueError("odd delta length")
+    payload = bytearray(snapshot)
+    for offset, value in zip(pairs[0::2], pairs[1::2]):
+        if offset >= len(payload):
+            raise ValueError("delta offset out of range")
+        payload[offset] = value
+    return bytes(payload)
+
+
+def to_row(seq, timestamp, fields, payload):
+    """Returns a row dict of a full payload, raises ValueError when it does not match the field mask."""
+    row = {"time_s": "%.3f" % (timestamp / TICK_HZ), "seq": seq}
+    pos = 0
+    try:
+        if fields & FIELD_TOP_INT:
+            row["top_int"] = "0x%02X" % payload[pos]
+            pos += 1
+        if fields & FIELD_CHG_STATUS:
+            for n in range(4):
+                row["chg_status%d" % n] = "0x%02X" % payload[pos + n]
+            pos += 4
+        if fields & FIELD_REG_STATUS:
+            row["reg_status"] = "0x%02X" % payload[pos]
+            pos += 1
+        if fields & FIELD_MODECFG:
+            row["mode"] = payload[pos]
+            cfg = payload[pos + 1:pos + 5]
+            if len(cfg) != 4:
+                raise IndexError
+            for n in range(4):
+                row["modecfg%d" % n] = "0x%02X" % cfg[n]
+            row["sw1_mv"] = sw1_mv(cfg[0])
+            row["sw2_mv"] = sw2_mv(cfg[1])
+            row["ldo1_mv"] = ldo1_mv(cfg[2] >> 4)
+            row["ldo2_mv"] = sw2_mv(cfg[3])
+            for name, mask in (("sw1_en", 0x08), ("sw2_en", 0x04), ("ldo1_en", 0x02), ("ldo2_en", 0x01)):
+                row[name] = 1 if cfg[2] & mask else 0
+            pos += 5
+    except IndexError:
+        raise ValueError("short payload")
+    if pos != len(payload):
+        raise ValueError("payload length mismatch")
+    return row
+
+
+def decode(stream, writer, follow=False):
+    """Decode a byte stream, returns (frames, bad frames, lost frames)."""
+    frames = bad = lost = 0
+    last_seq = None
+    snapshot = None
+    buf = b""
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue
+            break
+        buf += chunk
+        *blocks, buf = buf.split(b"\0")
+        for block in blocks:
+            # Console text ends up here too, it hardly ever passes the CRC.
+            try:
+                kind, seq, timestamp, fields, payload = parse(cobs_decode(block))
+            except ValueError:
+                if block:
+                    bad += 1
+                continue
+            frames += 1
+            if last_seq is not None and seq != (last_seq + 1) & 0xFF:
+                gap = (seq - last_seq - 1) & 0xFF
+                lost += gap
+                snapshot = None
+                sys.stderr.write("lost %d frame(s) before seq %d at %.3f s\n" % (gap, seq, timestamp / TICK_HZ))
+            last_seq = seq
+            try:
+                if kind == FRAME_DELTA:
+                    if snapshot is None or snapshot[0] != fields:
+                        continue
+                    payload = apply_delta(snapshot[1], payload)
+                row = to_row(seq, timestamp, fields, payload)
+            except ValueError:
+                bad += 1
+                snapshot = None
+                continue
+            snapshot = (fields, payload)
+            row["frame"] = "key" if kind == FRAME_SAMPLE else "delta"
+            writer.writerow(row)
+    return frames, bad, lost
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="capture file or serial port, stdin when omitted")
+    parser.add_argument("--baud", type=int, help="open input as a serial port at this rate (needs pyserial)")
+    parser.add_argument("-o", "--output", help="CSV file, stdout when omitted")
+    options = parser.parse_args()
+
+    if options.baud:
+        import serial
+        stream = serial.Serial(options.input, options.baud, timeout=0.1)
+    elif options.input:
+        stream = open(options.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+    out = open(options.output, "w", newline="") if options.output else sys.stdout
+    writer = csv.DictWriter(out, fieldnames=COLUMNS, restval="")
+    writer.writeheader()
+    try:
+        frames, bad, lost = decode(stream, writer, follow=bool(options.baud))
+    except KeyboardInterrupt:
+        return
+    sys.stderr.write("%d frames, %d rejected, %d lost\n" % (frames, bad, lost))
+
+
+if __name__ == "__main__":
+    main()
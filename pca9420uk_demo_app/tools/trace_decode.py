@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Decode the binary TRACE_LOG() records of the PCA9420UK demo.
+
+The target sends the address of each format string instead of the text, see
+utilities/trace_log.h. This script looks the strings up in the ELF image the
+board was flashed with and prints one line per record. Bytes outside records
+(menus, PRINTF output) are passed through unchanged.
+
+    trace_decode.py firmware.axf capture.bin
+    trace_decode.py firmware.axf /dev/ttyACM0 --baud 115200
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TRACE_LOG_SYNC = 0xA5
+TICK_HZ = 1000
+
+FORMAT_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t)?([diouxXcspn%])")
+
+
+class ElfImage:
+    """Loadable sections of a 32-bit little-endian ELF file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("%s is not a 32-bit little-endian ELF file" % path)
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", data, shoff + i * shentsize)
+            # SHT_PROGBITS with SHF_ALLOC: code, constants and initialized data.
+            if sh_type == 1 and (flags & 0x2) and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, address):
+        for base, blob in self.sections:
+            if base <= address < base + len(blob):
+                end = blob.find(b"\0", address - base)
+                return blob[address - base:end if end >= 0 else None].decode("latin-1")
+        return None
+
+
+def read_varint(buf, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(buf) or shift > 28:
+            raise ValueError("truncated varint")
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def render(elf, fmt, args):
+    """printf() on the host, with the arguments as raw 32-bit words."""
+    out = []
+    pos = 0
+    it = iter(args)
+    for m in FORMAT_SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(next(it, 0))
+        if precision == "*":
+            precision = str(next(it, 0))
+        value = next(it, 0)
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        if conv in "di":
+            out.append((spec + "d") % (value - (1 << 32) if value & 0x80000000 else value))
+        elif conv in "ouxX":
+            out.append((spec + conv.replace("u", "d")) % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "p":
+            out.append("0x%08x" % value)
+        elif conv == "s":
+            text = elf.string(value)
+            out.append((spec + "s") % (text if text is not None else "<0x%08x>" % value))
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(elf, stream, out, follow=False):
+    """Decode a byte stream, returns the unprocessed tail. With follow, empty reads are timeouts."""
+    now = 0
+    buf = b""
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue
+            break
+        buf += chunk
+        i = 0
+        while i < len(buf):
+            if buf[i] != TRACE_LOG_SYNC:
+                out.write(chr(buf[i]))
+                i += 1
+                continue
+            if i + 2 > len(buf) or i + 2 + buf[i + 1] > len(buf):
+                break
+            end = i + 2 + buf[i + 1]
+            try:
+                address, pos = read_varint(buf, i + 2)
+                delta, pos = read_varint(buf, pos)
+                args = []
+                while pos < end:
+                    value, pos = read_varint(buf, pos)
+                    args.append(value)
+                fmt = elf.string(address)
+                if pos != end or fmt is None:
+                    raise ValueError("not a record")
+            except ValueError:
+                # A stray sync byte in plain text.
+                out.write(chr(buf[i]))
+                i += 1
+                continue
+            now += delta
+            out.write("[%10.3f] %s\n" % (now / TICK_HZ, render(elf, fmt, args)))
+            i = end
+        buf = buf[i:]
+        out.flush()
+    return buf
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF image (.axf) of the running firmware")
+    parser.add_argument("input", nargs="?", help="capture file or serial port, stdin when omitted")
+    parser.add_argument("--baud", type=int, help="open input as a serial port at this rate (needs pyserial)")
+    options = parser.parse_args()
+
+    elf = ElfImage(options.elf)
+    if options.baud:
+        import serial
+        stream = serial.Serial(options.input, options.baud, timeout=0.1)
+    elif options.input:
+        stream = open(options.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+    decode(elf, stream, sys.stdout, follow=bool(options.baud))
+
+
+if __name__ == "__main__":
+    main()